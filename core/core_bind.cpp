@@ -596,6 +596,23 @@ Dictionary OS::get_memory_info() const {
 	return ::OS::get_singleton()->get_memory_info();
 }
 
+void OS::start_heap_profiler(int64_t p_sample_interval) {
+	ERR_FAIL_COND_MSG(p_sample_interval <= 0, "Heap profiler sample interval must be greater than 0.");
+	HeapProfiler::start(p_sample_interval);
+}
+
+void OS::stop_heap_profiler() {
+	HeapProfiler::stop();
+}
+
+bool OS::is_heap_profiler_running() const {
+	return HeapProfiler::is_enabled();
+}
+
+Error OS::dump_heap_profile(const String &p_path, bool p_live_bytes) const {
+	return ::OS::get_singleton()->dump_heap_profile(p_path, p_live_bytes);
+}
+
 /** This method uses a signed argument for better error reporting as it's used from the scripting API. */
 void OS::delay_usec(int p_usec) const {
 	ERR_FAIL_COND_MSG(
@@ -796,6 +813,11 @@ void OS::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_static_memory_peak_usage"), &OS::get_static_memory_peak_usage);
 	ClassDB::bind_method(D_METHOD("get_memory_info"), &OS::get_memory_info);
 
+	ClassDB::bind_method(D_METHOD("start_heap_profiler", "sample_interval"), &OS::start_heap_profiler, DEFVAL(HeapProfiler::DEFAULT_SAMPLE_INTERVAL));
+	ClassDB::bind_method(D_METHOD("stop_heap_profiler"), &OS::stop_heap_profiler);
+	ClassDB::bind_method(D_METHOD("is_heap_profiler_running"), &OS::is_heap_profiler_running);
+	ClassDB::bind_method(D_METHOD("dump_heap_profile", "path", "live_bytes"), &OS::dump_heap_profile, DEFVAL(true));
+
 	ClassDB::bind_method(D_METHOD("move_to_trash", "path"), &OS::move_to_trash);
 	ClassDB::bind_method(D_METHOD("get_user_data_dir"), &OS::get_user_data_dir);
 	ClassDB::bind_method(D_METHOD("get_system_dir", "dir", "shared_storage"), &OS::get_system_dir, DEFVAL(true));
@@ -265,6 +265,11 @@ public:
 	uint64_t get_static_memory_peak_usage() const;
 	Dictionary get_memory_info() const;
 
+	void start_heap_profiler(int64_t p_sample_interval = HeapProfiler::DEFAULT_SAMPLE_INTERVAL);
+	void stop_heap_profiler();
+	bool is_heap_profiler_running() const;
+	Error dump_heap_profile(const String &p_path, bool p_live_bytes = true) const;
+
 	void delay_usec(int p_usec) const;
 	void delay_msec(int p_msec) const;
 	uint64_t get_ticks_msec() const;
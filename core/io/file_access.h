@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 
 /**
@@ -157,6 +158,10 @@ private:
 	static Ref<FileAccess> _create_temp(int p_mode_flags, const String &p_prefix = "", const String &p_extension = "", bool p_keep = false);
 
 public:
+	// Mapped backends only provide views of ranges this large, as smaller ones are cheaper
+	// to read through their buffer than to map and move the position past.
+	static constexpr uint64_t BUFFER_VIEW_MIN_SIZE = 64 * 1024;
+
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
 	virtual bool is_open() const = 0; ///< true when file is open
@@ -185,6 +190,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const { return Span<uint8_t>(); } ///< read-only view of the next bytes without copying them, valid until the file is closed; empty (and nothing read) if the backend can't provide one, or only does for ranges large enough to be worth mapping
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const { return false; } ///< start reading a range into the OS cache without waiting for it; false if the backend can't do it asynchronously
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
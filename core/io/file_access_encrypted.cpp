@@ -241,6 +241,19 @@ uint64_t FileAccessEncrypted::get_buffer(uint8_t *p_dst, uint64_t p_length) cons
 	return to_copy;
 }
 
+Span<uint8_t> FileAccessEncrypted::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(writing, Span<uint8_t>(), "File has not been opened in read mode.");
+
+	// The whole file is decrypted on open, so views point into the decrypted data.
+	if (p_length == 0 || pos > get_length() || p_length > get_length() - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(data.ptr() + pos, p_length);
+	pos += p_length;
+	return view;
+}
+
 Error FileAccessEncrypted::get_error() const {
 	return eofed ? ERR_FILE_EOF : OK;
 }
@@ -81,6 +81,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override { return true; } // Decrypted into memory on open.
 
 	virtual Error get_error() const override; ///< get last error
 
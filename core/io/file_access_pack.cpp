@@ -30,12 +30,127 @@
 
 #include "file_access_pack.h"
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
+static uint32_t _get_index_bucket(const uint8_t *p_path_md5, uint32_t p_bucket_bits) {
+	if (p_bucket_bits == 0) {
+		return 0;
+	}
+	const uint32_t head = ((uint32_t)p_path_md5[0] << 24) | ((uint32_t)p_path_md5[1] << 16) | ((uint32_t)p_path_md5[2] << 8) | (uint32_t)p_path_md5[3];
+	return head >> (32 - p_bucket_bits);
+}
+
+static int _compare_index_paths(const char *p_a, uint32_t p_a_length, const char *p_b, uint32_t p_b_length) {
+	const int cmp = memcmp(p_a, p_b, MIN(p_a_length, p_b_length));
+	if (cmp != 0) {
+		return cmp;
+	}
+	return p_a_length < p_b_length ? -1 : (p_a_length > p_b_length ? 1 : 0);
+}
+
+uint32_t PackedData::PackIndex::get_flags(uint32_t p_record) const {
+	return decode_uint32(get_record(p_record) + 48);
+}
+
+const char *PackedData::PackIndex::get_path(uint32_t p_record, uint32_t &r_length) const {
+	const uint8_t *record = get_record(p_record);
+	const uint32_t offset = decode_uint32(record + 52);
+	r_length = decode_uint32(record + 56);
+	if (offset > strings_size || r_length > strings_size - offset) {
+		r_length = 0; // Corrupted pack, don't read out of the string table.
+		return "";
+	}
+	return (const char *)strings + offset;
+}
+
+uint32_t PackedData::PackIndex::get_ordered_record(uint32_t p_position) const {
+	const uint32_t record = decode_uint32(order + (uint64_t)p_position * 4);
+	return record < file_count ? record : 0;
+}
+
+void PackedData::PackIndex::get_file(uint32_t p_record, PackedFile &r_file) const {
+	const uint8_t *record = get_record(p_record);
+	const uint32_t flags = decode_uint32(record + 48);
+	r_file.pack = pack;
+	r_file.offset = file_base + decode_uint64(record + 16);
+	r_file.size = decode_uint64(record + 24);
+	memcpy(r_file.md5, record + 32, 16);
+	r_file.src = src;
+	r_file.encrypted = flags & PACK_FILE_ENCRYPTED;
+	r_file.bundle = bundle;
+	r_file.compressed = flags & PACK_FILE_COMPRESSED;
+	r_file.removed = false;
+	r_file.layer = layer;
+}
+
+bool PackedData::PackIndex::open(const Ref<FileAccess> &p_file, uint32_t p_file_count) {
+	file_count = p_file_count;
+	bucket_bits = p_file->get_32();
+	strings_size = p_file->get_32();
+	ERR_FAIL_COND_V(bucket_bits > PACK_INDEX_MAX_BUCKET_BITS, false);
+
+	const uint64_t buckets_size = ((1ull << bucket_bits) + 1) * 4;
+	const uint64_t size = buckets_size + (uint64_t)file_count * (PACK_INDEX_RECORD_SIZE + 4) + strings_size;
+	ERR_FAIL_COND_V(p_file->get_position() > p_file->get_length() || size > p_file->get_length() - p_file->get_position(), false);
+
+	// Only the parts that are looked up are read when the directory can be mapped.
+	const Span<uint8_t> view = p_file->get_buffer_view(size);
+	const uint8_t *data = view.ptr();
+	if (view.is_empty()) {
+		buffer.resize(size);
+		ERR_FAIL_COND_V(p_file->get_buffer(buffer.ptr(), size) != size, false);
+		data = buffer.ptr();
+	} else {
+		file = p_file;
+	}
+
+	buckets = data;
+	records = buckets + buckets_size;
+	order = records + (uint64_t)file_count * PACK_INDEX_RECORD_SIZE;
+	strings = order + (uint64_t)file_count * 4;
+	return true;
+}
+
+int64_t PackedData::PackIndex::find(const uint8_t *p_path_md5) const {
+	const uint32_t bucket = _get_index_bucket(p_path_md5, bucket_bits);
+	const uint32_t end = MIN(decode_uint32(buckets + ((uint64_t)bucket + 1) * 4), file_count);
+	for (uint32_t i = decode_uint32(buckets + (uint64_t)bucket * 4); i < end; i++) {
+		if (memcmp(get_record(i), p_path_md5, 16) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+uint32_t PackedData::PackIndex::find_first_path(const CharString &p_path) const {
+	uint32_t low = 0;
+	uint32_t high = file_count;
+	while (low < high) {
+		const uint32_t middle = low + (high - low) / 2;
+		uint32_t length;
+		const char *path = get_path(get_ordered_record(middle), length);
+		if (_compare_index_paths(path, length, p_path.get_data(), p_path.length()) < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+//////////////////////////////////////////////////////////////////
+
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	_retire_pack(p_path);
+	layer++;
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
 			return OK;
@@ -45,15 +160,41 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle) {
+void PackedData::_retire_pack(const String &p_path) {
+	{
+		MutexLock lock(views_mutex);
+		PackView *view = views.getptr(p_path);
+		if (view) {
+			retired_views.push_back(*view);
+			views.erase(p_path);
+		}
+	}
+
+	MutexLock lock(dictionaries_mutex);
+	const String prefix = p_path + ":";
+	LocalVector<String> keys;
+	for (const KeyValue<String, ZSTD_DDict *> &E : dictionaries) {
+		if (E.key.begins_with(prefix)) {
+			keys.push_back(E.key);
+		}
+	}
+	for (const String &key : keys) {
+		retired_dictionaries.push_back(dictionaries[key]);
+		dictionaries.erase(key);
+	}
+}
+
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_compressed) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
+	const Vector<uint8_t> md5 = simplified_path.md5_buffer();
+	PathMD5 pmd5(md5);
 
-	bool exists = files.has(pmd5);
+	bool exists = _find_file(md5.ptr()).is_valid();
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -61,6 +202,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.layer = layer;
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
@@ -95,8 +237,9 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 void PackedData::remove_path(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	if (!files.has(pmd5)) {
+	const Vector<uint8_t> md5 = simplified_path.md5_buffer();
+	PathMD5 pmd5(md5);
+	if (!_find_file(md5.ptr()).is_valid()) {
 		return;
 	}
 
@@ -108,16 +251,161 @@ void PackedData::remove_path(const String &p_path) {
 
 		for (int j = 0; j < ds.size(); j++) {
 			if (!cd->subdirs.has(ds[j])) {
-				return; // Subdirectory does not exist, do not bother creating.
+				cd = nullptr; // Subdirectory does not exist (or is not listed yet), do not bother creating.
+				break;
 			} else {
 				cd = cd->subdirs[ds[j]];
 			}
 		}
 	}
 
-	cd->files.erase(simplified_path.get_file());
+	if (cd) {
+		cd->files.erase(simplified_path.get_file());
+	}
 
-	files.erase(pmd5);
+	if (indices.is_empty()) {
+		files.erase(pmd5);
+	} else {
+		// Hide it from the indexed packs too.
+		PackedFile pf;
+		pf.offset = 0;
+		pf.size = 0;
+		memset(pf.md5, 0, sizeof(pf.md5));
+		pf.encrypted = false;
+		pf.bundle = false;
+		pf.removed = true;
+		pf.layer = layer;
+		files[pmd5] = pf;
+	}
+}
+
+void PackedData::add_index(PackIndex *p_index) {
+	p_index->layer = layer;
+	indices.push_back(p_index);
+}
+
+PackedData::FoundFile PackedData::_find_file(const uint8_t *p_path_md5) const {
+	FoundFile found;
+	const PackedFile *pf = files.getptr(PathMD5(p_path_md5));
+	if (indices.is_empty()) {
+		if (pf && !pf->removed) {
+			found.file = pf;
+		}
+		return found;
+	}
+
+	// Replay the packs in mount order, as `add_path()` and `remove_path()` would have.
+	// Files added or removed after an indexed pack was mounted take precedence over it.
+	bool file_applied = pf == nullptr;
+	for (const PackIndex *index : indices) {
+		if (!file_applied && pf->layer < index->layer) {
+			found = FoundFile();
+			found.file = pf->removed ? nullptr : pf;
+			file_applied = true;
+		}
+
+		const int64_t record = index->find(p_path_md5);
+		if (record < 0) {
+			continue;
+		}
+		if (index->get_flags(record) & PACK_FILE_REMOVAL) {
+			found = FoundFile();
+		} else if (!found.is_valid() || index->replace_files) {
+			found = FoundFile();
+			found.index = index;
+			found.record = record;
+		}
+	}
+	if (!file_applied) {
+		found = FoundFile();
+		found.file = pf->removed ? nullptr : pf;
+	}
+	return found;
+}
+
+bool PackedData::_get_file(const String &p_path, PackedFile &r_file) const {
+	const FoundFile found = _find_file(p_path.md5_buffer().ptr());
+	if (found.file) {
+		r_file = *found.file;
+		return true;
+	}
+	if (found.index) {
+		found.index->get_file(found.record, r_file);
+		return true;
+	}
+	return false;
+}
+
+void PackedData::_load_dir(PackedDir *p_dir) const {
+	if (p_dir->indexed_packs.get() == indices.size()) {
+		return;
+	}
+
+	MutexLock lock(dirs_mutex);
+	const uint32_t loaded = p_dir->indexed_packs.get();
+	if (loaded == indices.size()) {
+		return; // Listed by another thread meanwhile.
+	}
+
+	String path;
+	for (const PackedDir *pd = p_dir; pd->parent; pd = pd->parent) {
+		path = pd->name + "/" + path;
+	}
+	const CharString prefix = path.utf8();
+
+	for (uint32_t i = loaded; i < indices.size(); i++) {
+		_load_dir_from_index(p_dir, prefix, indices[i]);
+	}
+	p_dir->indexed_packs.set(indices.size());
+}
+
+void PackedData::_load_dir_from_index(PackedDir *p_dir, const CharString &p_prefix, const PackIndex *p_index) const {
+	const uint32_t prefix_length = p_prefix.length();
+
+	// Paths are sorted, so the directory contents are contiguous.
+	uint32_t i = p_index->find_first_path(p_prefix);
+	while (i < p_index->file_count) {
+		const uint32_t record = p_index->get_ordered_record(i);
+		uint32_t length;
+		const char *path = p_index->get_path(record, length);
+		if (length < prefix_length || memcmp(path, p_prefix.get_data(), prefix_length) != 0) {
+			break;
+		}
+
+		const char *name = path + prefix_length;
+		const uint32_t name_length = length - prefix_length;
+		const char *slash = (const char *)memchr(name, '/', name_length);
+		if (slash) {
+			if (p_index->get_flags(record) & PACK_FILE_REMOVAL) {
+				i++;
+				continue; // Only added files create directories.
+			}
+
+			const String dir_name = String::utf8(name, slash - name);
+			if (!p_dir->subdirs.has(dir_name)) {
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = dir_name;
+				pd->parent = p_dir;
+				p_dir->subdirs[dir_name] = pd;
+			}
+
+			// Skip the rest of the subdirectory, '0' sorts right after '/'.
+			const CharString next = (String::utf8(path, slash - path) + "0").utf8();
+			i = MAX(i + 1, p_index->find_first_path(next));
+			continue;
+		}
+
+		if (name_length > 0) {
+			// Another pack may have replaced or removed it.
+			const String file_name = String::utf8(name, name_length);
+			if (_find_file(p_index->get_record(record)).is_valid()) {
+				p_dir->files.insert(file_name);
+			} else {
+				p_dir->files.erase(file_name);
+			}
+		}
+		i++;
+	}
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -128,13 +416,56 @@ void PackedData::add_pack_source(PackSource *p_source) {
 
 uint8_t *PackedData::get_file_hash(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
-		return nullptr;
+	const FoundFile found = _find_file(simplified_path.md5_buffer().ptr());
+	if (found.file) {
+		return const_cast<uint8_t *>(found.file->md5);
+	}
+	if (found.index) {
+		return const_cast<uint8_t *>(found.index->get_record(found.record) + 32);
 	}
+	return nullptr;
+}
+
+const ZSTD_DDict *PackedData::get_dictionary(const Ref<FileAccess> &p_file, const String &p_pack, uint64_t p_offset, uint32_t p_size) {
+	const String key = p_pack + ":" + itos(p_offset);
+
+	MutexLock lock(dictionaries_mutex);
+
+	ZSTD_DDict **existing = dictionaries.getptr(key);
+	if (existing) {
+		return *existing;
+	}
+
+	LocalVector<uint8_t> data;
+	data.resize(p_size);
+	p_file->seek(p_offset);
+	ERR_FAIL_COND_V_MSG(p_file->get_buffer(data.ptr(), p_size) != p_size, nullptr, vformat("Can't read compression dictionary from pack '%s'.", p_pack));
 
-	return E->value.md5;
+	ZSTD_DDict *ddict = ZSTD_createDDict(data.ptr(), p_size);
+	ERR_FAIL_NULL_V(ddict, nullptr);
+	dictionaries.insert(key, ddict);
+	return ddict;
+}
+
+Span<uint8_t> PackedData::get_pack_view(const String &p_pack) {
+	MutexLock lock(views_mutex);
+
+	const PackView *existing = views.getptr(p_pack);
+	if (existing) {
+		return existing->data;
+	}
+
+	// Mapped once and kept for as long as the packs are, instead of on each file opened from it.
+	PackView view;
+	view.file = FileAccess::open(p_pack, FileAccess::READ);
+	if (view.file.is_valid()) {
+		view.data = view.file->get_buffer_view(view.file->get_length());
+		if (view.data.is_empty()) {
+			view.file.unref();
+		}
+	}
+	views.insert(p_pack, view);
+	return view.data;
 }
 
 HashSet<String> PackedData::get_file_paths() const {
@@ -144,6 +475,8 @@ HashSet<String> PackedData::get_file_paths() const {
 }
 
 void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const {
+	_load_dir(p_dir);
+
 	for (const String &E : p_dir->files) {
 		r_paths.insert(p_parent_dir.path_join(E));
 	}
@@ -155,6 +488,10 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 
 void PackedData::clear() {
 	files.clear();
+	for (PackIndex *index : indices) {
+		memdelete(index);
+	}
+	indices.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -181,7 +518,18 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (PackIndex *index : indices) {
+		memdelete(index);
+	}
 	_free_packed_dirs(root);
+
+	// Not freed on `clear()`, as files opened before may still be using them.
+	for (const KeyValue<String, ZSTD_DDict *> &E : dictionaries) {
+		ZSTD_freeDDict(E.value);
+	}
+	for (ZSTD_DDict *ddict : retired_dictionaries) {
+		ZSTD_freeDDict(ddict);
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -263,21 +611,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled since V3.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and later: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -305,6 +653,22 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+	if (version == PACK_FORMAT_VERSION_V4) {
+		// V4: Keep the directory index, files are looked up in it when opened.
+		PackedData::PackIndex *index = memnew(PackedData::PackIndex);
+		index->pack = p_path;
+		index->src = this;
+		index->file_base = file_base;
+		index->bundle = sparse_bundle;
+		index->replace_files = p_replace_files;
+		if (!index->open(f, file_count)) {
+			memdelete(index);
+			ERR_FAIL_V_MSG(false, vformat("Can't read the directory of pack '%s'.", p_path));
+		}
+		PackedData::get_singleton()->add_index(index);
+		return true;
+	}
+
 	for (int i = 0; i < file_count; i++) {
 		uint32_t sl = f->get_32();
 		CharString cs;
@@ -322,7 +686,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_COMPRESSED));
 		}
 	}
 
@@ -333,6 +697,89 @@ Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::Pack
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+void PackedSourcePCK::store_directory(const Ref<FileAccess> &p_file, const LocalVector<DirectoryEntry> &p_entries) {
+	struct Record {
+		uint8_t path_md5[16];
+		uint32_t entry = 0;
+
+		bool operator<(const Record &p_other) const {
+			const int cmp = memcmp(path_md5, p_other.path_md5, 16);
+			return cmp < 0 || (cmp == 0 && entry < p_other.entry);
+		}
+	};
+
+	struct PathOrder {
+		const DirectoryEntry *entry = nullptr;
+		uint32_t record = 0;
+
+		bool operator<(const PathOrder &p_other) const {
+			return _compare_index_paths(entry->path.get_data(), entry->path.length(), p_other.entry->path.get_data(), p_other.entry->path.length()) < 0;
+		}
+	};
+
+	const uint32_t count = p_entries.size();
+	LocalVector<Record> records;
+	records.resize(count);
+	uint32_t strings_size = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		CryptoCore::md5((const uint8_t *)p_entries[i].path.get_data(), p_entries[i].path.length(), records[i].path_md5);
+		records[i].entry = i;
+		strings_size += p_entries[i].path.length();
+	}
+	records.sort();
+
+	// Around one record per bucket.
+	uint32_t bucket_bits = 0;
+	while (bucket_bits < PACK_INDEX_MAX_BUCKET_BITS && (2ull << bucket_bits) <= count) {
+		bucket_bits++;
+	}
+
+	const uint32_t strings_pad = (4 - strings_size % 4) % 4;
+	p_file->store_32(bucket_bits);
+	p_file->store_32(strings_size + strings_pad);
+
+	uint32_t first = 0;
+	for (uint32_t bucket = 0; bucket < (1u << bucket_bits); bucket++) {
+		while (first < count && _get_index_bucket(records[first].path_md5, bucket_bits) < bucket) {
+			first++;
+		}
+		p_file->store_32(first);
+	}
+	p_file->store_32(count);
+
+	LocalVector<PathOrder> path_order;
+	path_order.resize(count);
+	uint32_t string_offset = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const DirectoryEntry &entry = p_entries[records[i].entry];
+		p_file->store_buffer(records[i].path_md5, 16);
+		p_file->store_64(entry.offset);
+		p_file->store_64(entry.size);
+		p_file->store_buffer(entry.md5, 16);
+		p_file->store_32(entry.flags);
+		p_file->store_32(string_offset);
+		p_file->store_32(entry.path.length());
+		p_file->store_32(0); // Reserved.
+		string_offset += entry.path.length();
+
+		path_order[i].entry = &entry;
+		path_order[i].record = i;
+	}
+
+	path_order.sort();
+	for (const PathOrder &E : path_order) {
+		p_file->store_32(E.record);
+	}
+
+	for (const Record &E : records) {
+		const CharString &path = p_entries[E.entry].path;
+		p_file->store_buffer((const uint8_t *)path.get_data(), path.length());
+	}
+	for (uint32_t i = 0; i < strings_pad; i++) {
+		p_file->store_8(0);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 bool PackedSourceDirectory::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
@@ -395,7 +842,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -434,11 +883,174 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.compressed) {
+		_get_compressed_buffer(p_dst, pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+bool FileAccessPack::_decompress_chunk(ZSTD_DCtx *p_dctx, uint8_t *p_dst, const uint8_t *p_src, uint32_t p_index) const {
+	const uint64_t size = _get_chunk_size(p_index);
+	const size_t ret = ZSTD_decompress_usingDDict(p_dctx, p_dst, size, p_src, chunk_offsets[p_index + 1] - chunk_offsets[p_index], dictionary);
+	return !ZSTD_isError(ret) && ret == size;
+}
+
+// Decompression context of each pool thread, created on its first chunk and kept until the thread exits.
+struct PackThreadDCtx {
+	ZSTD_DCtx *dctx = nullptr;
+
+	~PackThreadDCtx() {
+		if (dctx) {
+			ZSTD_freeDCtx(dctx);
+		}
+	}
+};
+
+static thread_local PackThreadDCtx pack_thread_dctx;
+
+void FileAccessPack::_decompress_chunk_task(void *p_userdata, uint32_t p_index) {
+	DecompressChunks *job = (DecompressChunks *)p_userdata;
+	const FileAccessPack *file = job->file;
+	const uint32_t index = job->first + p_index;
+
+	if (!pack_thread_dctx.dctx) {
+		pack_thread_dctx.dctx = ZSTD_createDCtx();
+	}
+	const uint8_t *src = job->src + (file->chunk_offsets[index] - file->chunk_offsets[job->first]);
+	uint8_t *dst = job->dst + (uint64_t)p_index * file->chunk_size;
+	if (!pack_thread_dctx.dctx || !file->_decompress_chunk(pack_thread_dctx.dctx, dst, src, index)) {
+		job->failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_chunks(uint8_t *p_dst, uint32_t p_first, uint32_t p_count) const {
+	// Read all the compressed data at once.
+	const uint64_t start = chunk_offsets[p_first];
+	const uint64_t size = chunk_offsets[p_first + p_count] - start;
+	compressed.resize(size);
+	f->seek(start);
+	ERR_FAIL_COND_V_MSG(f->get_buffer(compressed.ptr(), size) != size, false, vformat("Can't read compressed data of pack-referenced file from '%s'.", String(pf.pack)));
+
+	// Waiting for a group blocks the thread without running other tasks, which from a pool thread
+	// could leave the group with no thread to run it. Those decompress on their own instead.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_count > 1 && pool && pool->get_thread_index() == -1) {
+		DecompressChunks job;
+		job.file = this;
+		job.src = compressed.ptr();
+		job.dst = p_dst;
+		job.first = p_first;
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(&FileAccessPack::_decompress_chunk_task, &job, p_count, -1, true, SNAME("FileAccessPack::decompress"));
+		pool->wait_for_group_task_completion(group);
+		ERR_FAIL_COND_V_MSG(job.failed.is_set(), false, vformat("Can't decompress pack-referenced file from '%s'.", String(pf.pack)));
+		return true;
+	}
+
+	const uint8_t *src = compressed.ptr();
+	for (uint32_t i = p_first; i < p_first + p_count; i++) {
+		ERR_FAIL_COND_V_MSG(!_decompress_chunk(dctx, p_dst, src, i), false, vformat("Can't decompress pack-referenced file from '%s'.", String(pf.pack)));
+		src += chunk_offsets[i + 1] - chunk_offsets[i];
+		p_dst += chunk_size;
+	}
+	return true;
+}
+
+void FileAccessPack::_get_compressed_buffer(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const {
+	const uint32_t chunk_count = chunk_offsets.size() - 1;
+
+	while (p_length > 0) {
+		const uint32_t index = p_from / chunk_size;
+		const uint64_t offset = p_from % chunk_size;
+
+		// Chunks read whole are decompressed straight into the destination, in parallel if there are several.
+		uint32_t whole = 0;
+		uint64_t whole_size = 0;
+		if (offset == 0 && (int64_t)index != chunk_index) {
+			while (index + whole < chunk_count && whole_size + _get_chunk_size(index + whole) <= p_length) {
+				whole_size += _get_chunk_size(index + whole);
+				whole++;
+			}
+		}
+
+		uint64_t read = 0;
+		if (whole > 0) {
+			if (!_decompress_chunks(p_dst, index, whole)) {
+				break;
+			}
+			read = whole_size;
+		} else {
+			if ((int64_t)index != chunk_index) {
+				chunk.resize(_get_chunk_size(index));
+				if (!_decompress_chunks(chunk.ptr(), index, 1)) {
+					chunk_index = -1;
+					break;
+				}
+				chunk_index = index;
+			}
+			read = MIN(p_length, chunk.size() - offset);
+			memcpy(p_dst, chunk.ptr() + offset, read);
+		}
+
+		p_dst += read;
+		p_from += read;
+		p_length -= read;
+	}
+
+	if (p_length > 0) {
+		memset(p_dst, 0, p_length);
+	}
+}
+
+Span<uint8_t> FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), Span<uint8_t>(), "File must be opened before use.");
+
+	if (pf.compressed || eof || p_length == 0 || pos > pf.size || p_length > pf.size - pos) {
+		return Span<uint8_t>();
+	}
+
+	if (pf.bundle) {
+		// The file is on its own, and shares its position with this one, see `seek()`.
+		Span<uint8_t> view = f->get_buffer_view(p_length);
+		if (view.size() == p_length) {
+			pos += p_length;
+		}
+		return view;
+	}
+
+	if (pf.encrypted || p_length < BUFFER_VIEW_MIN_SIZE) {
+		return Span<uint8_t>();
+	}
+	if (!pack_view_requested) {
+		pack_view = PackedData::get_singleton()->get_pack_view(pf.pack);
+		pack_view_requested = true;
+	}
+	if (off + pos > pack_view.size() || p_length > pack_view.size() - (off + pos)) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(pack_view.ptr() + off + pos, p_length);
+	pos += p_length;
+	f->seek(off + pos);
+	return view;
+}
+
+bool FileAccessPack::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), false, "File must be opened before use.");
+
+	if (p_offset >= pf.size || p_length == 0) {
+		return true;
+	}
+	if (pf.compressed) {
+		const uint32_t first = p_offset / chunk_size;
+		const uint32_t last = (p_offset + MIN(p_length, pf.size - p_offset) - 1) / chunk_size;
+		return f->prefetch(chunk_offsets[first], chunk_offsets[last + 1] - chunk_offsets[first]);
+	}
+	return f->prefetch(off + p_offset, MIN(p_length, pf.size - p_offset));
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -501,6 +1113,49 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	}
 	pos = 0;
 	eof = false;
+
+	if (pf.compressed && _open_compressed() != OK) {
+		f.unref();
+	}
+}
+
+Error FileAccessPack::_open_compressed() {
+	ERR_FAIL_COND_V_MSG(pf.encrypted, ERR_FILE_CORRUPT, vformat("Pack-referenced file can't be both compressed and encrypted in '%s'.", String(pf.pack)));
+
+	f->seek(off);
+	chunk_size = f->get_32();
+	const uint32_t chunk_count = f->get_32();
+	const uint64_t dictionary_distance = f->get_64();
+	const uint32_t dictionary_size = f->get_32();
+	f->get_32(); // Reserved.
+	ERR_FAIL_COND_V_MSG(chunk_size == 0 || chunk_count != (pf.size + chunk_size - 1) / chunk_size, ERR_FILE_CORRUPT, vformat("Invalid chunk table of compressed pack-referenced file in '%s'.", String(pf.pack)));
+
+	// Chunk reads trust these offsets, so they must follow each other and stay within the pack.
+	const uint64_t pack_size = f->get_length();
+	const uint64_t data_start = off + PACK_COMPRESSED_HEADER_SIZE + ((uint64_t)chunk_count + 1) * sizeof(uint64_t);
+	ERR_FAIL_COND_V_MSG(data_start > pack_size, ERR_FILE_CORRUPT, vformat("Invalid chunk table of compressed pack-referenced file in '%s'.", String(pf.pack)));
+	chunk_offsets.resize(chunk_count + 1);
+	for (uint32_t i = 0; i <= chunk_count; i++) {
+		const uint64_t offset = f->get_64();
+		ERR_FAIL_COND_V_MSG(offset > pack_size - data_start || (i > 0 && data_start + offset <= chunk_offsets[i - 1]), ERR_FILE_CORRUPT, vformat("Invalid chunk table of compressed pack-referenced file in '%s'.", String(pf.pack)));
+		chunk_offsets[i] = data_start + offset;
+	}
+
+	if (dictionary_size > 0) {
+		ERR_FAIL_COND_V(dictionary_distance > off, ERR_FILE_CORRUPT);
+		dictionary = PackedData::get_singleton()->get_dictionary(f, pf.pack, off - dictionary_distance, dictionary_size);
+		ERR_FAIL_NULL_V(dictionary, ERR_FILE_CORRUPT);
+	}
+
+	dctx = ZSTD_createDCtx();
+	ERR_FAIL_NULL_V(dctx, ERR_OUT_OF_MEMORY);
+	return OK;
+}
+
+FileAccessPack::~FileAccessPack() {
+	if (dctx) {
+		ZSTD_freeDCtx(dctx);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -511,6 +1166,8 @@ Error DirAccessPack::list_dir_begin() {
 	list_dirs.clear();
 	list_files.clear();
 
+	PackedData::get_singleton()->_load_dir(current);
+
 	for (const KeyValue<String, PackedData::PackedDir *> &E : current->subdirs) {
 		list_dirs.push_back(E.key);
 	}
@@ -602,11 +1259,13 @@ PackedData::PackedDir *DirAccessPack::_find_dir(const String &p_dir) {
 			if (pd->parent) {
 				pd = pd->parent;
 			}
-		} else if (pd->subdirs.has(p)) {
-			pd = pd->subdirs[p];
-
 		} else {
-			return nullptr;
+			PackedData::get_singleton()->_load_dir(pd);
+			if (pd->subdirs.has(p)) {
+				pd = pd->subdirs[p];
+			} else {
+				return nullptr;
+			}
 		}
 	}
 
@@ -640,6 +1299,7 @@ bool DirAccessPack::file_exists(String p_file) {
 	if (!pd) {
 		return false;
 	}
+	PackedData::get_singleton()->_load_dir(pd);
 	return pd->files.has(p_file.get_file());
 }
 
@@ -32,18 +32,24 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+typedef struct ZSTD_DDict_s ZSTD_DDict;
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION_V4 4
 
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -54,8 +60,28 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2,
 };
 
+// A compressed file is split in chunks of the same uncompressed size (the last one may be shorter),
+// each compressed as an independent zstd frame so that seeking only decompresses one chunk.
+// The file data starts with:
+// - uint32 uncompressed chunk size, uint32 chunk count,
+// - uint64 distance back from the start of the file data to a dictionary shared by similar files, uint32 dictionary size (zero for none), uint32 reserved,
+// - uint64 offset of each chunk from the end of this table, plus one for the end of the last chunk.
+#define PACK_COMPRESSED_HEADER_SIZE 24
+
+// Since V4, the directory is an index that is looked up in place instead of being read entry by entry.
+// After the file count (encrypted along with the rest if the directory is):
+// - uint32 bucket bits, uint32 string table size,
+// - uint32 first record of each of the (1 << bucket bits) buckets, plus one for the record count,
+// - the records, sorted by the MD5 of their path, whose first bits select the bucket:
+//   path MD5[16], uint64 offset, uint64 size, file MD5[16], uint32 flags, uint32 path offset in the string table, uint32 path length, uint32 reserved,
+// - uint32 record index of each file, sorted by path, to list directories,
+// - the string table, with the UTF-8 paths (without "res://").
+#define PACK_INDEX_RECORD_SIZE 64
+#define PACK_INDEX_MAX_BUCKET_BITS 24
+
 class PackSource;
 
 class PackedData {
@@ -72,6 +98,40 @@ public:
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
+		bool compressed = false;
+		bool removed = false; // Hides the file from indexed packs mounted before.
+		uint32_t layer = 0; // Mount order of the pack, see `PackIndex`.
+	};
+
+	// The directory of a pack that is looked up in place rather than added file by file, see PACK_FORMAT_VERSION_V4.
+	// Files are resolved by replaying, in mount order, the indexed packs and the files added or removed by the others.
+	struct PackIndex {
+		String pack;
+		PackSource *src = nullptr;
+		uint64_t file_base = 0;
+		bool bundle = false;
+		bool replace_files = false;
+		uint32_t layer = 0;
+
+		Ref<FileAccess> file; // Keeps the view of the directory valid.
+		LocalVector<uint8_t> buffer; // Copy of the directory, when it can't be viewed in place.
+		uint32_t file_count = 0;
+		uint32_t bucket_bits = 0;
+		const uint8_t *buckets = nullptr;
+		const uint8_t *records = nullptr;
+		const uint8_t *order = nullptr;
+		const uint8_t *strings = nullptr;
+		uint32_t strings_size = 0;
+
+		_FORCE_INLINE_ const uint8_t *get_record(uint32_t p_record) const { return records + (uint64_t)p_record * PACK_INDEX_RECORD_SIZE; }
+		uint32_t get_flags(uint32_t p_record) const;
+		const char *get_path(uint32_t p_record, uint32_t &r_length) const;
+		uint32_t get_ordered_record(uint32_t p_position) const; // Record at a position in path order.
+		void get_file(uint32_t p_record, PackedFile &r_file) const;
+
+		bool open(const Ref<FileAccess> &p_file, uint32_t p_file_count);
+		int64_t find(const uint8_t *p_path_md5) const;
+		uint32_t find_first_path(const CharString &p_path) const; // In path order.
 	};
 
 private:
@@ -80,6 +140,7 @@ private:
 		String name;
 		HashMap<String, PackedDir *> subdirs;
 		HashSet<String> files;
+		SafeNumeric<uint32_t> indexed_packs; // Indexed packs whose files were added, only done once the directory is browsed.
 	};
 
 	struct PathMD5 {
@@ -100,9 +161,24 @@ private:
 			a = *((uint64_t *)&p_buf[0]);
 			b = *((uint64_t *)&p_buf[8]);
 		}
+
+		explicit PathMD5(const uint8_t *p_md5) {
+			memcpy(&a, p_md5, sizeof(a));
+			memcpy(&b, p_md5 + sizeof(a), sizeof(b));
+		}
+	};
+
+	struct FoundFile {
+		const PackedFile *file = nullptr;
+		const PackIndex *index = nullptr;
+		uint32_t record = 0;
+
+		_FORCE_INLINE_ bool is_valid() const { return file || index; }
 	};
 
 	HashMap<PathMD5, PackedFile, PathMD5> files;
+	LocalVector<PackIndex *> indices;
+	uint32_t layer = 0;
 
 	Vector<PackSource *> sources;
 
@@ -111,13 +187,39 @@ private:
 	static inline PackedData *singleton = nullptr;
 	bool disabled = false;
 
+	Mutex dictionaries_mutex;
+	HashMap<String, ZSTD_DDict *> dictionaries; // By pack and offset.
+
+	struct PackView {
+		Ref<FileAccess> file; // Keeps the view valid.
+		Span<uint8_t> data; // Whole pack, empty if it can't be mapped.
+	};
+	Mutex views_mutex;
+	HashMap<String, PackView> views; // By pack, kept on `clear()` like the dictionaries.
+
+	// Views and dictionaries of a pack mounted again, which may have been rewritten since.
+	// Files opened before may still be using them, so they are only freed along with the others.
+	LocalVector<PackView> retired_views;
+	LocalVector<ZSTD_DDict *> retired_dictionaries;
+
+	void _retire_pack(const String &p_path);
+
+	Mutex dirs_mutex;
+
+	FoundFile _find_file(const uint8_t *p_path_md5) const;
+	bool _get_file(const String &p_path, PackedFile &r_file) const;
+	void _load_dir(PackedDir *p_dir) const;
+	void _load_dir_from_index(PackedDir *p_dir, const CharString &p_prefix, const PackIndex *p_index) const;
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_compressed = false); // for PackSource
 	void remove_path(const String &p_path);
+	void add_index(PackIndex *p_index); // Takes ownership.
+	const ZSTD_DDict *get_dictionary(const Ref<FileAccess> &p_file, const String &p_pack, uint64_t p_offset, uint32_t p_size);
+	Span<uint8_t> get_pack_view(const String &p_pack);
 	uint8_t *get_file_hash(const String &p_path);
 	HashSet<String> get_file_paths() const;
 
@@ -150,6 +252,17 @@ public:
 
 class PackedSourcePCK : public PackSource {
 public:
+	struct DirectoryEntry {
+		CharString path; // Simplified, without "res://".
+		uint64_t offset = 0; // From the files base.
+		uint64_t size = 0;
+		uint8_t md5[16] = {};
+		uint32_t flags = 0;
+	};
+
+	// Stores the directory of a pack in the current format, after its file count.
+	static void store_directory(const Ref<FileAccess> &p_file, const LocalVector<DirectoryEntry> &p_entries);
+
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
 };
@@ -171,6 +284,34 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// Only used by compressed files, see PACK_FILE_COMPRESSED.
+	uint32_t chunk_size = 0;
+	LocalVector<uint64_t> chunk_offsets; // In the pack file, followed by the end of the last chunk.
+	const ZSTD_DDict *dictionary = nullptr;
+	mutable ZSTD_DCtx *dctx = nullptr;
+	mutable LocalVector<uint8_t> chunk; // Last chunk read partially.
+	mutable int64_t chunk_index = -1;
+	mutable LocalVector<uint8_t> compressed;
+
+	mutable Span<uint8_t> pack_view; // Whole pack, shared by the files opened from it, see `PackedData::get_pack_view()`.
+	mutable bool pack_view_requested = false;
+
+	struct DecompressChunks {
+		const FileAccessPack *file = nullptr;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		uint32_t first = 0;
+		SafeFlag failed;
+	};
+
+	_FORCE_INLINE_ uint64_t _get_chunk_size(uint32_t p_index) const { return MIN((uint64_t)chunk_size, pf.size - (uint64_t)p_index * chunk_size); }
+	Error _open_compressed();
+	bool _decompress_chunk(ZSTD_DCtx *p_dctx, uint8_t *p_dst, const uint8_t *p_src, uint32_t p_index) const;
+	static void _decompress_chunk_task(void *p_userdata, uint32_t p_index);
+	bool _decompress_chunks(uint8_t *p_dst, uint32_t p_first, uint32_t p_count) const;
+	void _get_compressed_buffer(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -194,6 +335,8 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -208,34 +351,32 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	~FileAccessPack();
 };
 
 int64_t PackedData::get_size(const String &p_path) {
 	String simplified_path = p_path.simplify_path();
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile pf;
+	if (!_get_file(simplified_path, pf)) {
 		return -1; // File not found.
 	}
-	if (E->value.offset == 0) {
+	if (pf.offset == 0) {
 		return -1; // File was erased.
 	}
-	return E->value.size;
+	return pf.size;
 }
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
-	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile pf;
+	if (!_get_file(p_path.simplify_path().trim_prefix("res://"), pf)) {
 		return nullptr; // Not found.
 	}
 
-	return E->value.src->get_file(p_path, &E->value);
+	return pf.src->get_file(p_path, &pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
-	return files.has(PathMD5(p_path.simplify_path().trim_prefix("res://").md5_buffer()));
+	return _find_file(p_path.simplify_path().trim_prefix("res://").md5_buffer().ptr()).is_valid();
 }
 
 bool PackedData::has_directory(const String &p_path) {
@@ -34,8 +34,17 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
+// Types with fewer files than this are compressed without a dictionary.
+static constexpr int DICTIONARY_MIN_FILES = 8;
+static constexpr int DICTIONARY_SAMPLE_SIZE = 4096;
+static constexpr int DICTIONARY_MAX_SIZE = 112 * 1024;
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -51,6 +60,42 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_use_compression", "enable"), &PCKPacker::set_use_compression);
+	ClassDB::bind_method(D_METHOD("is_using_compression"), &PCKPacker::is_using_compression);
+	ClassDB::bind_method(D_METHOD("set_compression_chunk_size", "size"), &PCKPacker::set_compression_chunk_size);
+	ClassDB::bind_method(D_METHOD("get_compression_chunk_size"), &PCKPacker::get_compression_chunk_size);
+	ClassDB::bind_method(D_METHOD("set_use_compression_dictionaries", "enable"), &PCKPacker::set_use_compression_dictionaries);
+	ClassDB::bind_method(D_METHOD("is_using_compression_dictionaries"), &PCKPacker::is_using_compression_dictionaries);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_compression"), "set_use_compression", "is_using_compression");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_chunk_size", PROPERTY_HINT_RANGE, "4096,16777216,1,or_greater,suffix:B"), "set_compression_chunk_size", "get_compression_chunk_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_compression_dictionaries"), "set_use_compression_dictionaries", "is_using_compression_dictionaries");
+}
+
+void PCKPacker::set_use_compression(bool p_enable) {
+	use_compression = p_enable;
+}
+
+bool PCKPacker::is_using_compression() const {
+	return use_compression;
+}
+
+void PCKPacker::set_compression_chunk_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 4096, "Compression chunk size must be at least 4096 bytes.");
+	compression_chunk_size = p_size;
+}
+
+int PCKPacker::get_compression_chunk_size() const {
+	return compression_chunk_size;
+}
+
+void PCKPacker::set_use_compression_dictionaries(bool p_enable) {
+	use_compression_dictionaries = p_enable;
+}
+
+bool PCKPacker::is_using_compression_dictionaries() const {
+	return use_compression_dictionaries;
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -161,6 +206,12 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	pf.ofs = file->get_position();
 	pf.size = f->get_length();
 
+	if (use_compression && !p_encrypt) {
+		pf.compressed = true;
+		files.push_back(pf);
+		return OK;
+	}
+
 	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path);
 	{
 		unsigned char hash[16];
@@ -201,9 +252,168 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	return OK;
 }
 
+void PCKPacker::_pad() {
+	int pad = _get_pad(alignment, file->get_position());
+	for (int i = 0; i < pad; i++) {
+		file->store_8(0);
+	}
+}
+
+Vector<uint8_t> PCKPacker::_build_dictionary(const LocalVector<int> &p_files) const {
+	// zstd can use any content as a dictionary, matching data against it as if it had been seen before.
+	// What files of the same type share the most is usually at their start (headers, common declarations).
+	Vector<uint8_t> dictionary;
+	for (int index : p_files) {
+		Ref<FileAccess> f = FileAccess::open(files[index].src_path, FileAccess::READ);
+		if (f.is_null()) {
+			continue;
+		}
+		dictionary.append_array(f->get_buffer(MIN(DICTIONARY_SAMPLE_SIZE, DICTIONARY_MAX_SIZE - dictionary.size())));
+		if (dictionary.size() >= DICTIONARY_MAX_SIZE) {
+			break;
+		}
+	}
+
+	// Content starting like a trained dictionary would be parsed as one.
+	if (dictionary.size() >= 4 && decode_uint32(dictionary.ptr()) == ZSTD_MAGIC_DICTIONARY) {
+		dictionary.insert(0, 0);
+	}
+	return dictionary;
+}
+
+void PCKPacker::_compress_chunk_task(void *p_userdata, uint32_t p_index) {
+	CompressChunks *job = (CompressChunks *)p_userdata;
+	const uint64_t start = (uint64_t)p_index * job->chunk_size;
+	const uint64_t size = MIN((uint64_t)job->chunk_size, job->size - start);
+
+	Vector<uint8_t> &chunk = job->chunks[p_index];
+	chunk.resize(ZSTD_compressBound(size));
+
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	size_t ret;
+	if (job->dictionary) {
+		ret = ZSTD_compress_usingCDict(cctx, chunk.ptrw(), chunk.size(), job->src + start, size, job->dictionary);
+	} else {
+		ret = ZSTD_compressCCtx(cctx, chunk.ptrw(), chunk.size(), job->src + start, size, Compression::zstd_level);
+	}
+	ZSTD_freeCCtx(cctx);
+
+	if (ZSTD_isError(ret)) {
+		job->failed.set();
+		return;
+	}
+	chunk.resize(ret);
+}
+
+Error PCKPacker::_write_compressed(File &p_file, const ZSTD_CDict *p_dictionary, uint64_t p_dictionary_ofs, uint32_t p_dictionary_size) {
+	const Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_file.src_path);
+	{
+		unsigned char hash[16];
+		CryptoCore::md5(data.ptr(), data.size(), hash);
+		p_file.md5.resize(16);
+		for (int i = 0; i < 16; i++) {
+			p_file.md5.write[i] = hash[i];
+		}
+	}
+	p_file.ofs = file->get_position();
+	p_file.size = data.size();
+
+	CompressChunks job;
+	job.src = data.ptr();
+	job.size = data.size();
+	job.chunk_size = compression_chunk_size;
+	job.dictionary = p_dictionary;
+	const uint32_t chunk_count = (job.size + job.chunk_size - 1) / job.chunk_size;
+	job.chunks.resize(chunk_count);
+
+	if (chunk_count > 1 && WorkerThreadPool::get_singleton()) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&PCKPacker::_compress_chunk_task, &job, chunk_count, -1, true, SNAME("PCKPacker::compress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_compress_chunk_task(&job, i);
+		}
+	}
+	ERR_FAIL_COND_V_MSG(job.failed.is_set(), ERR_CANT_CREATE, vformat("Can't compress file: '%s'.", p_file.src_path));
+
+	uint64_t compressed_size = PACK_COMPRESSED_HEADER_SIZE + (chunk_count + 1) * sizeof(uint64_t);
+	for (const Vector<uint8_t> &chunk : job.chunks) {
+		compressed_size += chunk.size();
+	}
+
+	if (compressed_size >= job.size - job.size / 16) {
+		// Not worth decompressing (e.g. already compressed textures or audio), store it as is.
+		p_file.compressed = false;
+		file->store_buffer(data);
+	} else {
+		file->store_32(job.chunk_size);
+		file->store_32(chunk_count);
+		file->store_64(p_dictionary ? p_file.ofs - p_dictionary_ofs : 0);
+		file->store_32(p_dictionary ? p_dictionary_size : 0);
+		file->store_32(0); // Reserved.
+
+		uint64_t chunk_ofs = 0;
+		for (const Vector<uint8_t> &chunk : job.chunks) {
+			file->store_64(chunk_ofs);
+			chunk_ofs += chunk.size();
+		}
+		file->store_64(chunk_ofs);
+
+		for (const Vector<uint8_t> &chunk : job.chunks) {
+			file->store_buffer(chunk);
+		}
+	}
+
+	_pad();
+	return OK;
+}
+
+Error PCKPacker::_write_compressed_files() {
+	// Files of the same type share a dictionary.
+	HashMap<String, LocalVector<int>> groups;
+	for (int i = 0; i < files.size(); i++) {
+		if (files[i].compressed) {
+			groups[files[i].path.get_extension().to_lower()].push_back(i);
+		}
+	}
+
+	for (const KeyValue<String, LocalVector<int>> &E : groups) {
+		Vector<uint8_t> dictionary;
+		if (use_compression_dictionaries && E.value.size() >= DICTIONARY_MIN_FILES) {
+			dictionary = _build_dictionary(E.value);
+		}
+
+		ZSTD_CDict *cdict = nullptr;
+		const uint64_t dictionary_ofs = file->get_position();
+		if (!dictionary.is_empty()) {
+			cdict = ZSTD_createCDict(dictionary.ptr(), dictionary.size(), Compression::zstd_level);
+			ERR_FAIL_NULL_V(cdict, ERR_OUT_OF_MEMORY);
+			file->store_buffer(dictionary);
+			_pad();
+		}
+
+		for (int index : E.value) {
+			Error err = _write_compressed(files.write[index], cdict, dictionary_ofs, dictionary.size());
+			if (err != OK) {
+				ZSTD_freeCDict(cdict);
+				return err;
+			}
+		}
+		ZSTD_freeCDict(cdict);
+	}
+
+	return OK;
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	Error compress_err = _write_compressed_files();
+	if (compress_err != OK) {
+		file.unref();
+		return compress_err;
+	}
+
 	int dir_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < dir_padding; i++) {
 		file->store_8(0);
@@ -231,34 +441,30 @@ Error PCKPacker::flush(bool p_verbose) {
 	}
 
 	const int file_num = files.size();
+	LocalVector<PackedSourcePCK::DirectoryEntry> entries;
+	entries.resize(file_num);
 	for (int i = 0; i < file_num; i++) {
-		CharString utf8_string = files[i].path.utf8();
-		int string_len = utf8_string.length();
-		int pad = _get_pad(4, string_len);
-
-		fhead->store_32(uint32_t(string_len + pad));
-		fhead->store_buffer((const uint8_t *)utf8_string.get_data(), string_len);
-		for (int j = 0; j < pad; j++) {
-			fhead->store_8(0);
-		}
+		PackedSourcePCK::DirectoryEntry &entry = entries[i];
+		entry.path = files[i].path.utf8();
+		entry.offset = files[i].ofs - file_base;
+		entry.size = files[i].size;
+		memcpy(entry.md5, files[i].md5.ptr(), 16);
 
-		fhead->store_64(files[i].ofs - file_base);
-		fhead->store_64(files[i].size);
-		fhead->store_buffer(files[i].md5.ptr(), 16);
-
-		uint32_t flags = 0;
 		if (files[i].encrypted) {
-			flags |= PACK_FILE_ENCRYPTED;
+			entry.flags |= PACK_FILE_ENCRYPTED;
 		}
 		if (files[i].removal) {
-			flags |= PACK_FILE_REMOVAL;
+			entry.flags |= PACK_FILE_REMOVAL;
+		}
+		if (files[i].compressed) {
+			entry.flags |= PACK_FILE_COMPRESSED;
 		}
-		fhead->store_32(flags);
 
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, file_num, float(i) / file_num * 100, files[i].src_path, files[i].path));
 		}
 	}
+	PackedSourcePCK::store_directory(fhead, entries);
 
 	if (fae.is_valid()) {
 		fhead.unref();
@@ -31,9 +31,12 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class FileAccess;
 
+typedef struct ZSTD_CDict_s ZSTD_CDict;
+
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
@@ -47,6 +50,10 @@ class PCKPacker : public RefCounted {
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
+	bool use_compression = false;
+	int compression_chunk_size = 65536;
+	bool use_compression_dictionaries = true;
+
 	static void _bind_methods();
 
 	struct File {
@@ -56,16 +63,41 @@ class PCKPacker : public RefCounted {
 		uint64_t size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false; // Written on flush, after the dictionaries.
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	struct CompressChunks {
+		const uint8_t *src = nullptr;
+		uint64_t size = 0;
+		uint32_t chunk_size = 0;
+		const ZSTD_CDict *dictionary = nullptr;
+		LocalVector<Vector<uint8_t>> chunks;
+		SafeFlag failed;
+	};
+
+	static void _compress_chunk_task(void *p_userdata, uint32_t p_index);
+	void _pad();
+	Vector<uint8_t> _build_dictionary(const LocalVector<int> &p_files) const;
+	Error _write_compressed(File &p_file, const ZSTD_CDict *p_dictionary, uint64_t p_dictionary_ofs, uint32_t p_dictionary_size);
+	Error _write_compressed_files();
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_use_compression(bool p_enable);
+	bool is_using_compression() const;
+
+	void set_compression_chunk_size(int p_size);
+	int get_compression_chunk_size() const;
+
+	void set_use_compression_dictionaries(bool p_enable);
+	bool is_using_compression_dictionaries() const;
+
 	PCKPacker() {}
 	~PCKPacker();
 };
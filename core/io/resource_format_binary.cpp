@@ -683,6 +683,7 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	Vector<String> to_prefetch;
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -696,6 +697,16 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		if (cache_mode_for_external == ResourceFormatLoader::CACHE_MODE_IGNORE || !ResourceCache::has(path)) {
+			to_prefetch.push_back(path);
+		}
+	}
+
+	// Have the files read ahead all at once, rather than each one when its load starts.
+	ResourceLoader::prefetch(to_prefetch);
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		const String path = external_resources[i].path;
 		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
 		if (external_resources[i].load_token.is_null()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -254,8 +254,17 @@ void ResourceLoader::LoadToken::clear() {
 			} else {
 				DEV_ASSERT(thread_load_tasks.has(local_path));
 				ThreadLoadTask &load_task = thread_load_tasks[local_path];
-				if (load_task.task_id && !load_task.awaited) {
-					task_to_await = load_task.task_id;
+				if (load_task.task_id) {
+					HashMap<WorkerThreadPool::TaskID, PoolTaskLoads>::Iterator T = pool_task_loads.find(load_task.task_id);
+					DEV_ASSERT(T && T->value.load_count > 0);
+					T->value.load_count--;
+					// Otherwise the same task is reused by nested loads, do not wait for completion here.
+					if (T->value.load_count == 0) {
+						if (!T->value.awaited) {
+							task_to_await = load_task.task_id;
+						}
+						pool_task_loads.remove(T);
+					}
 				}
 				// Removing a task which is still in progress would be catastrophic.
 				// Tokens must be alive until the task thread function is done.
@@ -263,14 +272,6 @@ void ResourceLoader::LoadToken::clear() {
 				thread_load_tasks.erase(local_path);
 			}
 			local_path.clear(); // Mark as already cleared.
-			if (task_to_await) {
-				for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
-					if (E.value.task_id == task_to_await) {
-						task_to_await = 0;
-						break; // Same task is reused by nested loads, do not wait for completion here.
-					}
-				}
-			}
 		}
 	}
 
@@ -654,6 +655,9 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		} else {
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
+		if (load_task_ptr->task_id && !must_not_register) {
+			pool_task_loads[load_task_ptr->task_id].load_count++;
+		}
 	} // MutexLock(thread_load_mutex).
 
 	if (p_thread_mode == LOAD_THREAD_FROM_CURRENT) {
@@ -836,12 +840,11 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 				}
 
 				p_thread_load_lock.temp_relock();
-				load_task.awaited = true;
-				// Mark nested loads with the same task id as awaited.
-				for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
-					if (E.value.task_id == load_task.task_id) {
-						E.value.awaited = true;
-					}
+				// This also marks nested loads with the same task id as awaited.
+				PoolTaskLoads *pool_task = pool_task_loads.getptr(load_task.task_id);
+				DEV_ASSERT(pool_task);
+				if (pool_task) {
+					pool_task->awaited = true;
 				}
 
 				DEV_ASSERT(load_task.status == THREAD_LOAD_FAILED || load_task.status == THREAD_LOAD_LOADED);
@@ -1376,7 +1379,103 @@ void ResourceLoader::clear_translation_remaps() {
 	}
 }
 
+void ResourceLoader::_prefetch_files(void *p_userdata) {
+	LocalVector<uint8_t> scratch;
+
+	while (true) {
+		String path;
+		{
+			MutexLock lock(prefetch_mutex);
+			if (prefetch_queue.is_empty()) {
+				prefetch_running = false;
+				return;
+			}
+			// Oldest first, it is the order the loader asks for them.
+			path = prefetch_queue.front()->get();
+			prefetch_queue.pop_front();
+		}
+
+		Ref<FileAccess> f = FileAccess::open(import_remap(_path_remap(path)), FileAccess::READ);
+		if (f.is_null()) {
+			continue; // The load itself will report it.
+		}
+
+		if (f->prefetch(0, f->get_length())) {
+			continue;
+		}
+
+		// The backend can't read ahead on its own, so pull the file through this thread
+		// to have the OS cache it before the loader gets to it.
+		scratch.resize(64 * 1024);
+		while (f->get_buffer(scratch.ptr(), scratch.size()) == scratch.size()) {
+		}
+	}
+}
+
+void ResourceLoader::prefetch(const Vector<String> &p_paths) {
+	if (p_paths.is_empty() || !WorkerThreadPool::get_singleton()) {
+		return;
+	}
+
+	LocalVector<WorkerThreadPool::TaskID> finished_tasks;
+	{
+		MutexLock lock(prefetch_mutex);
+
+		for (const String &path : p_paths) {
+			prefetch_queue.push_back(path);
+		}
+		if (prefetch_running) {
+			return;
+		}
+
+		// The previous task ran out of work, it is reclaimed below rather than waited for under the lock.
+		SWAP(finished_tasks, prefetch_finished_tasks);
+		if (prefetch_task != WorkerThreadPool::INVALID_TASK_ID) {
+			finished_tasks.push_back(prefetch_task);
+		}
+		prefetch_running = true;
+		prefetch_task = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_prefetch_files, nullptr, false, SNAME("ResourceLoader::prefetch"));
+	}
+
+	_reclaim_prefetch_tasks(finished_tasks);
+}
+
+void ResourceLoader::_reclaim_prefetch_tasks(LocalVector<WorkerThreadPool::TaskID> &p_tasks) {
+	LocalVector<WorkerThreadPool::TaskID> busy;
+	for (WorkerThreadPool::TaskID task : p_tasks) {
+		// Loads usually run on pool threads, which may not wait for older tasks. Those are left to the next call.
+		if (WorkerThreadPool::get_singleton()->wait_for_task_completion(task) == ERR_BUSY) {
+			busy.push_back(task);
+		}
+	}
+
+	if (!busy.is_empty()) {
+		MutexLock lock(prefetch_mutex);
+		for (WorkerThreadPool::TaskID task : busy) {
+			prefetch_finished_tasks.push_back(task);
+		}
+	}
+}
+
+void ResourceLoader::_finish_prefetch() {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	{
+		MutexLock lock(prefetch_mutex);
+		// An empty queue makes the task stop after the file it is reading.
+		prefetch_queue.clear();
+		SWAP(tasks, prefetch_finished_tasks);
+		if (prefetch_task != WorkerThreadPool::INVALID_TASK_ID) {
+			tasks.push_back(prefetch_task);
+		}
+		prefetch_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	_reclaim_prefetch_tasks(tasks);
+}
+
 void ResourceLoader::clear_thread_load_tasks() {
+	_finish_prefetch();
+
 	// Bring the thing down as quickly as possible without causing deadlocks or leaks.
 
 	MutexLock thread_load_lock(thread_load_mutex);
@@ -1413,6 +1512,7 @@ void ResourceLoader::clear_thread_load_tasks() {
 	}
 
 	thread_load_tasks.clear();
+	pool_task_loads.clear();
 
 	cleaning_tasks = false;
 }
@@ -1576,6 +1676,13 @@ thread_local SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::TLSData SafeBina
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> ResourceLoader::thread_load_mutex;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
 bool ResourceLoader::cleaning_tasks = false;
+HashMap<WorkerThreadPool::TaskID, ResourceLoader::PoolTaskLoads> ResourceLoader::pool_task_loads;
+
+Mutex ResourceLoader::prefetch_mutex;
+List<String> ResourceLoader::prefetch_queue;
+WorkerThreadPool::TaskID ResourceLoader::prefetch_task = WorkerThreadPool::INVALID_TASK_ID;
+LocalVector<WorkerThreadPool::TaskID> ResourceLoader::prefetch_finished_tasks;
+bool ResourceLoader::prefetch_running = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
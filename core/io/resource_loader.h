@@ -176,7 +176,6 @@ private:
 	struct ThreadLoadTask {
 		WorkerThreadPool::TaskID task_id = 0; // Used if run on a worker thread from the pool.
 		Thread::ID thread_id = 0; // Used if running on an user thread (e.g., simple non-threaded load).
-		bool awaited = false; // If it's in the pool, this helps not awaiting from more than one dependent thread.
 		ConditionVariable *cond_var = nullptr; // In not in the worker pool or already awaiting, this is used as a secondary awaiting mechanism.
 		uint32_t awaiters_count = 0;
 		bool need_wait = true;
@@ -215,6 +214,14 @@ private:
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
 	static bool cleaning_tasks;
 
+	// Registered loads running on each pool task (nested loads share their parent's task),
+	// so that awaiting a task doesn't need to go through every load in flight.
+	struct PoolTaskLoads {
+		uint32_t load_count = 0;
+		bool awaited = false; // Helps not awaiting from more than one dependent thread.
+	};
+	static HashMap<WorkerThreadPool::TaskID, PoolTaskLoads> pool_task_loads;
+
 	static HashMap<String, LoadToken *> user_load_tokens;
 
 	static float _dependency_get_progress(const String &p_path);
@@ -223,6 +230,17 @@ private:
 
 	static String _validate_local_path(const String &p_path);
 
+	// Files to read ahead, drained by a single low-priority task.
+	static Mutex prefetch_mutex;
+	static List<String> prefetch_queue;
+	static WorkerThreadPool::TaskID prefetch_task;
+	static LocalVector<WorkerThreadPool::TaskID> prefetch_finished_tasks; // Not reclaimed yet.
+	static bool prefetch_running;
+
+	static void _prefetch_files(void *p_userdata);
+	static void _reclaim_prefetch_tasks(LocalVector<WorkerThreadPool::TaskID> &p_tasks);
+	static void _finish_prefetch();
+
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
@@ -230,6 +248,8 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; }
 
+	static void prefetch(const Vector<String> &p_paths);
+
 	static void resource_changed_connect(Resource *p_source, const Callable &p_callable, uint32_t p_flags);
 	static void resource_changed_disconnect(Resource *p_source, const Callable &p_callable);
 	static void resource_changed_emit(Resource *p_source);
@@ -32,7 +32,7 @@
 
 #include "core/io/marshalls.h"
 
-Error StreamPeer::_put_data(const Vector<uint8_t> &p_data) {
+Error StreamPeer::_put_data(Span<uint8_t> p_data) {
 	int len = p_data.size();
 	if (len == 0) {
 		return OK;
@@ -41,7 +41,7 @@ Error StreamPeer::_put_data(const Vector<uint8_t> &p_data) {
 	return put_data(&r[0], len);
 }
 
-Array StreamPeer::_put_partial_data(const Vector<uint8_t> &p_data) {
+Array StreamPeer::_put_partial_data(Span<uint8_t> p_data) {
 	Array ret;
 
 	int len = p_data.size();
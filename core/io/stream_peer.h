@@ -43,8 +43,8 @@ protected:
 	static void _bind_methods();
 
 	//bind helpers
-	Error _put_data(const Vector<uint8_t> &p_data);
-	Array _put_partial_data(const Vector<uint8_t> &p_data);
+	Error _put_data(Span<uint8_t> p_data);
+	Array _put_partial_data(Span<uint8_t> p_data);
 
 	Array _get_data(int p_bytes);
 	Array _get_partial_data(int p_bytes);
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include <cstdio>
 
@@ -75,6 +76,10 @@ Error CallQueue::push_callp(Object *p_object, const StringName &p_method, const
 	return push_callp(p_object->get_instance_id(), p_method, p_args, p_argcount, p_show_error);
 }
 
+Error CallQueue::push_method_bindp(Object *p_object, MethodBind *p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+	return push_method_bindp(p_object->get_instance_id(), p_method, p_args, p_argcount, p_show_error);
+}
+
 Error CallQueue::push_notification(Object *p_object, int p_notification) {
 	return push_notification(p_object->get_instance_id(), p_notification);
 }
@@ -133,6 +138,55 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	return OK;
 }
 
+Error CallQueue::push_method_bindp(ObjectID p_id, MethodBind *p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+	ERR_FAIL_NULL_V(p_method, ERR_INVALID_PARAMETER);
+	uint32_t room_needed = sizeof(Message) + sizeof(MethodBind *) + sizeof(Variant) * p_argcount;
+
+	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
+
+	LOCK_MUTEX;
+
+	_ensure_first_page();
+
+	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used == max_pages) {
+			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_method->get_name()).utf8().get_data(), error_text.utf8().get_data());
+			statistics();
+			UNLOCK_MUTEX;
+			return ERR_OUT_OF_MEMORY;
+		}
+		_add_page();
+	}
+
+	Page *page = pages[pages_used - 1];
+
+	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+
+	Message *msg = memnew_placement(buffer_end, Message);
+	msg->args = p_argcount;
+	msg->callable = Callable(p_id, p_method->get_name());
+	msg->type = TYPE_CALL_METHOD_BIND;
+	if (p_show_error) {
+		msg->type |= FLAG_SHOW_ERROR;
+	}
+
+	buffer_end += sizeof(Message);
+	*(MethodBind **)buffer_end = p_method;
+	buffer_end += sizeof(MethodBind *);
+
+	for (int i = 0; i < p_argcount; i++) {
+		Variant *v = memnew_placement(buffer_end, Variant);
+		buffer_end += sizeof(Variant);
+		*v = *p_args[i];
+	}
+
+	page_bytes[pages_used - 1] += room_needed;
+
+	UNLOCK_MUTEX;
+
+	return OK;
+}
+
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
@@ -167,6 +221,19 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
+	if (coalesce_sets) {
+		uint64_t location = (uint64_t(pages_used - 1) << 32) | page_bytes[pages_used - 1];
+		uint64_t *pending = pending_sets.getptr(Pair<ObjectID, StringName>(p_id, p_prop));
+		if (pending) {
+			Message *previous = (Message *)&pages[*pending >> 32]->data[*pending & 0xFFFFFFFF];
+			previous->type |= FLAG_DISCARDED;
+			*pending = location;
+			frame_stats.coalesced_sets++;
+		} else {
+			pending_sets.insert(Pair<ObjectID, StringName>(p_id, p_prop), location);
+		}
+	}
+
 	page_bytes[pages_used - 1] += room_needed;
 	UNLOCK_MUTEX;
 
@@ -223,6 +290,22 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+void CallQueue::_call_method_bind(Object *p_target, MethodBind *p_method, const Variant *p_args, int p_argcount, bool p_show_error) {
+	const Variant **argptrs = nullptr;
+	if (p_argcount) {
+		argptrs = (const Variant **)alloca(sizeof(Variant *) * p_argcount);
+		for (int i = 0; i < p_argcount; i++) {
+			argptrs[i] = &p_args[i];
+		}
+	}
+
+	Callable::CallError ce;
+	p_method->call(p_target, argptrs, p_argcount, ce);
+	if (p_show_error && ce.error != Callable::CallError::CALL_OK) {
+		ERR_PRINT("Error calling deferred method: " + Variant::get_call_error_text(p_target, p_method->get_name(), argptrs, p_argcount, ce) + ".");
+	}
+}
+
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
@@ -239,6 +322,10 @@ Error CallQueue::flush() {
 
 	flushing = true;
 
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t messages = 0;
+	uint64_t bytes = 0;
+
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
@@ -249,48 +336,56 @@ Error CallQueue::flush() {
 
 		Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+		uint32_t advance = _get_message_size(message);
 
 		//pre-advance so this function is reentrant
 		offset += advance;
+		bytes += advance;
+
+		if (message->type & FLAG_DISCARDED) {
+			_destroy_message(message);
+		} else {
+			if (coalesce_sets && (message->type & FLAG_MASK) == TYPE_SET) {
+				// Sets pushed from now on can't be merged with this one anymore.
+				pending_sets.erase(Pair<ObjectID, StringName>(message->callable.get_object_id(), message->callable.get_method()));
+			}
 
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
+			Object *target = message->callable.get_object();
+			messages++;
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+			UNLOCK_MUTEX;
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = _get_message_args(message);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = _get_message_args(message);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+				case TYPE_CALL_METHOD_BIND: {
+					if (target) {
+						MethodBind *method = *(MethodBind **)(message + 1);
+						_call_method_bind(target, method, _get_message_args(message), message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
 			}
-		}
 
-		message->~Message();
+			_destroy_message(message);
+
+			LOCK_MUTEX;
+		}
 
-		LOCK_MUTEX;
 		if (offset == page_bytes[i]) {
 			i++;
 			offset = 0;
@@ -299,6 +394,11 @@ Error CallQueue::flush() {
 
 	page_bytes[0] = 0;
 	pages_used = 1;
+	pending_sets.clear();
+
+	frame_stats.messages += messages;
+	frame_stats.bytes += bytes;
+	frame_stats.usec += OS::get_singleton()->get_ticks_usec() - start_usec;
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -322,26 +422,15 @@ void CallQueue::clear() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+			offset += _get_message_size(message);
 
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
 	pages_used = 1;
 	page_bytes[0] = 0;
+	pending_sets.clear();
 
 	UNLOCK_MUTEX;
 }
@@ -362,16 +451,14 @@ void CallQueue::statistics() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			uint32_t advance = _get_message_size(message);
 
 			Object *target = message->callable.get_object();
 
 			bool null_target = true;
 			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
+				case TYPE_CALL:
+				case TYPE_CALL_METHOD_BIND: {
 					if (target || (message->type & FLAG_NULL_IS_OK)) {
 						if (!call_count.has(message->callable)) {
 							call_count[message->callable] = 0;
@@ -412,14 +499,7 @@ void CallQueue::statistics() {
 
 			offset += advance;
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
@@ -460,6 +540,37 @@ int CallQueue::get_max_buffer_usage() const {
 	return pages.size() * PAGE_SIZE_BYTES;
 }
 
+void CallQueue::set_coalesce_sets(bool p_enable) {
+	LOCK_MUTEX;
+	if (!p_enable) {
+		pending_sets.clear();
+	} else if (!coalesce_sets && has_messages()) {
+		// Sets already in the queue aren't indexed, so don't start before the next flush.
+		UNLOCK_MUTEX;
+		ERR_FAIL_MSG("Can't enable coalescing sets while messages are pending.");
+	}
+	coalesce_sets = p_enable;
+	UNLOCK_MUTEX;
+}
+
+bool CallQueue::is_coalescing_sets() const {
+	return coalesce_sets;
+}
+
+void CallQueue::end_frame_stats() {
+	LOCK_MUTEX;
+	last_frame_stats = frame_stats;
+	frame_stats = FlushStats();
+	UNLOCK_MUTEX;
+}
+
+CallQueue::FlushStats CallQueue::get_last_frame_stats() const {
+	LOCK_MUTEX;
+	FlushStats stats = last_frame_stats;
+	UNLOCK_MUTEX;
+	return stats;
+}
+
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
@@ -509,6 +620,7 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	set_coalesce_sets(GLOBAL_DEF_RST("application/run/coalesce_deferred_sets", false));
 }
 
 MessageQueue::~MessageQueue() {
@@ -32,10 +32,13 @@
 
 #include "core/object/object_id.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/pair.h"
 #include "core/variant/variant.h"
 
+class MethodBind;
 class Object;
 
 class CallQueue {
@@ -54,18 +57,27 @@ public:
 	// Needs to lock because there can be multiple of these allocators in several threads.
 	typedef PagedAllocator<Page, true> Allocator;
 
+	struct FlushStats {
+		uint64_t messages = 0;
+		uint64_t bytes = 0;
+		uint64_t usec = 0;
+		uint64_t coalesced_sets = 0;
+	};
+
 private:
 	enum {
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
 		TYPE_SET,
+		TYPE_CALL_METHOD_BIND,
 		TYPE_END, // End marker.
+		FLAG_DISCARDED = 1 << 12, // Superseded by a later message, skipped when flushing.
 		FLAG_NULL_IS_OK = 1 << 13,
 		FLAG_SHOW_ERROR = 1 << 14,
-		FLAG_MASK = FLAG_NULL_IS_OK - 1,
+		FLAG_MASK = FLAG_DISCARDED - 1,
 	};
 
-	Mutex mutex;
+	mutable Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
@@ -76,6 +88,13 @@ private:
 	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	// Pending set messages by object and property, as (page << 32 | offset), used to coalesce them.
+	bool coalesce_sets = false;
+	HashMap<Pair<ObjectID, StringName>, uint64_t> pending_sets;
+
+	FlushStats frame_stats;
+	FlushStats last_frame_stats;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -89,6 +108,36 @@ private:
 		};
 	};
 
+	// Method bind calls store the MethodBind pointer between the message and its arguments.
+	_FORCE_INLINE_ static Variant *_get_message_args(Message *p_message) {
+		uint8_t *args = (uint8_t *)(p_message + 1);
+		if ((p_message->type & FLAG_MASK) == TYPE_CALL_METHOD_BIND) {
+			args += sizeof(MethodBind *);
+		}
+		return (Variant *)args;
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		switch (p_message->type & FLAG_MASK) {
+			case TYPE_NOTIFICATION:
+				return sizeof(Message);
+			case TYPE_CALL_METHOD_BIND:
+				return sizeof(Message) + sizeof(MethodBind *) + sizeof(Variant) * p_message->args;
+			default:
+				return sizeof(Message) + sizeof(Variant) * p_message->args;
+		}
+	}
+
+	_FORCE_INLINE_ static void _destroy_message(Message *p_message) {
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			Variant *args = _get_message_args(p_message);
+			for (int k = 0; k < p_message->args; k++) {
+				args[k].~Variant();
+			}
+		}
+		p_message->~Message();
+	}
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -100,6 +149,7 @@ private:
 	void _add_page();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
+	void _call_method_bind(Object *p_target, MethodBind *p_method, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	String error_text;
 
@@ -143,6 +193,20 @@ public:
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
+	// Calls an already resolved method when flushing, skipping the lookup by name.
+	// Scripts attached to the object are not considered, so only use this for objects without one.
+	Error push_method_bindp(ObjectID p_id, MethodBind *p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
+	Error push_method_bindp(Object *p_object, MethodBind *p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
+	template <typename... VarArgs>
+	Error push_method_bind(Object *p_object, MethodBind *p_method, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return push_method_bindp(p_object, p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+
 	Error flush();
 	void clear();
 	void statistics();
@@ -152,6 +216,15 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// When enabled, a set pushed while another one for the same object and property is still
+	// pending replaces it, so the setter only runs once with the latest value.
+	void set_coalesce_sets(bool p_enable);
+	bool is_coalescing_sets() const;
+
+	// Flush statistics are accumulated until end_frame_stats() is called, usually once per frame.
+	void end_frame_stats();
+	FlushStats get_last_frame_stats() const;
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -187,7 +187,11 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+		if (thread_data->pool->use_work_stealing) {
+			// Fast path: take from the local queue or steal from another thread without touching the mutex.
+			task_to_process = thread_data->pool->_pop_local_task(thread_data);
+		}
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -200,17 +204,24 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				if (thread_data->pool->use_work_stealing) {
+					// Local tasks are only pushed with the mutex held, so nothing can be missed between this check and the wait.
+					task_to_process = thread_data->pool->_pop_local_task(thread_data);
+					if (task_to_process) {
+						break;
+					}
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -219,7 +230,7 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
-void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task) {
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task, int p_affinity_hint) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
 	// in custom builds.
@@ -244,10 +255,44 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// In work-stealing mode, tasks that can run right away go to the per-thread queues.
+	// Pump tasks stay in the shared queue, since threads need to be able to skip them.
+	bool use_local_queues = use_work_stealing && !p_pump_task;
+	uint32_t local_queue_count = use_local_queues ? local_queues.size() : 0;
+	uint32_t local_queue_index = 0;
+	bool spread_local_tasks = true;
+	if (use_local_queues) {
+		if (p_affinity_hint >= 0) {
+			local_queue_index = p_affinity_hint;
+		} else if (caller_pool_thread && caller_pool_thread->local_queue) {
+			// Keep nested work on the thread that spawned it; idle threads will steal it.
+			local_queue_index = caller_pool_thread->index;
+			spread_local_tasks = false;
+		} else {
+			local_queue_index = next_local_queue;
+			next_local_queue = (next_local_queue + p_count) % local_queue_count;
+		}
+	}
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			bool queued_locally = false;
+			if (use_local_queues) {
+				LocalTaskQueue *queue = local_queues[local_queue_index % local_queue_count];
+				if (spread_local_tasks) {
+					local_queue_index++;
+				}
+				local_tasks_queued.increment();
+				queued_locally = queue->push(p_tasks[i]);
+				if (!queued_locally) {
+					// Queue full, fall back to the shared queue.
+					local_tasks_queued.decrement();
+				}
+			}
+			if (!queued_locally) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -326,6 +371,34 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue && p_thread_data->local_queue->pop(task)) {
+		local_tasks_queued.decrement();
+		return task;
+	}
+
+	uint32_t queue_count = local_queues.size();
+	if (queue_count == 0 || local_tasks_queued.get() == 0) {
+		return nullptr;
+	}
+
+	// Steal, starting from a random victim so thieves don't all hammer the same queue.
+	p_thread_data->steal_seed = p_thread_data->steal_seed * 1664525u + 1013904223u;
+	uint32_t start = (p_thread_data->steal_seed >> 16) % queue_count;
+	for (uint32_t i = 0; i < queue_count; i++) {
+		LocalTaskQueue *victim = local_queues[(start + i) % queue_count];
+		if (victim == p_thread_data->local_queue) {
+			continue;
+		}
+		if (victim->pop(task)) {
+			local_tasks_queued.decrement();
+			return task;
+		}
+	}
+	return nullptr;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -338,11 +411,11 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, int p_affinity_hint) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_affinity_hint);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, int p_affinity_hint) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -381,19 +454,20 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 			threads.resize_initialized(thread_count + 1);
 			threads[thread_count].index = thread_count;
 			threads[thread_count].pool = this;
+			threads[thread_count].steal_seed = thread_count * 2654435761u + 1;
 			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count], settings);
 			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
 		}
 	}
 #endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task, p_affinity_hint);
 
 	return id;
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description, bool p_pump_task) {
-	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_pump_task);
+WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description, bool p_pump_task, int p_affinity_hint) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_pump_task, p_affinity_hint);
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_action, bool p_high_priority, const String &p_description) {
@@ -528,7 +602,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -554,6 +628,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				} else {
 					task_queue.remove(task_queue.first());
 				}
+			} else if (use_work_stealing) {
+				task_to_process = _pop_local_task(p_caller_pool_thread);
 			}
 
 			if (!task_to_process) {
@@ -599,7 +675,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -662,7 +738,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, int p_affinity_hint) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -704,13 +780,13 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false, p_affinity_hint);
 
 	return id;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, int p_affinity_hint) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_affinity_hint);
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
@@ -818,7 +894,7 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_use_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
@@ -829,7 +905,9 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	use_work_stealing = p_use_work_stealing && p_thread_count > 0;
+
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, use_work_stealing ? ", work-stealing" : ""));
 
 #ifdef THREADS_ENABLED
 	// Reserve 5 threads in case we need separate threads for 1) 2D physics 2) 3D physics 3) rendering 4) GPU texture compression, 5) all other tasks.
@@ -851,9 +929,19 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 #endif
 #endif
 
+	if (use_work_stealing) {
+		// Only the threads created here get a local queue. The ones spawned later for pump tasks can still steal.
+		local_queues.resize(threads.size());
+		for (uint32_t i = 0; i < threads.size(); i++) {
+			local_queues[i] = memnew(LocalTaskQueue);
+			threads[i].local_queue = local_queues[i];
+		}
+	}
+
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
 		threads[i].pool = this;
+		threads[i].steal_seed = i * 2654435761u + 1;
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i], settings);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
@@ -906,6 +994,12 @@ void WorkerThreadPool::finish() {
 		}
 	}
 
+	for (LocalTaskQueue *queue : local_queues) {
+		memdelete(queue);
+	}
+	local_queues.clear();
+	local_tasks_queued.set(0);
+
 	threads.clear();
 }
 
@@ -30,9 +30,12 @@
 
 #include "memory.h"
 
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
+#include <cstring>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -42,6 +45,10 @@ void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)) {
 	return p_allocfunc(p_size);
 }
 
+void *operator new(size_t p_size, const MemoryCallSite &p_site) {
+	return Memory::alloc_static_tagged(p_size, p_site);
+}
+
 #ifdef _MSC_VER
 void operator delete(void *p_mem, const char *p_description) {
 	CRASH_NOW_MSG("Call to placement delete should not happen.");
@@ -51,6 +58,10 @@ void operator delete(void *p_mem, void *(*p_allocfunc)(size_t p_size)) {
 	CRASH_NOW_MSG("Call to placement delete should not happen.");
 }
 
+void operator delete(void *p_mem, const MemoryCallSite &p_site) {
+	CRASH_NOW_MSG("Call to placement delete should not happen.");
+}
+
 void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_description) {
 	CRASH_NOW_MSG("Call to placement delete should not happen.");
 }
@@ -71,6 +82,10 @@ void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 
 	p2 = (void *)(((uintptr_t)p1 + sizeof(uint32_t) + p_alignment - 1) & ~((p_alignment)-1));
 	*((uint32_t *)p2 - 1) = (uint32_t)((uintptr_t)p2 - (uintptr_t)p1);
+
+	if (unlikely(HeapProfiler::is_enabled())) {
+		HeapProfiler::_record_alloc(p2, p_bytes);
+	}
 	return p2;
 }
 
@@ -88,6 +103,10 @@ void *Memory::realloc_aligned_static(void *p_memory, size_t p_bytes, size_t p_pr
 }
 
 void Memory::free_aligned_static(void *p_memory) {
+	if (unlikely(HeapProfiler::is_enabled())) {
+		HeapProfiler::_record_free(p_memory);
+	}
+
 	uint32_t offset = *((uint32_t *)p_memory - 1);
 	void *p = (void *)((uint8_t *)p_memory - offset);
 	free(p);
@@ -120,20 +139,40 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
 #endif
-		return s8 + DATA_OFFSET;
-	} else {
-		return mem;
+		mem = s8 + DATA_OFFSET;
 	}
+
+	if (unlikely(HeapProfiler::is_enabled())) {
+		HeapProfiler::_record_alloc(mem, p_bytes);
+	}
+	return mem;
 }
 
 template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
 template void *Memory::alloc_static<false>(size_t p_bytes, bool p_pad_align);
 
+void *Memory::alloc_static_tagged(size_t p_bytes, const MemoryCallSite &p_site) {
+	if (likely(!HeapProfiler::is_enabled())) {
+		return alloc_static(p_bytes, false);
+	}
+
+	const MemoryCallSite *previous = HeapProfiler::thread_site;
+	HeapProfiler::thread_site = &p_site;
+	void *mem = alloc_static(p_bytes, false);
+	HeapProfiler::thread_site = previous;
+	return mem;
+}
+
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (p_memory == nullptr) {
 		return alloc_static(p_bytes, p_pad_align);
 	}
 
+	if (unlikely(HeapProfiler::is_enabled())) {
+		// Profiled as a free followed by a new allocation.
+		HeapProfiler::_record_free(p_memory);
+	}
+
 	uint8_t *mem = (uint8_t *)p_memory;
 
 #ifdef DEBUG_ENABLED
@@ -168,20 +207,27 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			*s = p_bytes;
 
-			return mem + DATA_OFFSET;
+			mem += DATA_OFFSET;
 		}
 	} else {
 		mem = (uint8_t *)realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
+	}
 
-		return mem;
+	if (unlikely(HeapProfiler::is_enabled()) && mem) {
+		HeapProfiler::_record_alloc(mem, p_bytes);
 	}
+	return mem;
 }
 
 void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	ERR_FAIL_NULL(p_ptr);
 
+	if (unlikely(HeapProfiler::is_enabled())) {
+		HeapProfiler::_record_free(p_ptr);
+	}
+
 	uint8_t *mem = (uint8_t *)p_ptr;
 
 #ifdef DEBUG_ENABLED
@@ -224,6 +270,506 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+// FrameArena.
+
+namespace {
+
+struct FrameArenaChunk {
+	FrameArenaChunk *next = nullptr;
+	uint64_t size = 0; // Usable bytes after the header.
+	uint64_t used = 0;
+};
+
+// Each allocation is prefixed by its size, so realloc() knows how much to copy.
+constexpr size_t FRAME_ARENA_ALIGN = alignof(max_align_t);
+constexpr size_t FRAME_ARENA_CHUNK_HEADER = (sizeof(FrameArenaChunk) + FRAME_ARENA_ALIGN - 1) & ~(FRAME_ARENA_ALIGN - 1);
+constexpr size_t FRAME_ARENA_ALLOC_HEADER = (sizeof(uint64_t) + FRAME_ARENA_ALIGN - 1) & ~(FRAME_ARENA_ALIGN - 1);
+constexpr uint64_t FRAME_ARENA_MIN_CHUNK_SIZE = 64 * 1024;
+
+struct FrameArenaThread {
+	FrameArenaChunk *first = nullptr;
+	FrameArenaChunk *current = nullptr; // Chunks after this one are spares.
+	uint8_t *last_alloc = nullptr; // Can grow in place.
+
+	uint64_t used = 0;
+	// Read by other threads for stats.
+	SafeNumeric<uint64_t> high_water;
+	SafeNumeric<uint64_t> capacity;
+	SafeNumeric<uint64_t> used_stat;
+
+	Thread::ID thread_id = 0;
+	bool registered = false;
+	FrameArenaThread *prev_thread = nullptr;
+	FrameArenaThread *next_thread = nullptr;
+
+	_FORCE_INLINE_ static uint8_t *chunk_data(FrameArenaChunk *p_chunk) {
+		return (uint8_t *)p_chunk + FRAME_ARENA_CHUNK_HEADER;
+	}
+
+	void register_thread();
+	void grow(uint64_t p_needed);
+
+	_FORCE_INLINE_ void set_used(uint64_t p_used) {
+		used = p_used;
+		used_stat.set(used);
+		if (used > high_water.get()) {
+			high_water.set(used);
+		}
+	}
+
+	~FrameArenaThread();
+};
+
+SpinLock frame_arena_threads_lock;
+FrameArenaThread *frame_arena_threads = nullptr;
+
+thread_local FrameArenaThread frame_arena_thread;
+
+void FrameArenaThread::register_thread() {
+	thread_id = Thread::get_caller_id();
+	frame_arena_threads_lock.lock();
+	next_thread = frame_arena_threads;
+	if (frame_arena_threads) {
+		frame_arena_threads->prev_thread = this;
+	}
+	frame_arena_threads = this;
+	frame_arena_threads_lock.unlock();
+	registered = true;
+}
+
+void FrameArenaThread::grow(uint64_t p_needed) {
+	if (!registered) {
+		register_thread();
+	}
+
+	// Reuse a spare chunk if it's big enough.
+	FrameArenaChunk *spare = current ? current->next : first;
+	if (spare && spare->size >= p_needed) {
+		spare->used = 0;
+		current = spare;
+		last_alloc = nullptr;
+		return;
+	}
+
+	uint64_t size = MAX(MAX(FRAME_ARENA_MIN_CHUNK_SIZE, capacity.get()), p_needed);
+	FrameArenaChunk *chunk = (FrameArenaChunk *)Memory::alloc_static(FRAME_ARENA_CHUNK_HEADER + size);
+	CRASH_COND_MSG(!chunk, "Out of memory");
+	chunk->size = size;
+	chunk->used = 0;
+	capacity.add(size);
+
+	// Insert after the current chunk, keeping the smaller spares for later.
+	if (current) {
+		chunk->next = current->next;
+		current->next = chunk;
+	} else {
+		chunk->next = first;
+		first = chunk;
+	}
+	current = chunk;
+	last_alloc = nullptr;
+}
+
+FrameArenaThread::~FrameArenaThread() {
+	if (registered) {
+		frame_arena_threads_lock.lock();
+		if (prev_thread) {
+			prev_thread->next_thread = next_thread;
+		} else {
+			frame_arena_threads = next_thread;
+		}
+		if (next_thread) {
+			next_thread->prev_thread = prev_thread;
+		}
+		frame_arena_threads_lock.unlock();
+	}
+
+	FrameArenaChunk *chunk = first;
+	while (chunk) {
+		FrameArenaChunk *next = chunk->next;
+		Memory::free_static(chunk);
+		chunk = next;
+	}
+}
+
+} // namespace
+
+void *FrameArena::alloc(size_t p_bytes) {
+	FrameArenaThread &arena = frame_arena_thread;
+
+	uint64_t needed = FRAME_ARENA_ALLOC_HEADER + ((p_bytes + FRAME_ARENA_ALIGN - 1) & ~(FRAME_ARENA_ALIGN - 1));
+	if (unlikely(!arena.current || arena.current->used + needed > arena.current->size)) {
+		uint64_t wasted = arena.current ? arena.current->size - arena.current->used : 0;
+		arena.grow(needed);
+		// Whatever was left in the previous chunk counts as used until the arena is rewound.
+		arena.set_used(arena.used + wasted);
+	}
+
+	uint8_t *mem = FrameArenaThread::chunk_data(arena.current) + arena.current->used;
+	*(uint64_t *)mem = p_bytes;
+	arena.current->used += needed;
+	arena.set_used(arena.used + needed);
+
+	arena.last_alloc = mem + FRAME_ARENA_ALLOC_HEADER;
+	return arena.last_alloc;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		return nullptr;
+	}
+
+	FrameArenaThread &arena = frame_arena_thread;
+	uint8_t *mem = (uint8_t *)p_memory;
+	uint64_t *size = (uint64_t *)(mem - FRAME_ARENA_ALLOC_HEADER);
+	uint64_t old_bytes = *size;
+
+	if (mem == arena.last_alloc) {
+		// Most recent allocation of this thread, try to resize in place.
+		uint64_t old_rounded = (old_bytes + FRAME_ARENA_ALIGN - 1) & ~(FRAME_ARENA_ALIGN - 1);
+		uint64_t new_rounded = (p_bytes + FRAME_ARENA_ALIGN - 1) & ~(FRAME_ARENA_ALIGN - 1);
+		uint64_t chunk_used = arena.current->used - old_rounded + new_rounded;
+		if (chunk_used <= arena.current->size) {
+			arena.current->used = chunk_used;
+			arena.set_used(arena.used - old_rounded + new_rounded);
+			*size = p_bytes;
+			return p_memory;
+		}
+	} else if (p_bytes <= old_bytes) {
+		*size = p_bytes;
+		return p_memory;
+	}
+
+	void *new_mem = alloc(p_bytes);
+	memcpy(new_mem, p_memory, MIN(old_bytes, (uint64_t)p_bytes));
+	return new_mem;
+}
+
+void FrameArena::reset() {
+	FrameArenaThread &arena = frame_arena_thread;
+	if (arena.first) {
+		arena.current = arena.first;
+		arena.current->used = 0;
+	}
+	arena.last_alloc = nullptr;
+	arena.set_used(0);
+}
+
+FrameArena::Scope::Scope() {
+	FrameArenaThread &arena = frame_arena_thread;
+	chunk = arena.current;
+	chunk_used = arena.current ? arena.current->used : 0;
+	used = arena.used;
+}
+
+FrameArena::Scope::~Scope() {
+	FrameArenaThread &arena = frame_arena_thread;
+	if (chunk) {
+		arena.current = (FrameArenaChunk *)chunk;
+		arena.current->used = chunk_used;
+	} else if (arena.first) {
+		// Nothing was allocated when the scope was opened.
+		arena.current = arena.first;
+		arena.current->used = 0;
+	}
+	arena.last_alloc = nullptr;
+	arena.set_used(used);
+}
+
+uint32_t FrameArena::get_thread_stats(ThreadStats *r_stats, uint32_t p_max_count) {
+	uint32_t count = 0;
+	frame_arena_threads_lock.lock();
+	for (FrameArenaThread *arena = frame_arena_threads; arena && count < p_max_count; arena = arena->next_thread) {
+		ThreadStats &stats = r_stats[count++];
+		stats.thread_id = arena->thread_id;
+		stats.used = arena->used_stat.get();
+		stats.high_water = arena->high_water.get();
+		stats.capacity = arena->capacity.get();
+	}
+	frame_arena_threads_lock.unlock();
+	return count;
+}
+
+uint64_t FrameArena::get_max_high_water() {
+	uint64_t max_high_water = 0;
+	frame_arena_threads_lock.lock();
+	for (FrameArenaThread *arena = frame_arena_threads; arena; arena = arena->next_thread) {
+		max_high_water = MAX(max_high_water, arena->high_water.get());
+	}
+	frame_arena_threads_lock.unlock();
+	return max_high_water;
+}
+
+// HeapProfiler.
+
+std::atomic<bool> HeapProfiler::enabled = false;
+thread_local const char *HeapProfiler::thread_tag = nullptr;
+thread_local const MemoryCallSite *HeapProfiler::thread_site = nullptr;
+
+namespace {
+
+// The profiler's own tables are allocated with malloc() directly, so recording never re-enters it.
+constexpr uint32_t HEAP_PROFILER_SITE_CAPACITY = 4096; // Power of 2.
+constexpr uint32_t HEAP_PROFILER_MAX_SITES = HEAP_PROFILER_SITE_CAPACITY / 4 * 3;
+constexpr uint32_t HEAP_PROFILER_OVERFLOW_SITE = HEAP_PROFILER_SITE_CAPACITY; // Collects samples once the table is full.
+constexpr uint32_t HEAP_PROFILER_MIN_SAMPLE_CAPACITY = 1024; // Power of 2.
+
+struct HeapProfilerSample {
+	void *ptr = nullptr; // nullptr if the slot is empty.
+	uint32_t site = 0;
+	uint64_t bytes = 0;
+};
+
+SpinLock heap_profiler_lock;
+std::atomic<uint64_t> heap_profiler_sample_interval = HeapProfiler::DEFAULT_SAMPLE_INTERVAL;
+std::atomic<uint32_t> heap_profiler_run = 0; // Incremented by every start().
+
+// Open addressing with linear probing. A site slot is empty while it has no samples.
+HeapProfiler::Site *heap_profiler_sites = nullptr;
+uint32_t heap_profiler_site_count = 0;
+
+HeapProfilerSample *heap_profiler_samples = nullptr;
+uint32_t heap_profiler_sample_capacity = 0;
+std::atomic<uint32_t> heap_profiler_sample_count = 0;
+
+// Bytes this thread can allocate before its next sample, and the run this countdown belongs to.
+thread_local int64_t heap_profiler_countdown = 0;
+thread_local uint32_t heap_profiler_thread_run = 0;
+
+_FORCE_INLINE_ uint32_t heap_profiler_hash_string(const char *p_str, uint32_t p_hash) {
+	if (p_str) {
+		// FNV-1a.
+		for (const uint8_t *c = (const uint8_t *)p_str; *c; c++) {
+			p_hash = (p_hash ^ *c) * 16777619u;
+		}
+	}
+	return p_hash;
+}
+
+_FORCE_INLINE_ bool heap_profiler_string_equal(const char *p_a, const char *p_b) {
+	if (p_a == p_b) {
+		return true;
+	}
+	return p_a && p_b && strcmp(p_a, p_b) == 0;
+}
+
+_FORCE_INLINE_ uint32_t heap_profiler_hash_ptr(const void *p_ptr, uint32_t p_mask) {
+	return (uint32_t)(((uint64_t)(uintptr_t)p_ptr * 0x9E3779B97F4A7C15ull) >> 32) & p_mask;
+}
+
+uint32_t heap_profiler_find_site(const char *p_tag, const char *p_file, int p_line) {
+	uint32_t hash = heap_profiler_hash_string(p_file, heap_profiler_hash_string(p_tag, 2166136261u));
+	hash = (hash ^ (uint32_t)p_line) * 16777619u;
+
+	const uint32_t mask = HEAP_PROFILER_SITE_CAPACITY - 1;
+	for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+		HeapProfiler::Site &site = heap_profiler_sites[i];
+		if (site.samples == 0) {
+			if (heap_profiler_site_count >= HEAP_PROFILER_MAX_SITES) {
+				return HEAP_PROFILER_OVERFLOW_SITE;
+			}
+			site.tag = p_tag;
+			site.file = p_file;
+			site.line = p_line;
+			heap_profiler_site_count++;
+			return i;
+		}
+		if (site.line == p_line && heap_profiler_string_equal(site.tag, p_tag) && heap_profiler_string_equal(site.file, p_file)) {
+			return i;
+		}
+	}
+}
+
+bool heap_profiler_insert_sample(void *p_ptr, uint32_t p_site, uint64_t p_bytes) {
+	uint32_t count = heap_profiler_sample_count.load(std::memory_order_relaxed);
+	if ((count + 1) * 2 > heap_profiler_sample_capacity) {
+		uint32_t new_capacity = heap_profiler_sample_capacity * 2;
+		HeapProfilerSample *new_samples = (HeapProfilerSample *)calloc(new_capacity, sizeof(HeapProfilerSample));
+		if (!new_samples) {
+			return false;
+		}
+		for (uint32_t i = 0; i < heap_profiler_sample_capacity; i++) {
+			const HeapProfilerSample &sample = heap_profiler_samples[i];
+			if (sample.ptr) {
+				uint32_t j = heap_profiler_hash_ptr(sample.ptr, new_capacity - 1);
+				while (new_samples[j].ptr) {
+					j = (j + 1) & (new_capacity - 1);
+				}
+				new_samples[j] = sample;
+			}
+		}
+		free(heap_profiler_samples);
+		heap_profiler_samples = new_samples;
+		heap_profiler_sample_capacity = new_capacity;
+	}
+
+	const uint32_t mask = heap_profiler_sample_capacity - 1;
+	uint32_t i = heap_profiler_hash_ptr(p_ptr, mask);
+	while (heap_profiler_samples[i].ptr) {
+		i = (i + 1) & mask;
+	}
+	heap_profiler_samples[i].ptr = p_ptr;
+	heap_profiler_samples[i].site = p_site;
+	heap_profiler_samples[i].bytes = p_bytes;
+	heap_profiler_sample_count.store(count + 1, std::memory_order_relaxed);
+	return true;
+}
+
+void heap_profiler_erase_sample(void *p_ptr) {
+	const uint32_t mask = heap_profiler_sample_capacity - 1;
+	uint32_t i = heap_profiler_hash_ptr(p_ptr, mask);
+	while (heap_profiler_samples[i].ptr != p_ptr) {
+		if (!heap_profiler_samples[i].ptr) {
+			return; // Not sampled.
+		}
+		i = (i + 1) & mask;
+	}
+
+	const HeapProfilerSample &sample = heap_profiler_samples[i];
+	heap_profiler_sites[sample.site].live_bytes -= sample.bytes;
+	heap_profiler_sample_count.store(heap_profiler_sample_count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+	// Backward shift deletion, so lookups never need tombstones.
+	for (uint32_t j = (i + 1) & mask; heap_profiler_samples[j].ptr; j = (j + 1) & mask) {
+		uint32_t home = heap_profiler_hash_ptr(heap_profiler_samples[j].ptr, mask);
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			heap_profiler_samples[i] = heap_profiler_samples[j];
+			i = j;
+		}
+	}
+	heap_profiler_samples[i] = HeapProfilerSample();
+}
+
+} // namespace
+
+void HeapProfiler::_record_alloc(void *p_ptr, size_t p_bytes) {
+	const uint32_t run = heap_profiler_run.load(std::memory_order_relaxed);
+	const int64_t interval = (int64_t)heap_profiler_sample_interval.load(std::memory_order_relaxed);
+	if (heap_profiler_thread_run != run) {
+		heap_profiler_thread_run = run;
+		heap_profiler_countdown = interval;
+	}
+
+	heap_profiler_countdown -= (int64_t)p_bytes;
+	if (likely(heap_profiler_countdown > 0)) {
+		return;
+	}
+
+	// The sample stands for every interval crossed since the previous one.
+	const uint64_t crossed = (uint64_t)(-heap_profiler_countdown) / interval + 1;
+	const uint64_t bytes = crossed * interval;
+	heap_profiler_countdown += (int64_t)bytes;
+
+	const MemoryCallSite *call_site = thread_site;
+	const char *tag = (call_site && call_site->tag) ? call_site->tag : thread_tag;
+
+	heap_profiler_lock.lock();
+	if (enabled.load(std::memory_order_relaxed)) {
+		uint32_t index = call_site ? heap_profiler_find_site(tag, call_site->file, call_site->line) : heap_profiler_find_site(tag, nullptr, 0);
+		Site &site = heap_profiler_sites[index];
+		site.samples++;
+		site.allocated_bytes += bytes;
+		if (heap_profiler_insert_sample(p_ptr, index, bytes)) {
+			site.live_bytes += bytes;
+		}
+	}
+	heap_profiler_lock.unlock();
+}
+
+void HeapProfiler::_record_free(void *p_ptr) {
+	if (heap_profiler_sample_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	heap_profiler_lock.lock();
+	if (enabled.load(std::memory_order_relaxed)) {
+		heap_profiler_erase_sample(p_ptr);
+	}
+	heap_profiler_lock.unlock();
+}
+
+void HeapProfiler::start(uint64_t p_sample_interval) {
+	// Stop first, so that nothing is recorded while the tables are reset.
+	enabled.store(false, std::memory_order_relaxed);
+
+	heap_profiler_lock.lock();
+	if (!heap_profiler_sites) {
+		heap_profiler_sites = (Site *)calloc(HEAP_PROFILER_SITE_CAPACITY + 1, sizeof(Site));
+	} else {
+		memset((void *)heap_profiler_sites, 0, (HEAP_PROFILER_SITE_CAPACITY + 1) * sizeof(Site));
+	}
+	free(heap_profiler_samples);
+	heap_profiler_samples = (HeapProfilerSample *)calloc(HEAP_PROFILER_MIN_SAMPLE_CAPACITY, sizeof(HeapProfilerSample));
+
+	if (!heap_profiler_sites || !heap_profiler_samples) {
+		free(heap_profiler_samples);
+		heap_profiler_samples = nullptr;
+		heap_profiler_sample_capacity = 0;
+		heap_profiler_lock.unlock();
+		ERR_FAIL_MSG("Not enough memory to start the heap profiler.");
+	}
+
+	heap_profiler_sites[HEAP_PROFILER_OVERFLOW_SITE].tag = "(overflow)";
+	heap_profiler_site_count = 0;
+	heap_profiler_sample_capacity = HEAP_PROFILER_MIN_SAMPLE_CAPACITY;
+	heap_profiler_sample_count.store(0, std::memory_order_relaxed);
+
+	heap_profiler_sample_interval.store(MAX(p_sample_interval, (uint64_t)1), std::memory_order_relaxed);
+	heap_profiler_run.fetch_add(1, std::memory_order_relaxed);
+	enabled.store(true, std::memory_order_relaxed);
+	heap_profiler_lock.unlock();
+}
+
+void HeapProfiler::stop() {
+	enabled.store(false, std::memory_order_relaxed);
+}
+
+uint64_t HeapProfiler::get_sample_interval() {
+	return heap_profiler_sample_interval.load(std::memory_order_relaxed);
+}
+
+uint32_t HeapProfiler::get_sites(Site *r_sites, uint32_t p_max_count) {
+	uint32_t count = 0;
+	heap_profiler_lock.lock();
+	if (heap_profiler_sites) {
+		for (uint32_t i = 0; i <= HEAP_PROFILER_SITE_CAPACITY && count < p_max_count; i++) {
+			if (heap_profiler_sites[i].samples > 0) {
+				r_sites[count++] = heap_profiler_sites[i];
+			}
+		}
+	}
+	heap_profiler_lock.unlock();
+	return count;
+}
+
+uint32_t HeapProfiler::get_site_count() {
+	heap_profiler_lock.lock();
+	uint32_t count = heap_profiler_site_count;
+	if (heap_profiler_sites && heap_profiler_sites[HEAP_PROFILER_OVERFLOW_SITE].samples > 0) {
+		count++;
+	}
+	heap_profiler_lock.unlock();
+	return count;
+}
+
+uint64_t HeapProfiler::get_tag_live_bytes(const char *p_tag) {
+	uint64_t bytes = 0;
+	heap_profiler_lock.lock();
+	if (heap_profiler_sites) {
+		for (uint32_t i = 0; i < HEAP_PROFILER_SITE_CAPACITY; i++) {
+			const Site &site = heap_profiler_sites[i];
+			if (site.samples > 0 && heap_profiler_string_equal(site.tag, p_tag)) {
+				bytes += site.live_bytes;
+			}
+		}
+	}
+	heap_profiler_lock.unlock();
+	return bytes;
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -36,6 +36,13 @@
 #include <new> // IWYU pragma: keep // `new` operators.
 #include <type_traits>
 
+// Call site passed by memnew_tagged() to the heap profiler.
+struct MemoryCallSite {
+	const char *tag = nullptr;
+	const char *file = nullptr;
+	int line = 0;
+};
+
 class Memory {
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
@@ -59,6 +66,8 @@ public:
 	_FORCE_INLINE_ static void *alloc_static_zeroed(size_t p_bytes, bool p_pad_align = false) { return alloc_static<true>(p_bytes, p_pad_align); }
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
+	// Same as alloc_static(), but attributes the allocation to p_site if the heap profiler samples it.
+	static void *alloc_static_tagged(size_t p_bytes, const MemoryCallSite &p_site);
 
 	//	                            ↓ return value of alloc_aligned_static
 	//	┌─────────────────┬─────────┬─────────┬──────────────────┐
@@ -92,11 +101,117 @@ public:
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_memory, size_t p_bytes) { return Memory::realloc_static(p_memory, p_bytes, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Thread-local linear (bump) allocator for short-lived temporaries.
+//
+// Allocating is a pointer bump in a per-thread chunk, with no locking and no per-allocation
+// tracking. Freeing individual allocations does nothing; memory is reclaimed all at once instead:
+// - The main thread's arena is reset at the start of every Main::iteration(), so anything
+//   allocated from it on the main thread is only valid until the end of the current frame.
+// - Other threads (worker tasks, physics or rendering threads) must wrap their usage in a
+//   FrameArena::Scope, which rewinds the arena to where it was when the scope was opened.
+//
+// It can be used as the allocator of LocalVector (see FrameLocalVector), List, RBMap and RBSet,
+// or as the element allocator of HashMap (see FrameArenaTypedAllocator and FrameHashMap).
+// Chunks are kept for reuse, so a thread's arena stays at its high-water mark.
+class FrameArena {
+public:
+	struct ThreadStats {
+		uint64_t thread_id = 0;
+		uint64_t used = 0; // Bytes currently handed out.
+		uint64_t high_water = 0; // Peak of used bytes.
+		uint64_t capacity = 0; // Bytes reserved in chunks.
+	};
+
+	// Remembers the arena position on construction and rewinds to it on destruction.
+	// Scopes must be nested (LIFO) and can't be moved across threads.
+	class Scope {
+		void *chunk = nullptr;
+		uint64_t chunk_used = 0;
+		uint64_t used = 0;
+
+	public:
+		Scope();
+		~Scope();
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	_FORCE_INLINE_ static void free(void *p_memory) {}
+
+	// Rewinds the calling thread's arena. Everything allocated from it becomes invalid.
+	static void reset();
+
+	// Fills up to p_max_count entries, one per thread that has used its arena. Returns the number of entries written.
+	static uint32_t get_thread_stats(ThreadStats *r_stats, uint32_t p_max_count);
+	static uint64_t get_max_high_water();
+};
+
+// Sampling heap profiler for everything allocated through Memory.
+//
+// It is off by default and can be started and stopped at runtime. While it runs, each thread
+// samples about one allocation per sample interval (in bytes), and every sample is attributed to
+// the thread's current tag (see TagScope) and, if it was allocated with memnew_tagged(), to its
+// call site. Sampled sizes are scaled by the interval, so the totals are estimates of the real
+// byte counts; an interval of 1 records every allocation exactly.
+// When stopped, allocating and freeing only pay for a relaxed atomic load.
+class HeapProfiler {
+	friend class Memory;
+
+	static std::atomic<bool> enabled;
+	static thread_local const char *thread_tag;
+	static thread_local const MemoryCallSite *thread_site;
+
+	static void _record_alloc(void *p_ptr, size_t p_bytes);
+	static void _record_free(void *p_ptr);
+
+public:
+	static constexpr uint64_t DEFAULT_SAMPLE_INTERVAL = 512 * 1024;
+
+	struct Site {
+		const char *tag = nullptr; // nullptr if untagged.
+		const char *file = nullptr; // nullptr unless allocated with memnew_tagged().
+		int line = 0;
+		uint64_t samples = 0;
+		uint64_t allocated_bytes = 0; // Estimated bytes allocated since the profiler was started.
+		uint64_t live_bytes = 0; // Estimated bytes still allocated (as of stop(), if stopped).
+	};
+
+	// Tags allocations made by the calling thread until it goes out of scope. Scopes can be nested.
+	// Tags are compared by content but stored by pointer, so they must outlive the profile (use string literals).
+	class TagScope {
+		const char *previous = nullptr;
+
+	public:
+		_FORCE_INLINE_ TagScope(const char *p_tag) {
+			previous = thread_tag;
+			thread_tag = p_tag;
+		}
+		_FORCE_INLINE_ ~TagScope() { thread_tag = previous; }
+	};
+
+	_FORCE_INLINE_ static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+	_FORCE_INLINE_ static const char *get_thread_tag() { return thread_tag; }
+
+	// Clears the results of any previous run.
+	static void start(uint64_t p_sample_interval = DEFAULT_SAMPLE_INTERVAL);
+	// Results remain available until the next start(), but frees made after this are not accounted for.
+	static void stop();
+	static uint64_t get_sample_interval();
+
+	// Fills up to p_max_count entries, one per distinct tag and call site. Returns the number of entries written.
+	static uint32_t get_sites(Site *r_sites, uint32_t p_max_count);
+	static uint32_t get_site_count();
+	// Sum of the live bytes of every site with this tag; pass nullptr for untagged allocations.
+	static uint64_t get_tag_live_bytes(const char *p_tag);
+};
+
 void *operator new(size_t p_size, const char *p_description); ///< operator new that takes a description and uses MemoryStaticPool
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)); ///< operator new that takes a description and uses MemoryStaticPool
+void *operator new(size_t p_size, const MemoryCallSite &p_site); ///< operator new that attributes the allocation to a call site for the heap profiler
 
 void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_description); ///< operator new that takes a description and uses a pointer to the preallocated memory
 
@@ -105,6 +220,7 @@ void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_d
 // The purpose of the following definitions is to muffle these warnings, not to provide a usable implementation of placement delete.
 void operator delete(void *p_mem, const char *p_description);
 void operator delete(void *p_mem, void *(*p_allocfunc)(size_t p_size));
+void operator delete(void *p_mem, const MemoryCallSite &p_site);
 void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_description);
 #endif
 
@@ -123,6 +239,9 @@ _ALWAYS_INLINE_ T *_post_initialize(T *p_obj) {
 
 #define memnew(m_class) _post_initialize(::new ("") m_class)
 
+// Like memnew(), but allocations sampled by the HeapProfiler are attributed to m_tag and this file and line.
+#define memnew_tagged(m_tag, m_class) _post_initialize(::new (MemoryCallSite{ m_tag, __FILE__, __LINE__ }) m_class)
+
 #define memnew_allocator(m_class, m_allocator) _post_initialize(::new (m_allocator::alloc) m_class)
 #define memnew_placement(m_placement, m_class) _post_initialize(::new (m_placement) m_class)
 
@@ -257,3 +376,16 @@ public:
 	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew(T(p_args...)); }
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
 };
+
+// Allocates from the calling thread's FrameArena. Deleting only runs the destructor.
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_allocator(T(p_args...), FrameArena); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+	}
+};
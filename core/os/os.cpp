@@ -35,6 +35,7 @@
 #include "core/io/file_access.h"
 #include "core/io/json.h"
 #include "core/os/midi_driver.h"
+#include "core/templates/local_vector.h"
 #include "core/version_generated.gen.h"
 
 #include <cstdarg>
@@ -389,6 +390,31 @@ uint64_t OS::get_static_memory_peak_usage() const {
 	return Memory::get_mem_max_usage();
 }
 
+Error OS::dump_heap_profile(const String &p_path, bool p_live_bytes) const {
+	LocalVector<HeapProfiler::Site> sites;
+	// Sites may be added while copying, leave some room for them.
+	sites.resize(HeapProfiler::get_site_count() + 64);
+	sites.resize(HeapProfiler::get_sites(sites.ptr(), sites.size()));
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't open heap profile file '%s'.", p_path));
+
+	// One line per site: "tag;file:line bytes". Frames can't contain the separators.
+	for (const HeapProfiler::Site &site : sites) {
+		uint64_t bytes = p_live_bytes ? site.live_bytes : site.allocated_bytes;
+		if (bytes == 0) {
+			continue;
+		}
+		String stack = site.tag ? String::utf8(site.tag).replace(";", "_").replace(" ", "_") : String("untagged");
+		if (site.file) {
+			stack += ";" + String::utf8(site.file).replace(";", "_").replace(" ", "_") + ":" + itos(site.line);
+		}
+		f->store_line(stack + " " + itos(bytes));
+	}
+	return OK;
+}
+
 Error OS::set_cwd(const String &p_cwd) {
 	return ERR_CANT_OPEN;
 }
@@ -276,6 +276,8 @@ public:
 
 	virtual uint64_t get_static_memory_usage() const;
 	virtual uint64_t get_static_memory_peak_usage() const;
+	// Writes the HeapProfiler results in the folded stack format used by flame graph tools.
+	Error dump_heap_profile(const String &p_path, bool p_live_bytes = true) const;
 	virtual Dictionary get_memory_info() const;
 
 	bool is_separate_thread_rendering_enabled() const { return _separate_thread_render; }
@@ -327,6 +327,12 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/worker_pool/use_work_stealing", false);
+
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/variant_pools/small_page_size", PROPERTY_HINT_RANGE, "64,65536,1,or_greater"), 4096);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/variant_pools/medium_page_size", PROPERTY_HINT_RANGE, "64,65536,1,or_greater"), 4096);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/variant_pools/large_page_size", PROPERTY_HINT_RANGE, "64,65536,1,or_greater"), 4096);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/variant_pools/thread_cache_size", PROPERTY_HINT_RANGE, "0,1024,1"), 64);
 }
 
 void register_early_core_singletons() {
@@ -32,37 +32,133 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 
 struct StringName::Table {
-	constexpr static uint32_t TABLE_BITS = 16;
-	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
-	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
+	// The table is split into shards, each with its own lock, bucket array and allocator,
+	// so threads interning unrelated names don't contend with each other.
+	constexpr static uint32_t SHARD_BITS = 5;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_INITIAL_BUCKETS = 1024;
+	constexpr static uint32_t SHARD_PAGE_SIZE = 256;
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		BinaryMutex mutex;
+		_Data **buckets = nullptr;
+		uint32_t bucket_mask = 0;
+		uint32_t count = 0;
+		PagedAllocator<_Data, false, SHARD_PAGE_SIZE> allocator;
+	};
+
+	static Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_hash) {
+		// String hashes of short names barely touch the high bits, so scramble before picking a shard.
+		return shards[(p_hash * 0x9E3779B1u) >> (32 - SHARD_BITS)];
+	}
+
+	static void grow(Shard &p_shard) {
+		const uint32_t old_len = p_shard.bucket_mask + 1;
+		const uint32_t new_len = old_len << 1;
+		const uint32_t new_mask = new_len - 1;
+		_Data **new_buckets = (_Data **)memalloc_zeroed(sizeof(_Data *) * new_len);
+
+		for (uint32_t i = 0; i < old_len; i++) {
+			_Data *d = p_shard.buckets[i];
+			while (d) {
+				_Data *next = d->next;
+				const uint32_t idx = d->hash & new_mask;
+				d->prev = nullptr;
+				d->next = new_buckets[idx];
+				if (new_buckets[idx]) {
+					new_buckets[idx]->prev = d;
+				}
+				new_buckets[idx] = d;
+				d = next;
+			}
+		}
+
+		memfree(p_shard.buckets);
+		p_shard.buckets = new_buckets;
+		p_shard.bucket_mask = new_mask;
+	}
+
+	template <typename T>
+	static _Data *intern(const T &p_name, uint32_t p_hash, bool p_static) {
+		Shard &shard = get_shard(p_hash);
+		MutexLock lock(shard.mutex);
+
+		uint32_t idx = p_hash & shard.bucket_mask;
+		for (_Data *d = shard.buckets[idx]; d; d = d->next) {
+			// Compare hash first. An entry whose refcount already dropped to zero is about
+			// to be removed by another thread, so skip it and keep looking.
+			if (d->hash == p_hash && d->name == p_name && d->refcount.ref()) {
+				if (p_static) {
+					d->static_count.increment();
+				}
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					d->debug_references++;
+				}
+#endif
+				return d;
+			}
+		}
+
+		if (shard.count > shard.bucket_mask) {
+			grow(shard);
+			idx = p_hash & shard.bucket_mask;
+		}
+
+		_Data *data = shard.allocator.alloc();
+		data->name = p_name;
+		data->refcount.init();
+		data->static_count.set(p_static ? 1 : 0);
+		data->hash = p_hash;
+		data->next = shard.buckets[idx];
+		data->prev = nullptr;
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			// Keep in memory, force static.
+			data->refcount.ref();
+			data->static_count.increment();
+		}
+#endif
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+		if (shard.buckets[idx]) {
+			shard.buckets[idx]->prev = data;
+		}
+		shard.buckets[idx] = data;
+		shard.count++;
+		return data;
+	}
 };
 
+StringName::Table::Shard StringName::Table::shards[StringName::Table::SHARD_COUNT];
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+	for (Table::Shard &shard : Table::shards) {
+		shard.buckets = (_Data **)memalloc_zeroed(sizeof(_Data *) * Table::SHARD_INITIAL_BUCKETS);
+		shard.bucket_mask = Table::SHARD_INITIAL_BUCKETS - 1;
+		shard.count = 0;
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (Table::Shard &shard : Table::shards) {
+			MutexLock lock(shard.mutex);
+			for (uint32_t i = 0; i <= shard.bucket_mask; i++) {
+				_Data *d = shard.buckets[i];
+				while (d) {
+					data.push_back(d);
+					d = d->next;
+				}
 			}
 		}
 
@@ -85,20 +181,27 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+	for (Table::Shard &shard : Table::shards) {
+		MutexLock lock(shard.mutex);
+		for (uint32_t i = 0; i <= shard.bucket_mask; i++) {
+			while (shard.buckets[i]) {
+				_Data *d = shard.buckets[i];
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+					}
 				}
-			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+				shard.buckets[i] = shard.buckets[i]->next;
+				shard.allocator.free(d);
+			}
 		}
+		memfree(shard.buckets);
+		shard.buckets = nullptr;
+		shard.bucket_mask = 0;
+		shard.count = 0;
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
@@ -110,25 +213,31 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		_remove(_data);
+	}
 
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
-		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
+	_data = nullptr;
+}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+void StringName::_remove(_Data *p_data) {
+	Table::Shard &shard = Table::get_shard(p_data->hash);
+	MutexLock lock(shard.mutex);
+
+	if (CoreGlobals::leak_reporting_enabled && p_data->static_count.get() > 0) {
+		ERR_PRINT("BUG: Unreferenced static string to 0: " + p_data->name);
+	}
+	if (p_data->prev) {
+		p_data->prev->next = p_data->next;
+	} else {
+		const uint32_t idx = p_data->hash & shard.bucket_mask;
+		shard.buckets[idx] = p_data->next;
 	}
 
-	_data = nullptr;
+	if (p_data->next) {
+		p_data->next->prev = p_data->prev;
+	}
+	shard.count--;
+	shard.allocator.free(p_data);
 }
 
 uint32_t StringName::get_empty_hash() {
@@ -210,52 +319,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -267,51 +331,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, p_name.hash(), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
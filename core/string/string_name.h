@@ -57,6 +57,7 @@ class [[nodiscard]] StringName {
 	_Data *_data = nullptr;
 
 	void unref();
+	static void _remove(_Data *p_data);
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
@@ -179,8 +180,9 @@ public:
 	_FORCE_INLINE_
 #endif
 	~StringName() {
-		if (likely(configured) && _data) { //only free if configured
-			unref();
+		// Only free if configured. Dropping a reference that isn't the last one never takes the table lock.
+		if (likely(configured) && _data && unlikely(_data->refcount.unref())) {
+			_remove(_data);
 		}
 	}
 
@@ -0,0 +1,275 @@
+/**************************************************************************/
+/*  string_simd.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Vectorized helpers for the hot loops in ustring.cpp.
+// SSE2 is part of the x86_64 baseline and NEON of the arm64 one, so both are
+// selected at compile time. Other targets use the scalar loops, which are also
+// used to finish the tail of each scan.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace StringSIMD {
+
+// Returns the index of the first `p_char` in `p_str[p_from, p_len)`, or -1.
+_FORCE_INLINE_ int find_char(const char32_t *p_str, int p_from, int p_len, char32_t p_char) {
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i needle = _mm_set1_epi32((int32_t)p_char);
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_str + i)), needle);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_str + i + 4)), needle);
+		if (_mm_movemask_epi8(_mm_or_si128(a, b))) {
+			break;
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t needle = vdupq_n_u32(p_char);
+	for (; i + 8 <= p_len; i += 8) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_str + i)), needle);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_str + i + 4)), needle);
+		if (vmaxvq_u32(vorrq_u32(a, b))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_str[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Returns the index of the first character in `p_str[p_from, p_len)` that is either
+// `p_lower`, `p_upper` or outside the ASCII range, or -1. Both needles must be ASCII.
+// Non-ASCII characters are only candidates for a case-insensitive match, so the
+// caller has to verify them.
+_FORCE_INLINE_ int find_ascii_char_nocase(const char32_t *p_str, int p_from, int p_len, char32_t p_lower, char32_t p_upper) {
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i lower = _mm_set1_epi32((int32_t)p_lower);
+	const __m128i upper = _mm_set1_epi32((int32_t)p_upper);
+	const __m128i non_ascii = _mm_set1_epi32(~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_str + i));
+		const __m128i match = _mm_or_si128(_mm_cmpeq_epi32(v, lower), _mm_cmpeq_epi32(v, upper));
+		const __m128i ascii = _mm_cmpeq_epi32(_mm_and_si128(v, non_ascii), zero);
+		if (_mm_movemask_epi8(match) || _mm_movemask_epi8(ascii) != 0xFFFF) {
+			break;
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t lower = vdupq_n_u32(p_lower);
+	const uint32x4_t upper = vdupq_n_u32(p_upper);
+	const uint32x4_t ascii_max = vdupq_n_u32(0x7F);
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_str + i));
+		const uint32x4_t hit = vorrq_u32(vorrq_u32(vceqq_u32(v, lower), vceqq_u32(v, upper)), vcgtq_u32(v, ascii_max));
+		if (vmaxvq_u32(hit)) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_str[i];
+		if (c == p_lower || c == p_upper || c > 0x7F) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Returns the number of leading ASCII characters in `p_str[0, p_len)`.
+_FORCE_INLINE_ int ascii_run(const char32_t *p_str, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i non_ascii = _mm_set1_epi32(~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i v = _mm_or_si128(_mm_loadu_si128((const __m128i *)(p_str + i)), _mm_loadu_si128((const __m128i *)(p_str + i + 4)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, non_ascii), zero)) != 0xFFFF) {
+			break;
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		const uint32x4_t v = vorrq_u32(vld1q_u32((const uint32_t *)(p_str + i)), vld1q_u32((const uint32_t *)(p_str + i + 4)));
+		if (vmaxvq_u32(v) > 0x7F) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_str[i] > 0x7F) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Copies the leading ASCII characters of `p_src[0, p_len)` to `p_dst` as bytes and
+// returns how many were copied.
+_FORCE_INLINE_ int narrow_ascii(const char32_t *p_src, int p_len, uint8_t *p_dst) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i non_ascii = _mm_set1_epi32(~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(p_src + i + 4));
+		const __m128i c = _mm_loadu_si128((const __m128i *)(p_src + i + 8));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(p_src + i + 12));
+		const __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, non_ascii), zero)) != 0xFFFF) {
+			break;
+		}
+		// All lanes are below 0x80, so the saturating packs are exact.
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		const uint32x4_t a = vld1q_u32((const uint32_t *)(p_src + i));
+		const uint32x4_t b = vld1q_u32((const uint32_t *)(p_src + i + 4));
+		if (vmaxvq_u32(vorrq_u32(a, b)) > 0x7F) {
+			break;
+		}
+		vst1_u8(p_dst + i, vmovn_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b))));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_src[i];
+		if (c > 0x7F) {
+			break;
+		}
+		p_dst[i] = (uint8_t)c;
+	}
+	return i;
+}
+
+// Copies the leading ASCII bytes of `p_src[0, p_len)` to `p_dst` as characters and
+// returns how many were copied. Stops at NUL, at the first non-ASCII byte, and at
+// '\r' if `p_stop_at_cr` is set.
+_FORCE_INLINE_ int widen_ascii(const uint8_t *p_src, int p_len, char32_t *p_dst, bool p_stop_at_cr) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i cr = _mm_set1_epi8(p_stop_at_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		// The sign bit is set for non-ASCII bytes.
+		if (_mm_movemask_epi8(_mm_or_si128(v, _mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, cr))))) {
+			break;
+		}
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint8x16_t cr = vdupq_n_u8(p_stop_at_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		if (vmaxvq_u8(v) > 0x7F || vminvq_u8(v) == 0 || vmaxvq_u8(vceqq_u8(v, cr))) {
+			break;
+		}
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		vst1q_u32((uint32_t *)(p_dst + i), vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 4), vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 8), vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32((uint32_t *)(p_dst + i + 12), vmovl_u16(vget_high_u16(hi)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const uint8_t c = p_src[i];
+		if (c == 0 || c > 0x7F || (p_stop_at_cr && c == '\r')) {
+			break;
+		}
+		p_dst[i] = c;
+	}
+	return i;
+}
+
+// Copies the leading ASCII characters of `p_src[0, p_len)` to `p_dst`, shifting the
+// ones in [`p_first`, `p_last`] by `p_offset`, and returns how many were copied.
+_FORCE_INLINE_ int ascii_shift_range(const char32_t *p_src, int p_len, char32_t *p_dst, char32_t p_first, char32_t p_last, int32_t p_offset) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i non_ascii = _mm_set1_epi32(~0x7F);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i first = _mm_set1_epi32((int32_t)p_first - 1);
+	const __m128i last = _mm_set1_epi32((int32_t)p_last + 1);
+	const __m128i offset = _mm_set1_epi32(p_offset);
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, non_ascii), zero)) != 0xFFFF) {
+			break;
+		}
+		// Signed comparisons are fine once every lane is known to be ASCII.
+		const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, first), _mm_cmplt_epi32(v, last));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_add_epi32(v, _mm_and_si128(in_range, offset)));
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t first = vdupq_n_u32(p_first);
+	const uint32x4_t last = vdupq_n_u32(p_last);
+	const uint32x4_t offset = vdupq_n_u32((uint32_t)p_offset);
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		if (vmaxvq_u32(v) > 0x7F) {
+			break;
+		}
+		const uint32x4_t in_range = vandq_u32(vcgeq_u32(v, first), vcleq_u32(v, last));
+		vst1q_u32((uint32_t *)(p_dst + i), vaddq_u32(v, vandq_u32(in_range, offset)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_src[i];
+		if (c > 0x7F) {
+			break;
+		}
+		p_dst[i] = (c >= p_first && c <= p_last) ? char32_t(c + p_offset) : c;
+	}
+	return i;
+}
+
+} // namespace StringSIMD
@@ -38,6 +38,7 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
+#include "core/string/string_simd.h"
 #include "core/string/translation_server.h"
 #include "core/string/ucaps.h"
 #include "core/variant/variant.h"
@@ -1375,16 +1376,23 @@ String String::to_upper() const {
 		return *this;
 	}
 
+	const int len = length();
 	String upper;
 	upper.resize_uninitialized(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *upper_ptrw = upper.ptrw();
 
-	while (*old_ptr) {
-		*upper_ptrw++ = _find_upper(*old_ptr++);
+	int i = 0;
+	while (i < len) {
+		// Convert ASCII runs in bulk, then fall back to the case tables for the next character.
+		i += StringSIMD::ascii_shift_range(old_ptr + i, len - i, upper_ptrw + i, 'a', 'z', -32);
+		if (i < len) {
+			upper_ptrw[i] = _find_upper(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*upper_ptrw = 0;
+	upper_ptrw[len] = 0;
 
 	return upper;
 }
@@ -1394,16 +1402,23 @@ String String::to_lower() const {
 		return *this;
 	}
 
+	const int len = length();
 	String lower;
 	lower.resize_uninitialized(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *lower_ptrw = lower.ptrw();
 
-	while (*old_ptr) {
-		*lower_ptrw++ = _find_lower(*old_ptr++);
+	int i = 0;
+	while (i < len) {
+		// Convert ASCII runs in bulk, then fall back to the case tables for the next character.
+		i += StringSIMD::ascii_shift_range(old_ptr + i, len - i, lower_ptrw + i, 'A', 'Z', 32);
+		if (i < len) {
+			lower_ptrw[i] = _find_lower(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*lower_ptrw = 0;
+	lower_ptrw[len] = 0;
 
 	return lower;
 }
@@ -1781,6 +1796,14 @@ Error String::append_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	const uint8_t *ptr_limit = (uint8_t *)p_utf8 + p_len;
 
 	while (ptrtmp < ptr_limit && *ptrtmp) {
+		// Copy runs of plain ASCII in bulk.
+		const int ascii_len = StringSIMD::widen_ascii(ptrtmp, ptr_limit - ptrtmp, dst, p_skip_cr);
+		ptrtmp += ascii_len;
+		dst += ascii_len;
+		if (ptrtmp >= ptr_limit || !*ptrtmp) {
+			break;
+		}
+
 		uint8_t c = *ptrtmp;
 
 		if (p_skip_cr && c == '\r') {
@@ -1941,7 +1964,14 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 		uint32_t c = d[i];
 		int ch_w = 1;
 		if (c <= 0x7f) { // 7 bits.
-			ch_w = 1;
+			// Count the whole ASCII run at once.
+			const int run = StringSIMD::ascii_run(d + i, l - i);
+			fl += run;
+			if (map_ptr) {
+				memset(map_ptr + i, 1, run);
+			}
+			i += run - 1;
+			continue;
 		} else if (c <= 0x7ff) { // 11 bits
 			ch_w = 2;
 		} else if (c <= 0xffff) { // 16 bits
@@ -1978,7 +2008,9 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
-			APPEND_CHAR(c);
+			const int run = StringSIMD::narrow_ascii(d + i, l - i, cdst);
+			cdst += run;
+			i += run - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			APPEND_CHAR(uint32_t(0xc0 | ((c >> 6) & 0x1f))); // Top 5 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
@@ -3059,24 +3091,15 @@ int String::find(const String &p_str, int p_from) const {
 
 	const char32_t *src = get_data();
 	const char32_t *str = p_str.get_data();
+	const int last = len - src_len;
 
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
+	for (int i = p_from; i <= last; i++) {
+		// Skip ahead to the next occurrence of the first character.
+		i = StringSIMD::find_char(src, i, last + 1, str[0]);
+		if (i < 0) {
+			return -1;
 		}
-
-		if (found) {
+		if (memcmp(src + i + 1, str + 1, (src_len - 1) * sizeof(char32_t)) == 0) {
 			return i;
 		}
 	}
@@ -3102,36 +3125,25 @@ int String::find(const char *p_str, int p_from) const {
 	}
 
 	const char32_t *src = get_data();
+	const int last = len - src_len;
 
-	if (src_len == 1) {
-		const char32_t needle = p_str[0];
-
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
+	for (int i = p_from; i <= last; i++) {
+		// Skip ahead to the next occurrence of the first character.
+		i = StringSIMD::find_char(src, i, last + 1, (char32_t)p_str[0]);
+		if (i < 0) {
+			return -1;
 		}
 
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				}
-
-				if (src[read_pos] != (char32_t)p_str[j]) {
-					found = false;
-					break;
-				}
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
+			if (src[i + j] != (char32_t)p_str[j]) {
+				found = false;
+				break;
 			}
+		}
 
-			if (found) {
-				return i;
-			}
+		if (found) {
+			return i;
 		}
 	}
 
@@ -3145,7 +3157,7 @@ int String::find_char(char32_t p_char, int p_from) const {
 	if (p_from < 0 || p_from >= length()) {
 		return -1;
 	}
-	return span().find(p_char, p_from);
+	return StringSIMD::find_char(ptr(), p_from, length(), p_char);
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -3208,25 +3220,32 @@ int String::findn(const String &p_str, int p_from) const {
 		return -1;
 	}
 
-	int src_len = p_str.length();
+	const int src_len = p_str.length();
+	const int len = length();
 
-	if (src_len == 0 || length() == 0) {
+	if (src_len == 0 || len == 0) {
 		return -1; // won't find anything!
 	}
 
 	const char32_t *srcd = get_data();
+	const int last = len - src_len;
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
+	// When the first character is ASCII, skip ahead to positions that can match it.
+	const char32_t first = _find_lower(p_str[0]);
+	const bool ascii_first = first <= 0x7F;
+	const char32_t first_upper = _find_upper(first);
 
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
+	for (int i = p_from; i <= last; i++) {
+		if (ascii_first) {
+			i = StringSIMD::find_ascii_char_nocase(srcd, i, last + 1, first, first_upper);
+			if (i < 0) {
 				return -1;
 			}
+		}
 
-			char32_t src = _find_lower(srcd[read_pos]);
+		bool found = true;
+		for (int j = 0; j < src_len; j++) {
+			char32_t src = _find_lower(srcd[i + j]);
 			char32_t dst = _find_lower(p_str[j]);
 
 			if (src != dst) {
@@ -3248,25 +3267,32 @@ int String::findn(const char *p_str, int p_from) const {
 		return -1;
 	}
 
-	int src_len = strlen(p_str);
+	const int src_len = strlen(p_str);
+	const int len = length();
 
-	if (src_len == 0 || length() == 0) {
+	if (src_len == 0 || len == 0) {
 		return -1; // won't find anything!
 	}
 
 	const char32_t *srcd = get_data();
+	const int last = len - src_len;
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
+	// When the first character is ASCII, skip ahead to positions that can match it.
+	const char32_t first = _find_lower(p_str[0]);
+	const bool ascii_first = first <= 0x7F;
+	const char32_t first_upper = _find_upper(first);
 
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
+	for (int i = p_from; i <= last; i++) {
+		if (ascii_first) {
+			i = StringSIMD::find_ascii_char_nocase(srcd, i, last + 1, first, first_upper);
+			if (i < 0) {
 				return -1;
 			}
+		}
 
-			char32_t src = _find_lower(srcd[read_pos]);
+		bool found = true;
+		for (int j = 0; j < src_len; j++) {
+			char32_t src = _find_lower(srcd[i + j]);
 			char32_t dst = _find_lower(p_str[j]);
 
 			if (src != dst) {
@@ -646,3 +646,10 @@ public:
 		}
 	}
 };
+
+// Elements are allocated from the calling thread's FrameArena, see its lifetime rules in memory.h.
+// The bucket arrays still come from the regular allocator, since they only change when the map grows.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>>;
@@ -44,13 +44,39 @@ class PagedAllocator {
 	T **page_pool = nullptr;
 	T ***available_pool = nullptr;
 	uint32_t pages_allocated = 0;
+	uint32_t available_pages = 0;
 	uint32_t allocs_available = 0;
+	uint32_t allocs_total = 0;
 
+	// The free list is split in chunks of (1 << page_shift) entries. The chunk size is fixed
+	// once pages exist, but page_size may be changed later and then only applies to new pages.
 	uint32_t page_shift = 0;
 	uint32_t page_mask = 0;
 	uint32_t page_size = 0;
 	SpinLock spin_lock;
 
+	void _add_page() {
+		page_pool = (T **)memrealloc(page_pool, sizeof(T *) * (pages_allocated + 1));
+		T *page = (T *)memalloc(sizeof(T) * page_size);
+		page_pool[pages_allocated] = page;
+		pages_allocated++;
+
+		allocs_total += page_size;
+		uint32_t available_needed = (allocs_total + page_mask) >> page_shift;
+		if (available_needed > available_pages) {
+			available_pool = (T ***)memrealloc(available_pool, sizeof(T **) * available_needed);
+			for (uint32_t i = available_pages; i < available_needed; i++) {
+				available_pool[i] = (T **)memalloc(sizeof(T *) << page_shift);
+			}
+			available_pages = available_needed;
+		}
+
+		for (uint32_t i = 0; i < page_size; i++) {
+			available_pool[allocs_available >> page_shift][allocs_available & page_mask] = &page[i];
+			allocs_available++;
+		}
+	}
+
 public:
 	template <typename... Args>
 	T *alloc(Args &&...p_args) {
@@ -58,19 +84,7 @@ public:
 			spin_lock.lock();
 		}
 		if (unlikely(allocs_available == 0)) {
-			uint32_t pages_used = pages_allocated;
-
-			pages_allocated++;
-			page_pool = (T **)memrealloc(page_pool, sizeof(T *) * pages_allocated);
-			available_pool = (T ***)memrealloc(available_pool, sizeof(T **) * pages_allocated);
-
-			page_pool[pages_used] = (T *)memalloc(sizeof(T) * page_size);
-			available_pool[pages_used] = (T **)memalloc(sizeof(T *) * page_size);
-
-			for (uint32_t i = 0; i < page_size; i++) {
-				available_pool[0][i] = &page_pool[pages_used][i];
-			}
-			allocs_available += page_size;
+			_add_page();
 		}
 
 		allocs_available--;
@@ -94,18 +108,64 @@ public:
 		}
 	}
 
+	// Raw variants of alloc() and free() which move several elements at once under a single lock,
+	// for callers keeping their own free lists in front of the allocator. Elements are neither
+	// constructed nor destroyed.
+	void alloc_raw_batch(T **r_mem, uint32_t p_count) {
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		while (allocs_available < p_count) {
+			_add_page();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			allocs_available--;
+			r_mem[i] = available_pool[allocs_available >> page_shift][allocs_available & page_mask];
+		}
+		if constexpr (thread_safe) {
+			spin_lock.unlock();
+		}
+	}
+
+	void free_raw_batch(T *const *p_mem, uint32_t p_count) {
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			available_pool[allocs_available >> page_shift][allocs_available & page_mask] = p_mem[i];
+			allocs_available++;
+		}
+		if constexpr (thread_safe) {
+			spin_lock.unlock();
+		}
+	}
+
 	template <typename... Args>
 	T *new_allocation(Args &&...p_args) { return alloc(p_args...); }
 	void delete_allocation(T *p_mem) { free(p_mem); }
 
+	// Number of elements the allocated pages can hold.
+	uint32_t get_capacity() const {
+		if constexpr (thread_safe) {
+			spin_lock.lock();
+		}
+		uint32_t result = allocs_total;
+		if constexpr (thread_safe) {
+			spin_lock.unlock();
+		}
+		return result;
+	}
+
 private:
 	void _reset(bool p_allow_unfreed) {
 		if (!p_allow_unfreed || !std::is_trivially_destructible_v<T>) {
-			ERR_FAIL_COND(allocs_available < pages_allocated * page_size);
+			ERR_FAIL_COND(allocs_available < allocs_total);
 		}
 		if (pages_allocated) {
 			for (uint32_t i = 0; i < pages_allocated; i++) {
 				memfree(page_pool[i]);
+			}
+			for (uint32_t i = 0; i < available_pages; i++) {
 				memfree(available_pool[i]);
 			}
 			memfree(page_pool);
@@ -113,7 +173,9 @@ private:
 			page_pool = nullptr;
 			available_pool = nullptr;
 			pages_allocated = 0;
+			available_pages = 0;
 			allocs_available = 0;
+			allocs_total = 0;
 		}
 	}
 
@@ -143,11 +205,17 @@ public:
 		if constexpr (thread_safe) {
 			spin_lock.lock();
 		}
-		ERR_FAIL_COND(page_pool != nullptr); // Safety check.
-		ERR_FAIL_COND(p_page_size == 0);
+		if (p_page_size == 0) {
+			if constexpr (thread_safe) {
+				spin_lock.unlock();
+			}
+			ERR_FAIL_MSG("Page size can't be zero.");
+		}
 		page_size = nearest_power_of_2_templated(p_page_size);
-		page_mask = page_size - 1;
-		page_shift = get_shift_from_power_of_2(page_size);
+		if (page_pool == nullptr) {
+			page_mask = page_size - 1;
+			page_shift = get_shift_from_power_of_2(page_size);
+		}
 		if constexpr (thread_safe) {
 			spin_lock.unlock();
 		}
@@ -163,7 +231,7 @@ public:
 		if constexpr (thread_safe) {
 			spin_lock.lock();
 		}
-		bool leaked = allocs_available < pages_allocated * page_size;
+		bool leaked = allocs_available < allocs_total;
 		if (leaked) {
 			if (CoreGlobals::leak_reporting_enabled) {
 				ERR_PRINT(String("Pages in use exist at exit in PagedAllocator: ") + String(typeid(T).name()));
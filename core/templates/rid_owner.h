@@ -98,8 +98,14 @@ public:
 	virtual ~RID_AllocBase() {}
 };
 
+template <typename T, bool THREAD_SAFE>
+class RID_PtrOwner;
+
 template <typename T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
+	template <typename, bool>
+	friend class RID_PtrOwner;
+
 	struct Chunk {
 		T data;
 		uint32_t validator;
@@ -152,8 +158,9 @@ class RID_Alloc : public RID_AllocBase {
 			}
 
 			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
+				// Store atomically to avoid data race with the lock-free loads in _get_max_alloc().
+				// Release, so lookups that see the new bound also see the new chunk.
+				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_release);
 			} else {
 				max_alloc += elements_in_chunk;
 			}
@@ -181,6 +188,53 @@ class RID_Alloc : public RID_AllocBase {
 		return _make_from_id(id);
 	}
 
+	_FORCE_INLINE_ uint32_t _get_max_alloc() const {
+		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
+			return ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	// Lookups don't lock, even in thread-safe mode. Chunks are never moved nor freed while the
+	// allocator lives, so the validator alone tells whether the RID still refers to the element.
+	template <typename F>
+	_FORCE_INLINE_ uint32_t _get_or_null_batch(const RID *p_rids, uint32_t p_count, F p_store) const {
+		if constexpr (THREAD_SAFE) {
+			SYNC_ACQUIRE;
+		}
+
+		const uint32_t ma = _get_max_alloc();
+		uint32_t found = 0;
+		for (uint32_t i = 0; i < p_count; i++) {
+			uint64_t id = p_rids[i].get_id();
+			uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+			if (unlikely(idx >= ma || id == 0)) {
+				p_store(i, nullptr);
+				continue;
+			}
+
+			Chunk &c = chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+#ifdef TSAN_ENABLED
+			__tsan_acquire(&c.validator); // We know not a race in practice.
+#endif
+			uint32_t validator = uint32_t(id >> 32);
+			if (unlikely(c.validator != validator)) {
+				if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+					ERR_PRINT("Attempting to use an uninitialized RID");
+				}
+				p_store(i, nullptr);
+			} else {
+				p_store(i, &c.data);
+				found++;
+			}
+#ifdef TSAN_ENABLED
+			__tsan_release(&c.validator);
+#endif
+		}
+		return found;
+	}
+
 public:
 	RID make_rid() {
 		RID rid = _allocate_rid();
@@ -209,13 +263,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _get_max_alloc())) {
 			return nullptr;
 		}
 
@@ -309,17 +357,20 @@ public:
 		}
 	}
 
+	// Resolves several RIDs in one pass, as get_or_null() would. Invalid ones resolve to nullptr.
+	// Returns how many were valid.
+	uint32_t get_or_null_batch(const RID *p_rids, uint32_t p_count, T **r_ptrs) {
+		return _get_or_null_batch(p_rids, p_count, [r_ptrs](uint32_t p_index, T *p_ptr) { r_ptrs[p_index] = p_ptr; });
+	}
+
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
+			SYNC_ACQUIRE;
 		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _get_max_alloc())) {
 			return false;
 		}
 
@@ -328,11 +379,13 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
+#ifdef TSAN_ENABLED
+		__tsan_acquire(&chunks[idx_chunk][idx_element].validator); // We know not a race in practice.
+#endif
 		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
+#ifdef TSAN_ENABLED
+		__tsan_release(&chunks[idx_chunk][idx_element].validator);
+#endif
 
 		return owned;
 	}
@@ -489,6 +542,10 @@ public:
 		return *ptr;
 	}
 
+	uint32_t get_or_null_batch(const RID *p_rids, uint32_t p_count, T **r_ptrs) {
+		return alloc._get_or_null_batch(p_rids, p_count, [r_ptrs](uint32_t p_index, T **p_ptr) { r_ptrs[p_index] = p_ptr ? *p_ptr : nullptr; });
+	}
+
 	_FORCE_INLINE_ void replace(const RID &p_rid, T *p_new_ptr) {
 		T **ptr = alloc.get_or_null(p_rid);
 		ERR_FAIL_NULL(ptr);
@@ -551,6 +608,10 @@ public:
 		return alloc.get_or_null(p_rid);
 	}
 
+	uint32_t get_or_null_batch(const RID *p_rids, uint32_t p_count, T **r_ptrs) {
+		return alloc.get_or_null_batch(p_rids, p_count, r_ptrs);
+	}
+
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
 		return alloc.owns(p_rid);
 	}
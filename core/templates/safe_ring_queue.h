@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  safe_ring_queue.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded, lock-free, multiple-producer/multiple-consumer FIFO queue.
+// Based on Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence
+// number that tells producers and consumers whether the cell is ready for them,
+// so a push or a pop costs a single CAS on the uncontended path.
+//
+// Design goals for this class:
+// - No blocking synchronization primitives will be used.
+// - No allocations. The capacity is fixed at compile time and, when the queue
+//   is full, push() fails so the caller can fall back to some other storage.
+// - Meant for trivially copyable payloads (pointers, IDs).
+
+template <typename T, uint32_t CAPACITY>
+class SafeRingQueue {
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SafeRingQueue capacity must be a power of two.");
+	static_assert(std::is_trivially_copyable_v<T>);
+	static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+	static constexpr uint32_t MASK = CAPACITY - 1;
+
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		T data;
+	};
+
+	// Producers and consumers touch different counters, so keep them in separate
+	// cache lines. Padding is used instead of align attributes because instances
+	// may be heap allocated with a smaller alignment than a cache line.
+	union {
+		std::atomic<uint32_t> enqueue_pos;
+		char enqueue_pos_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	union {
+		std::atomic<uint32_t> dequeue_pos;
+		char dequeue_pos_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	Cell cells[CAPACITY];
+
+public:
+	// Returns false if the queue is full.
+	bool push(const T &p_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - pos);
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = p_value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Returns false if the queue is empty.
+	bool pop(T &r_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - (pos + 1));
+			if (diff == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		r_value = cell->data;
+		cell->sequence.store(pos + MASK + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Only a hint when other threads are pushing or popping concurrently.
+	_FORCE_INLINE_ bool is_empty() const {
+		return enqueue_pos.load(std::memory_order_acquire) == dequeue_pos.load(std::memory_order_acquire);
+	}
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return CAPACITY; }
+
+	SafeRingQueue() :
+			enqueue_pos(0),
+			dequeue_pos(0) {
+		for (uint32_t i = 0; i < CAPACITY; i++) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	SafeRingQueue(const SafeRingQueue &) = delete;
+	SafeRingQueue &operator=(const SafeRingQueue &) = delete;
+};
@@ -0,0 +1,755 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/span.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Marks `TLookup` as usable to look up keys of type `TKey` without converting it first.
+// Both types must produce the same hash with `HashMapHasherDefault` and compare with `==`.
+template <typename TKey, typename TLookup>
+struct HashMapHeterogeneousKey : std::false_type {};
+
+template <>
+struct HashMapHeterogeneousKey<StringName, String> : std::true_type {};
+template <>
+struct HashMapHeterogeneousKey<String, StringName> : std::true_type {};
+
+// A group of control bytes, matched all at once. A control byte is either EMPTY,
+// DELETED, or the low 7 bits of the hash of the key stored in that slot.
+struct SwissHashMapGroup {
+	static constexpr uint32_t WIDTH = 16;
+	static constexpr uint8_t EMPTY = 0x80;
+	static constexpr uint8_t DELETED = 0xFE;
+
+#if defined(SWISS_HASH_MAP_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128((const __m128i *)p_ctrl);
+	}
+	_FORCE_INLINE_ uint32_t match(uint8_t p_h2) const {
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2)));
+	}
+	_FORCE_INLINE_ uint32_t match_empty() const {
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)EMPTY)));
+	}
+	_FORCE_INLINE_ uint32_t match_empty_or_deleted() const {
+		// Only EMPTY and DELETED have the high bit set.
+		return _mm_movemask_epi8(ctrl);
+	}
+#elif defined(SWISS_HASH_MAP_NEON)
+	uint8x16_t ctrl;
+
+	static _FORCE_INLINE_ uint32_t _to_mask(uint8x16_t p_cmp) {
+		static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t masked = vandq_u8(p_cmp, vld1q_u8(bits));
+		return uint32_t(vaddv_u8(vget_low_u8(masked))) | (uint32_t(vaddv_u8(vget_high_u8(masked))) << 8);
+	}
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = vld1q_u8(p_ctrl);
+	}
+	_FORCE_INLINE_ uint32_t match(uint8_t p_h2) const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(p_h2)));
+	}
+	_FORCE_INLINE_ uint32_t match_empty() const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(EMPTY)));
+	}
+	_FORCE_INLINE_ uint32_t match_empty_or_deleted() const {
+		return _to_mask(vtstq_u8(ctrl, vdupq_n_u8(0x80)));
+	}
+#else
+	const uint8_t *ctrl = nullptr;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+	_FORCE_INLINE_ uint32_t match(uint8_t p_h2) const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+	_FORCE_INLINE_ uint32_t match_empty() const {
+		return match(EMPTY);
+	}
+	_FORCE_INLINE_ uint32_t match_empty_or_deleted() const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] >> 7) << i;
+		}
+		return mask;
+	}
+#endif
+
+	// The mask must not be zero.
+	static _FORCE_INLINE_ uint32_t lowest_bit_index(uint32_t p_mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		return __builtin_ctz(p_mask);
+#endif
+	}
+
+	// The mask must not be zero.
+	static _FORCE_INLINE_ uint32_t highest_bit_index(uint32_t p_mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanReverse(&index, p_mask);
+		return index;
+#else
+		return 31 - __builtin_clz(p_mask);
+#endif
+	}
+};
+
+/**
+ * An open-addressing hash map that probes groups of 16 slots at once, in the style of
+ * Abseil's SwissTable. Each slot has a one-byte control value holding 7 bits of the key's
+ * hash, so a probe compares a whole group with a single SIMD instruction and only touches
+ * the keys whose control byte matched.
+ *
+ * Like AHashMap, elements are stored densely in insertion order and can be accessed by
+ * index. When an element is erased, its place is taken by the element from the end.
+ *
+ * Use it for large maps that are looked up much more often than they are iterated, where
+ * the one-slot-at-a-time probing of HashMap and AHashMap dominates. Maps with `StringName`
+ * keys can be looked up with a `String` (and vice versa) without building a temporary key.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two, and at least one group wide.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+	static_assert(INITIAL_CAPACITY >= SwissHashMapGroup::WIDTH);
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	typedef SwissHashMapGroup Group;
+
+	template <typename K>
+	static constexpr bool _is_lookup_key = std::is_same_v<Hasher, HashMapHasherDefault> && HashMapHeterogeneousKey<TKey, K>::value;
+
+	MapKeyValue *elements = nullptr;
+	uint32_t *element_hashes = nullptr;
+	// `capacity` control bytes, followed by a copy of the first group so that a group can be
+	// loaded at any slot without wrapping around.
+	uint8_t *ctrl = nullptr;
+	// Index in `elements` of the key stored in each slot.
+	uint32_t *slots = nullptr;
+
+	// Number of slots, always a power of two.
+	uint32_t capacity = INITIAL_CAPACITY;
+	uint32_t num_elements = 0;
+	// Number of EMPTY slots that can still be filled before growing.
+	uint32_t growth_left = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_growth_limit(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8; // Max load factor of 7/8.
+	}
+
+	template <typename K>
+	_FORCE_INLINE_ uint32_t _hash(const K &p_key) const {
+		// Hashers are free to leave the low bits poorly distributed, but they are used for the control bytes.
+		return hash_fmix32(Hasher::hash(p_key));
+	}
+
+	template <typename K>
+	static _FORCE_INLINE_ bool _compare(const TKey &p_key, const K &p_other) {
+		if constexpr (std::is_same_v<K, TKey>) {
+			return Comparator::compare(p_key, p_other);
+		} else {
+			return p_key == p_other;
+		}
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_slot, uint8_t p_value) {
+		ctrl[p_slot] = p_value;
+		if (p_slot < Group::WIDTH) {
+			ctrl[capacity + p_slot] = p_value;
+		}
+	}
+
+	template <typename K>
+	bool _lookup_slot(const K &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(elements == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint8_t h2 = p_hash & 0x7F;
+		uint32_t pos = (p_hash >> 7) & mask;
+		uint32_t step = 0;
+		while (true) {
+			const Group group(ctrl + pos);
+			for (uint32_t match = group.match(h2); match; match &= match - 1) {
+				const uint32_t slot = (pos + Group::lowest_bit_index(match)) & mask;
+				const uint32_t index = slots[slot];
+				if (element_hashes[index] == p_hash && _compare(elements[index].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			// Triangular probing visits every group once the table size is a power of two.
+			step += Group::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_insert_slot(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (p_hash >> 7) & mask;
+		uint32_t step = 0;
+		while (true) {
+			const uint32_t match = Group(ctrl + pos).match_empty_or_deleted();
+			if (match) {
+				return (pos + Group::lowest_bit_index(match)) & mask;
+			}
+			step += Group::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_element_slot(uint32_t p_index) const {
+		const uint32_t mask = capacity - 1;
+		const uint32_t hash = element_hashes[p_index];
+		uint32_t pos = (hash >> 7) & mask;
+		uint32_t step = 0;
+		while (true) {
+			for (uint32_t match = Group(ctrl + pos).match(hash & 0x7F); match; match &= match - 1) {
+				const uint32_t slot = (pos + Group::lowest_bit_index(match)) & mask;
+				if (slots[slot] == p_index) {
+					return slot;
+				}
+			}
+			step += Group::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _allocate_slots(uint32_t p_capacity) {
+		capacity = p_capacity;
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity + Group::WIDTH));
+		memset(ctrl, Group::EMPTY, capacity + Group::WIDTH);
+		slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(elements, sizeof(MapKeyValue) * _get_growth_limit(capacity)));
+		element_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(element_hashes, sizeof(uint32_t) * _get_growth_limit(capacity)));
+		growth_left = _get_growth_limit(capacity) - num_elements;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		Memory::free_static(ctrl);
+		Memory::free_static(slots);
+		_allocate_slots(p_new_capacity);
+
+		// Elements don't move, only the slots pointing to them are rebuilt. This also drops all DELETED slots.
+		for (uint32_t i = 0; i < num_elements; i++) {
+			const uint32_t slot = _find_insert_slot(element_hashes[i]);
+			_set_ctrl(slot, element_hashes[i] & 0x7F);
+			slots[slot] = i;
+		}
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_slots(capacity);
+		}
+
+		uint32_t slot = _find_insert_slot(p_hash);
+		if (unlikely(growth_left == 0 && ctrl[slot] == Group::EMPTY)) {
+			// Out of room. If most of the used slots are DELETED, rehashing in place is enough.
+			const bool grow = num_elements >= _get_growth_limit(capacity) / 2;
+			_resize_and_rehash(grow ? capacity * 2 : capacity);
+			slot = _find_insert_slot(p_hash);
+		}
+
+		if (ctrl[slot] == Group::EMPTY) {
+			growth_left--;
+		}
+		_set_ctrl(slot, p_hash & 0x7F);
+		slots[slot] = num_elements;
+		element_hashes[num_elements] = p_hash;
+		memnew_placement(&elements[num_elements], MapKeyValue(p_key, p_value));
+		return num_elements++;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		const uint32_t mask = capacity - 1;
+		const uint32_t index = slots[p_slot];
+
+		// If the slot never was part of a run of WIDTH full slots, no probe sequence could have
+		// skipped past it, so it can become EMPTY again instead of leaving a DELETED marker.
+		const uint32_t empty_before = Group(ctrl + ((p_slot - Group::WIDTH) & mask)).match_empty();
+		const uint32_t empty_after = Group(ctrl + p_slot).match_empty();
+		if (empty_before && empty_after && (Group::WIDTH - 1 - Group::highest_bit_index(empty_before)) + Group::lowest_bit_index(empty_after) < Group::WIDTH) {
+			_set_ctrl(p_slot, Group::EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(p_slot, Group::DELETED);
+		}
+
+		elements[index].key.~TKey();
+		elements[index].value.~TValue();
+		num_elements--;
+
+		if (index < num_elements) {
+			// Move the last element into the gap and point its slot to the new index.
+			slots[_find_element_slot(num_elements)] = index;
+			void *destination = &elements[index];
+			const void *source = &elements[num_elements];
+			memcpy(destination, source, sizeof(MapKeyValue));
+			element_hashes[index] = element_hashes[num_elements];
+		}
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		growth_left = p_other.growth_left;
+
+		if (p_other.elements == nullptr) {
+			return;
+		}
+
+		const uint32_t growth_limit = _get_growth_limit(capacity);
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity + Group::WIDTH));
+		slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * growth_limit));
+		element_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * growth_limit));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = elements;
+			const void *source = p_other.elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * num_elements);
+		} else {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				memnew_placement(&elements[i], MapKeyValue(p_other.elements[i]));
+			}
+		}
+
+		memcpy(ctrl, p_other.ctrl, capacity + Group::WIDTH);
+		memcpy(slots, p_other.slots, sizeof(uint32_t) * capacity);
+		memcpy(element_hashes, p_other.element_hashes, sizeof(uint32_t) * num_elements);
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (elements == nullptr || num_elements == 0) {
+			return;
+		}
+
+		memset(ctrl, Group::EMPTY, capacity + Group::WIDTH);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				elements[i].key.~TKey();
+				elements[i].value.~TValue();
+			}
+		}
+
+		num_elements = 0;
+		growth_left = _get_growth_limit(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, _hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[slots[slot]].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, _hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[slots[slot]].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t slot = 0;
+		return _lookup_slot(p_key, _hash(p_key), slot);
+	}
+
+	// Heterogeneous lookups, see HashMapHeterogeneousKey.
+
+	template <typename K, std::enable_if_t<_is_lookup_key<K>, int> = 0>
+	const TValue *getptr(const K &p_key) const {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	template <typename K, std::enable_if_t<_is_lookup_key<K>, int> = 0>
+	TValue *getptr(const K &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, _hash(p_key), slot)) {
+			return &elements[slots[slot]].value;
+		}
+		return nullptr;
+	}
+
+	template <typename K, std::enable_if_t<_is_lookup_key<K>, int> = 0>
+	bool has(const K &p_key) const {
+		uint32_t slot = 0;
+		return _lookup_slot(p_key, _hash(p_key), slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		ERR_FAIL_COND_MSG(p_new_capacity < size(), "reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+		uint32_t new_capacity = MAX(INITIAL_CAPACITY, next_power_of_2(p_new_capacity));
+		while (_get_growth_limit(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (elements == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		if (new_capacity <= capacity) {
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_end) {
+			pair = p_key;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_end) {
+			pair = p_key;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(elements + num_elements, elements + num_elements);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return end();
+		}
+		return Iterator(elements + slots[slot], elements + num_elements);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(elements + num_elements, elements + num_elements);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return end();
+		}
+		return ConstIterator(elements + slots[slot], elements + num_elements);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, _hash(p_key), slot);
+		CRASH_COND(!exists);
+		return elements[slots[slot]].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t slot = 0;
+		const uint32_t hash = _hash(p_key);
+		if (_lookup_slot(p_key, hash, slot)) {
+			return elements[slots[slot]].value;
+		}
+		return elements[_insert_element(p_key, TValue(), hash)].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t slot = 0;
+		const uint32_t hash = _hash(p_key);
+		uint32_t index;
+		if (_lookup_slot(p_key, hash, slot)) {
+			index = slots[slot];
+			elements[index].value = p_value;
+		} else {
+			index = _insert_element(p_key, p_value, hash);
+		}
+		return Iterator(elements + index, elements + num_elements);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		const uint32_t index = _insert_element(p_key, p_value, _hash(p_key));
+		return Iterator(elements + index, elements + num_elements);
+	}
+
+	// Inserts all pairs in order, as if calling insert() on each of them. New keys are appended
+	// in the order given and repeated keys keep the last value, so the result doesn't depend on
+	// how the batch is split. Space is reserved once up front and hashes are computed ahead of
+	// the probes that use them.
+	void insert_batch(Span<MapKeyValue> p_pairs) {
+		if (p_pairs.is_empty()) {
+			return;
+		}
+		if (size() + p_pairs.size() > _get_growth_limit(capacity)) {
+			reserve(size() + p_pairs.size());
+		}
+
+		constexpr uint32_t CHUNK_SIZE = 32;
+		uint32_t hashes[CHUNK_SIZE];
+		for (uint64_t from = 0; from < p_pairs.size(); from += CHUNK_SIZE) {
+			const uint32_t count = MIN(uint64_t(CHUNK_SIZE), p_pairs.size() - from);
+			for (uint32_t i = 0; i < count; i++) {
+				hashes[i] = _hash(p_pairs[from + i].key);
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				const MapKeyValue &pair = p_pairs[from + i];
+				uint32_t slot = 0;
+				if (_lookup_slot(pair.key, hashes[i], slot)) {
+					elements[slots[slot]].value = pair.value;
+				} else {
+					_insert_element(pair.key, pair.value, hashes[i]);
+				}
+			}
+		}
+	}
+
+	/* Array methods. */
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, _hash(p_key), slot)) {
+			return -1;
+		}
+		return slots[slot];
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, num_elements);
+		return elements[p_index];
+	}
+
+	const KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, num_elements);
+		return elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		_erase_slot(_find_element_slot(p_index));
+		return true;
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < num_elements; i++) {
+					elements[i].key.~TKey();
+					elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(elements);
+			Memory::free_static(element_hashes);
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			elements = nullptr;
+			element_hashes = nullptr;
+			ctrl = nullptr;
+			slots = nullptr;
+		}
+		capacity = INITIAL_CAPACITY;
+		num_elements = 0;
+		growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
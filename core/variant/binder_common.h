@@ -81,6 +81,31 @@ struct VariantCaster<const T &> {
 	}
 };
 
+// Argument for a `Span<T>` parameter. A packed array of the matching type is viewed in
+// place, without copying or referencing it. Anything else is converted into `storage`,
+// which lives until the bound method returns.
+template <typename T>
+struct VariantSpanArg {
+	Vector<T> storage;
+	Span<T> view;
+
+	_FORCE_INLINE_ operator Span<T>() const { return view; }
+};
+
+template <typename T>
+struct VariantCaster<Span<T>> {
+	static _FORCE_INLINE_ VariantSpanArg<T> cast(const Variant &p_variant) {
+		VariantSpanArg<T> arg;
+		if (p_variant.get_type() == GetTypeInfo<Span<T>>::VARIANT_TYPE) {
+			arg.view = VariantInternalAccessor<Vector<T>>::get(&p_variant).span();
+		} else {
+			arg.storage = p_variant;
+			arg.view = arg.storage.span();
+		}
+		return arg;
+	}
+};
+
 #define VARIANT_ENUM_CAST(m_enum) MAKE_ENUM_TYPE_INFO(m_enum)
 #define VARIANT_BITFIELD_CAST(m_enum) MAKE_BITFIELD_TYPE_INFO(m_enum)
 
@@ -213,6 +238,20 @@ struct VariantCasterAndValidate<const T &> {
 	}
 };
 
+template <typename T>
+struct VariantCasterAndValidate<Span<T>> {
+	static _FORCE_INLINE_ VariantSpanArg<T> cast(const Variant **p_args, uint32_t p_arg_idx, Callable::CallError &r_error) {
+		Variant::Type argtype = GetTypeInfo<Span<T>>::VARIANT_TYPE;
+		if (!Variant::can_convert_strict(p_args[p_arg_idx]->get_type(), argtype)) {
+			r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+			r_error.argument = p_arg_idx;
+			r_error.expected = argtype;
+		}
+
+		return VariantCaster<Span<T>>::cast(*p_args[p_arg_idx]);
+	}
+};
+
 #endif // DEBUG_ENABLED
 
 template <typename T, typename... P, size_t... Is>
@@ -296,6 +296,16 @@ struct PtrToArg<Vector<RID>> : Internal::PtrToArgVectorFromArray<RID> {};
 template <>
 struct PtrToArg<Vector<Plane>> : Internal::PtrToArgVectorFromArray<Plane> {};
 
+// Read-only views of packed arrays. The view is only valid for the duration of the call,
+// and can't be encoded, so Span can't be used as a return type.
+
+template <typename T>
+struct PtrToArg<Span<T>> {
+	_FORCE_INLINE_ static Span<T> convert(const void *p_ptr) {
+		return reinterpret_cast<const Vector<T> *>(p_ptr)->span();
+	}
+};
+
 // Special case for IPAddress.
 
 template <>
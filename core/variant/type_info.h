@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/templates/simple_type.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 
 #include <type_traits>
@@ -133,6 +134,18 @@ MAKE_TYPE_INFO(PackedVector3Array, Variant::PACKED_VECTOR3_ARRAY)
 MAKE_TYPE_INFO(PackedColorArray, Variant::PACKED_COLOR_ARRAY)
 MAKE_TYPE_INFO(PackedVector4Array, Variant::PACKED_VECTOR4_ARRAY)
 
+// Read-only views of packed arrays, for bound methods that only read them.
+MAKE_TYPE_INFO(Span<uint8_t>, Variant::PACKED_BYTE_ARRAY)
+MAKE_TYPE_INFO(Span<int32_t>, Variant::PACKED_INT32_ARRAY)
+MAKE_TYPE_INFO(Span<int64_t>, Variant::PACKED_INT64_ARRAY)
+MAKE_TYPE_INFO(Span<float>, Variant::PACKED_FLOAT32_ARRAY)
+MAKE_TYPE_INFO(Span<double>, Variant::PACKED_FLOAT64_ARRAY)
+MAKE_TYPE_INFO(Span<String>, Variant::PACKED_STRING_ARRAY)
+MAKE_TYPE_INFO(Span<Vector2>, Variant::PACKED_VECTOR2_ARRAY)
+MAKE_TYPE_INFO(Span<Vector3>, Variant::PACKED_VECTOR3_ARRAY)
+MAKE_TYPE_INFO(Span<Color>, Variant::PACKED_COLOR_ARRAY)
+MAKE_TYPE_INFO(Span<Vector4>, Variant::PACKED_VECTOR4_ARRAY)
+
 MAKE_TYPE_INFO(IPAddress, Variant::STRING)
 
 //objectID
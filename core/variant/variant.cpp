@@ -40,6 +40,171 @@ PagedAllocator<Variant::Pools::BucketSmall, true> Variant::Pools::_bucket_small;
 PagedAllocator<Variant::Pools::BucketMedium, true> Variant::Pools::_bucket_medium;
 PagedAllocator<Variant::Pools::BucketLarge, true> Variant::Pools::_bucket_large;
 
+thread_local Variant::Pools::ThreadCache Variant::Pools::thread_cache;
+uint32_t Variant::Pools::thread_cache_size = 64;
+
+SpinLock Variant::Pools::thread_caches_lock;
+Variant::Pools::ThreadCache *Variant::Pools::thread_caches = nullptr;
+uint64_t Variant::Pools::retired_allocs = 0;
+uint64_t Variant::Pools::retired_frees = 0;
+
+void Variant::Pools::ThreadCache::register_thread() {
+	thread_caches_lock.lock();
+	next_cache = thread_caches;
+	if (thread_caches) {
+		thread_caches->prev_cache = this;
+	}
+	thread_caches = this;
+	thread_caches_lock.unlock();
+	registered = true;
+}
+
+void Variant::Pools::ThreadCache::setup(uint32_t p_capacity) {
+	items[0] = (void **)memalloc(sizeof(void *) * p_capacity * BUCKET_MAX);
+	for (int i = 1; i < BUCKET_MAX; i++) {
+		items[i] = items[0] + i * p_capacity;
+	}
+	capacity = p_capacity;
+}
+
+void Variant::Pools::ThreadCache::flush() {
+	if (capacity == 0) {
+		return;
+	}
+	for (int i = 0; i < BUCKET_MAX; i++) {
+		_bucket_free_batch(BucketType(i), items[i], counts[i]);
+		counts[i] = 0;
+	}
+	memfree(items[0]);
+	for (int i = 0; i < BUCKET_MAX; i++) {
+		items[i] = nullptr;
+	}
+	capacity = 0;
+}
+
+Variant::Pools::ThreadCache::~ThreadCache() {
+	flush();
+	finished = true;
+
+	if (registered) {
+		thread_caches_lock.lock();
+		if (prev_cache) {
+			prev_cache->next_cache = next_cache;
+		} else {
+			thread_caches = next_cache;
+		}
+		if (next_cache) {
+			next_cache->prev_cache = prev_cache;
+		}
+		retired_allocs += allocs.get();
+		retired_frees += frees.get();
+		thread_caches_lock.unlock();
+	}
+}
+
+void Variant::Pools::_bucket_alloc_batch(BucketType p_bucket, void **r_mem, uint32_t p_count) {
+	switch (p_bucket) {
+		case BUCKET_SMALL: {
+			_bucket_small.alloc_raw_batch((BucketSmall **)r_mem, p_count);
+		} break;
+		case BUCKET_MEDIUM: {
+			_bucket_medium.alloc_raw_batch((BucketMedium **)r_mem, p_count);
+		} break;
+		case BUCKET_LARGE: {
+			_bucket_large.alloc_raw_batch((BucketLarge **)r_mem, p_count);
+		} break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+}
+
+void Variant::Pools::_bucket_free_batch(BucketType p_bucket, void *const *p_mem, uint32_t p_count) {
+	switch (p_bucket) {
+		case BUCKET_SMALL: {
+			_bucket_small.free_raw_batch((BucketSmall *const *)p_mem, p_count);
+		} break;
+		case BUCKET_MEDIUM: {
+			_bucket_medium.free_raw_batch((BucketMedium *const *)p_mem, p_count);
+		} break;
+		case BUCKET_LARGE: {
+			_bucket_large.free_raw_batch((BucketLarge *const *)p_mem, p_count);
+		} break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+}
+
+void *Variant::Pools::_alloc_slow(BucketType p_bucket) {
+	ThreadCache &cache = thread_cache;
+	if (unlikely(!cache.registered && !cache.finished)) {
+		// Also needed without caching, so this thread's counters show up in the stats.
+		cache.register_thread();
+	}
+	if (cache.capacity == 0) {
+		if (cache.finished || thread_cache_size == 0) {
+			void *mem = nullptr;
+			_bucket_alloc_batch(p_bucket, &mem, 1);
+			return mem;
+		}
+		cache.setup(thread_cache_size);
+	}
+
+	// Only refill half the cache, so the following frees don't immediately overflow it.
+	uint32_t count = MAX(cache.capacity / 2, 1u);
+	_bucket_alloc_batch(p_bucket, cache.items[p_bucket], count);
+	cache.counts[p_bucket] = count - 1;
+	return cache.items[p_bucket][count - 1];
+}
+
+void Variant::Pools::_free_slow(BucketType p_bucket, void *p_mem) {
+	ThreadCache &cache = thread_cache;
+	if (unlikely(!cache.registered && !cache.finished)) {
+		cache.register_thread();
+	}
+	if (cache.capacity == 0) {
+		if (cache.finished || thread_cache_size == 0) {
+			_bucket_free_batch(p_bucket, &p_mem, 1);
+			return;
+		}
+		cache.setup(thread_cache_size);
+	} else {
+		// The cache is full, give half of it back.
+		uint32_t count = MAX(cache.capacity / 2, 1u);
+		cache.counts[p_bucket] -= count;
+		_bucket_free_batch(p_bucket, cache.items[p_bucket] + cache.counts[p_bucket], count);
+	}
+	cache.items[p_bucket][cache.counts[p_bucket]++] = p_mem;
+}
+
+void Variant::configure_pools(uint32_t p_small_page_size, uint32_t p_medium_page_size, uint32_t p_large_page_size, uint32_t p_thread_cache_size) {
+	Pools::_bucket_small.configure(p_small_page_size);
+	Pools::_bucket_medium.configure(p_medium_page_size);
+	Pools::_bucket_large.configure(p_large_page_size);
+
+	// Caches of other threads keep their size, this is meant to be called before they start.
+	Pools::thread_cache_size = p_thread_cache_size;
+	Pools::thread_cache.flush();
+}
+
+Variant::PoolStats Variant::get_pool_stats() {
+	PoolStats stats;
+	Pools::thread_caches_lock.lock();
+	stats.allocs = Pools::retired_allocs;
+	stats.frees = Pools::retired_frees;
+	for (Pools::ThreadCache *cache = Pools::thread_caches; cache; cache = cache->next_cache) {
+		stats.allocs += cache->allocs.get();
+		stats.frees += cache->frees.get();
+	}
+	Pools::thread_caches_lock.unlock();
+
+	stats.reserved_bytes = uint64_t(Pools::_bucket_small.get_capacity()) * sizeof(Pools::BucketSmall) +
+			uint64_t(Pools::_bucket_medium.get_capacity()) * sizeof(Pools::BucketMedium) +
+			uint64_t(Pools::_bucket_large.get_capacity()) * sizeof(Pools::BucketLarge);
+	return stats;
+}
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1180,7 +1345,7 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = (Transform2D *)Pools::_bucket_small.alloc();
+			_data._transform2d = (Transform2D *)Pools::alloc<Pools::BUCKET_SMALL>();
 			memnew_placement(_data._transform2d, Transform2D(*p_variant._data._transform2d));
 		} break;
 		case VECTOR3: {
@@ -1199,22 +1364,22 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Plane(*reinterpret_cast<const Plane *>(p_variant._data._mem)));
 		} break;
 		case AABB: {
-			_data._aabb = (::AABB *)Pools::_bucket_small.alloc();
+			_data._aabb = (::AABB *)Pools::alloc<Pools::BUCKET_SMALL>();
 			memnew_placement(_data._aabb, ::AABB(*p_variant._data._aabb));
 		} break;
 		case QUATERNION: {
 			memnew_placement(_data._mem, Quaternion(*reinterpret_cast<const Quaternion *>(p_variant._data._mem)));
 		} break;
 		case BASIS: {
-			_data._basis = (Basis *)Pools::_bucket_medium.alloc();
+			_data._basis = (Basis *)Pools::alloc<Pools::BUCKET_MEDIUM>();
 			memnew_placement(_data._basis, Basis(*p_variant._data._basis));
 		} break;
 		case TRANSFORM3D: {
-			_data._transform3d = (Transform3D *)Pools::_bucket_medium.alloc();
+			_data._transform3d = (Transform3D *)Pools::alloc<Pools::BUCKET_MEDIUM>();
 			memnew_placement(_data._transform3d, Transform3D(*p_variant._data._transform3d));
 		} break;
 		case PROJECTION: {
-			_data._projection = (Projection *)Pools::_bucket_large.alloc();
+			_data._projection = (Projection *)Pools::alloc<Pools::BUCKET_LARGE>();
 			memnew_placement(_data._projection, Projection(*p_variant._data._projection));
 		} break;
 
@@ -1385,35 +1550,35 @@ void Variant::_clear_internal() {
 		case TRANSFORM2D: {
 			if (_data._transform2d) {
 				_data._transform2d->~Transform2D();
-				Pools::_bucket_small.free((Pools::BucketSmall *)_data._transform2d);
+				Pools::free<Pools::BUCKET_SMALL>(_data._transform2d);
 				_data._transform2d = nullptr;
 			}
 		} break;
 		case AABB: {
 			if (_data._aabb) {
 				_data._aabb->~AABB();
-				Pools::_bucket_small.free((Pools::BucketSmall *)_data._aabb);
+				Pools::free<Pools::BUCKET_SMALL>(_data._aabb);
 				_data._aabb = nullptr;
 			}
 		} break;
 		case BASIS: {
 			if (_data._basis) {
 				_data._basis->~Basis();
-				Pools::_bucket_medium.free((Pools::BucketMedium *)_data._basis);
+				Pools::free<Pools::BUCKET_MEDIUM>(_data._basis);
 				_data._basis = nullptr;
 			}
 		} break;
 		case TRANSFORM3D: {
 			if (_data._transform3d) {
 				_data._transform3d->~Transform3D();
-				Pools::_bucket_medium.free((Pools::BucketMedium *)_data._transform3d);
+				Pools::free<Pools::BUCKET_MEDIUM>(_data._transform3d);
 				_data._transform3d = nullptr;
 			}
 		} break;
 		case PROJECTION: {
 			if (_data._projection) {
 				_data._projection->~Projection();
-				Pools::_bucket_large.free((Pools::BucketLarge *)_data._projection);
+				Pools::free<Pools::BUCKET_LARGE>(_data._projection);
 				_data._projection = nullptr;
 			}
 		} break;
@@ -2445,13 +2610,13 @@ Variant::Variant(const Plane &p_plane) :
 
 Variant::Variant(const ::AABB &p_aabb) :
 		type(AABB) {
-	_data._aabb = (::AABB *)Pools::_bucket_small.alloc();
+	_data._aabb = (::AABB *)Pools::alloc<Pools::BUCKET_SMALL>();
 	memnew_placement(_data._aabb, ::AABB(p_aabb));
 }
 
 Variant::Variant(const Basis &p_matrix) :
 		type(BASIS) {
-	_data._basis = (Basis *)Pools::_bucket_medium.alloc();
+	_data._basis = (Basis *)Pools::alloc<Pools::BUCKET_MEDIUM>();
 	memnew_placement(_data._basis, Basis(p_matrix));
 }
 
@@ -2463,19 +2628,19 @@ Variant::Variant(const Quaternion &p_quaternion) :
 
 Variant::Variant(const Transform3D &p_transform) :
 		type(TRANSFORM3D) {
-	_data._transform3d = (Transform3D *)Pools::_bucket_medium.alloc();
+	_data._transform3d = (Transform3D *)Pools::alloc<Pools::BUCKET_MEDIUM>();
 	memnew_placement(_data._transform3d, Transform3D(p_transform));
 }
 
 Variant::Variant(const Projection &pp_projection) :
 		type(PROJECTION) {
-	_data._projection = (Projection *)Pools::_bucket_large.alloc();
+	_data._projection = (Projection *)Pools::alloc<Pools::BUCKET_LARGE>();
 	memnew_placement(_data._projection, Projection(pp_projection));
 }
 
 Variant::Variant(const Transform2D &p_transform) :
 		type(TRANSFORM2D) {
-	_data._transform2d = (Transform2D *)Pools::_bucket_small.alloc();
+	_data._transform2d = (Transform2D *)Pools::alloc<Pools::BUCKET_SMALL>();
 	memnew_placement(_data._transform2d, Transform2D(p_transform));
 }
 
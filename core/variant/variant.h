@@ -58,6 +58,7 @@
 #include "core/templates/list.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/array.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
@@ -169,6 +170,69 @@ private:
 		static PagedAllocator<BucketSmall, true> _bucket_small;
 		static PagedAllocator<BucketMedium, true> _bucket_medium;
 		static PagedAllocator<BucketLarge, true> _bucket_large;
+
+		enum BucketType {
+			BUCKET_SMALL,
+			BUCKET_MEDIUM,
+			BUCKET_LARGE,
+			BUCKET_MAX,
+		};
+
+		// Small per-thread free lists in front of the shared buckets, so threads churning
+		// through these types only take the bucket lock once per batch.
+		struct ThreadCache {
+			void **items[BUCKET_MAX] = {};
+			uint32_t counts[BUCKET_MAX] = {};
+			uint32_t capacity = 0; // Zero until the cache is set up, and after it's flushed.
+			bool registered = false;
+			bool finished = false;
+
+			// Only written by the owning thread.
+			SafeNumeric<uint64_t> allocs;
+			SafeNumeric<uint64_t> frees;
+
+			ThreadCache *prev_cache = nullptr;
+			ThreadCache *next_cache = nullptr;
+
+			void register_thread();
+			void setup(uint32_t p_capacity);
+			void flush();
+			~ThreadCache();
+		};
+
+		static thread_local ThreadCache thread_cache;
+		static uint32_t thread_cache_size;
+
+		static SpinLock thread_caches_lock;
+		static ThreadCache *thread_caches;
+		static uint64_t retired_allocs; // Counts of threads that already exited.
+		static uint64_t retired_frees;
+
+		static void _bucket_alloc_batch(BucketType p_bucket, void **r_mem, uint32_t p_count);
+		static void _bucket_free_batch(BucketType p_bucket, void *const *p_mem, uint32_t p_count);
+		static void *_alloc_slow(BucketType p_bucket);
+		static void _free_slow(BucketType p_bucket, void *p_mem);
+
+		template <BucketType B>
+		_FORCE_INLINE_ static void *alloc() {
+			ThreadCache &cache = thread_cache;
+			cache.allocs.set(cache.allocs.get() + 1);
+			if (likely(cache.counts[B] > 0)) {
+				return cache.items[B][--cache.counts[B]];
+			}
+			return _alloc_slow(B);
+		}
+
+		template <BucketType B>
+		_FORCE_INLINE_ static void free(void *p_mem) {
+			ThreadCache &cache = thread_cache;
+			cache.frees.set(cache.frees.get() + 1);
+			if (likely(cache.counts[B] < cache.capacity)) {
+				cache.items[B][cache.counts[B]++] = p_mem;
+				return;
+			}
+			_free_slow(B, p_mem);
+		}
 	};
 
 	friend struct _VariantCall;
@@ -859,6 +923,17 @@ public:
 	static void register_types();
 	static void unregister_types();
 
+	struct PoolStats {
+		uint64_t allocs = 0;
+		uint64_t frees = 0;
+		uint64_t reserved_bytes = 0;
+	};
+
+	// Page sizes are in elements. Changing them only affects pages allocated afterwards.
+	// A thread cache size of zero disables the per-thread caches.
+	static void configure_pools(uint32_t p_small_page_size, uint32_t p_medium_page_size, uint32_t p_large_page_size, uint32_t p_thread_cache_size);
+	static PoolStats get_pool_stats();
+
 	Variant(const Variant &p_variant);
 	Variant(Variant &&p_variant) {
 		type = p_variant.type;
@@ -227,27 +227,27 @@ public:
 		v->type = Variant::STRING;
 	}
 	_FORCE_INLINE_ static void init_transform2d(Variant *v) {
-		v->_data._transform2d = (Transform2D *)Variant::Pools::_bucket_small.alloc();
+		v->_data._transform2d = (Transform2D *)Variant::Pools::alloc<Variant::Pools::BUCKET_SMALL>();
 		memnew_placement(v->_data._transform2d, Transform2D);
 		v->type = Variant::TRANSFORM2D;
 	}
 	_FORCE_INLINE_ static void init_aabb(Variant *v) {
-		v->_data._aabb = (AABB *)Variant::Pools::_bucket_small.alloc();
+		v->_data._aabb = (AABB *)Variant::Pools::alloc<Variant::Pools::BUCKET_SMALL>();
 		memnew_placement(v->_data._aabb, AABB);
 		v->type = Variant::AABB;
 	}
 	_FORCE_INLINE_ static void init_basis(Variant *v) {
-		v->_data._basis = (Basis *)Variant::Pools::_bucket_medium.alloc();
+		v->_data._basis = (Basis *)Variant::Pools::alloc<Variant::Pools::BUCKET_MEDIUM>();
 		memnew_placement(v->_data._basis, Basis);
 		v->type = Variant::BASIS;
 	}
 	_FORCE_INLINE_ static void init_transform3d(Variant *v) {
-		v->_data._transform3d = (Transform3D *)Variant::Pools::_bucket_medium.alloc();
+		v->_data._transform3d = (Transform3D *)Variant::Pools::alloc<Variant::Pools::BUCKET_MEDIUM>();
 		memnew_placement(v->_data._transform3d, Transform3D);
 		v->type = Variant::TRANSFORM3D;
 	}
 	_FORCE_INLINE_ static void init_projection(Variant *v) {
-		v->_data._projection = (Projection *)Variant::Pools::_bucket_large.alloc();
+		v->_data._projection = (Projection *)Variant::Pools::alloc<Variant::Pools::BUCKET_LARGE>();
 		memnew_placement(v->_data._projection, Projection);
 		v->type = Variant::PROJECTION;
 	}
@@ -1039,6 +1039,12 @@ struct VariantInternalAccessor<PackedVector4Array> {
 	static _FORCE_INLINE_ void set(Variant *v, const PackedVector4Array &p_value) { *VariantInternal::get_vector4_array(v) = p_value; }
 };
 
+// Read-only view of a packed array, see `VariantCaster<Span<T>>`.
+template <typename T>
+struct VariantInternalAccessor<Span<T>> {
+	static _FORCE_INLINE_ Span<T> get(const Variant *v) { return VariantInternalAccessor<Vector<T>>::get(v).span(); }
+};
+
 template <>
 struct VariantInternalAccessor<Object *> {
 	static _FORCE_INLINE_ Object *get(const Variant *v) { return const_cast<Object *>(*VariantInternal::get_object(v)); }
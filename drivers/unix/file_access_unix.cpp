@@ -36,6 +36,7 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -171,6 +172,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapping) {
+		munmap(mapping, mapping_size);
+		mapping = nullptr;
+		mapping_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -276,6 +283,56 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Span<uint8_t> FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, Span<uint8_t>(), "File must be opened before use.");
+
+#ifdef WEB_ENABLED
+	// Emscripten emulates mappings by reading the whole file into memory.
+	return Span<uint8_t>();
+#else
+	if (flags != READ || p_length < BUFFER_VIEW_MIN_SIZE) {
+		return Span<uint8_t>();
+	}
+
+	if (!mapping) {
+		struct stat st = {};
+		if (fstat(fileno(f), &st) != 0 || st.st_size <= 0) {
+			return Span<uint8_t>();
+		}
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		if (addr == MAP_FAILED) {
+			return Span<uint8_t>();
+		}
+		mapping = (uint8_t *)addr;
+		mapping_size = st.st_size;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0 || (uint64_t)pos > mapping_size || p_length > mapping_size - pos) {
+		// Short reads go through `get_buffer()`, which reports the end of file.
+		return Span<uint8_t>();
+	}
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return Span<uint8_t>();
+	}
+
+	last_error = OK;
+	return Span<uint8_t>(mapping + pos, p_length);
+#endif
+}
+
+bool FileAccessUnix::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, false, "File must be opened before use.");
+
+#if defined(POSIX_FADV_WILLNEED) && !defined(WEB_ENABLED)
+	// Queues the reads in the kernel and returns without waiting for them.
+	return posix_fadvise(fileno(f), p_offset, p_length, POSIX_FADV_WILLNEED) == 0;
+#else
+	return false;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
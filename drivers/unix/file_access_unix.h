@@ -47,6 +47,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Whole file, mapped on the first `get_buffer_view()` of a read-only file, see BUFFER_VIEW_MIN_SIZE.
+	mutable uint8_t *mapping = nullptr;
+	mutable uint64_t mapping_size = 0;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -71,6 +75,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual bool prefetch(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
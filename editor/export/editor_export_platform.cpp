@@ -1982,28 +1982,22 @@ bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, Pa
 
 		fhead = fae;
 	}
+	LocalVector<PackedSourcePCK::DirectoryEntry> entries;
+	entries.resize(p_pack_data.file_ofs.size());
 	for (int i = 0; i < p_pack_data.file_ofs.size(); i++) {
-		uint32_t string_len = p_pack_data.file_ofs[i].path_utf8.length();
-		uint32_t pad = _get_pad(4, string_len);
-
-		fhead->store_32(string_len + pad);
-		fhead->store_buffer((const uint8_t *)p_pack_data.file_ofs[i].path_utf8.get_data(), string_len);
-		for (uint32_t j = 0; j < pad; j++) {
-			fhead->store_8(0);
-		}
-
-		fhead->store_64(p_pack_data.file_ofs[i].ofs - p_file_base);
-		fhead->store_64(p_pack_data.file_ofs[i].size); // pay attention here, this is where file is
-		fhead->store_buffer(p_pack_data.file_ofs[i].md5.ptr(), 16); //also save md5 for file
-		uint32_t flags = 0;
+		PackedSourcePCK::DirectoryEntry &entry = entries[i];
+		entry.path = p_pack_data.file_ofs[i].path_utf8;
+		entry.offset = p_pack_data.file_ofs[i].ofs - p_file_base;
+		entry.size = p_pack_data.file_ofs[i].size; // pay attention here, this is where file is
+		memcpy(entry.md5, p_pack_data.file_ofs[i].md5.ptr(), 16); //also save md5 for file
 		if (p_pack_data.file_ofs[i].encrypted) {
-			flags |= PACK_FILE_ENCRYPTED;
+			entry.flags |= PACK_FILE_ENCRYPTED;
 		}
 		if (p_pack_data.file_ofs[i].removal) {
-			flags |= PACK_FILE_REMOVAL;
+			entry.flags |= PACK_FILE_REMOVAL;
 		}
-		fhead->store_32(flags);
 	}
+	PackedSourcePCK::store_directory(fhead, entries);
 
 	if (fae.is_valid()) {
 		fhead.unref();
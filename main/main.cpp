@@ -1946,6 +1946,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 #endif
 	}
 
+	// Before the worker threads start, as they only pick up the thread cache size once.
+	Variant::configure_pools(
+			GLOBAL_GET("memory/limits/variant_pools/small_page_size"),
+			GLOBAL_GET("memory/limits/variant_pools/medium_page_size"),
+			GLOBAL_GET("memory/limits/variant_pools/large_page_size"),
+			GLOBAL_GET("memory/limits/variant_pools/thread_cache_size"));
+
 	// Initialize WorkerThreadPool.
 	{
 #ifdef THREADS_ENABLED
@@ -1954,7 +1961,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else {
 			int worker_threads = GLOBAL_GET("threading/worker_pool/max_threads");
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
-			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
+			bool use_work_stealing = GLOBAL_GET("threading/worker_pool/use_work_stealing");
+			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio, use_work_stealing);
 		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
@@ -4649,6 +4657,13 @@ static uint64_t navigation_process_max = 0;
 bool Main::iteration() {
 	iterating++;
 
+	// Temporaries allocated on the main thread during the previous frame are no longer needed.
+	// Nested iterations (e.g. progress dialogs) must keep them, since the outer frame isn't over yet.
+	if (iterating == 1) {
+		FrameArena::reset();
+		MessageQueue::get_main_singleton()->end_frame_stats();
+	}
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -129,6 +129,14 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_HIGH_WATER);
+	BIND_ENUM_CONSTANT(MEMORY_VARIANT_POOL_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_VARIANT_POOL_FREES);
+	BIND_ENUM_CONSTANT(MEMORY_VARIANT_POOL_RESERVED);
+	BIND_ENUM_CONSTANT(OBJECT_MESSAGE_QUEUE_FLUSHED);
+	BIND_ENUM_CONSTANT(OBJECT_MESSAGE_QUEUE_COALESCED);
+	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_QUEUE_FLUSHED);
+	BIND_ENUM_CONSTANT(TIME_MESSAGE_QUEUE_FLUSH);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -209,6 +217,14 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/frame_arena_high_water"),
+		PNAME("memory/variant_pool_allocs"),
+		PNAME("memory/variant_pool_frees"),
+		PNAME("memory/variant_pool_reserved"),
+		PNAME("object/message_queue_flushed"),
+		PNAME("object/message_queue_coalesced"),
+		PNAME("memory/message_queue_flushed"),
+		PNAME("time/message_queue_flush"),
 	};
 	static_assert(std::size(names) == MONITOR_MAX);
 
@@ -433,6 +449,23 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
+		case MEMORY_FRAME_ARENA_HIGH_WATER:
+			return FrameArena::get_max_high_water();
+		case MEMORY_VARIANT_POOL_ALLOCS:
+			return Variant::get_pool_stats().allocs;
+		case MEMORY_VARIANT_POOL_FREES:
+			return Variant::get_pool_stats().frees;
+		case MEMORY_VARIANT_POOL_RESERVED:
+			return Variant::get_pool_stats().reserved_bytes;
+		case OBJECT_MESSAGE_QUEUE_FLUSHED:
+			return MessageQueue::get_main_singleton()->get_last_frame_stats().messages;
+		case OBJECT_MESSAGE_QUEUE_COALESCED:
+			return MessageQueue::get_main_singleton()->get_last_frame_stats().coalesced_sets;
+		case MEMORY_MESSAGE_QUEUE_FLUSHED:
+			return MessageQueue::get_main_singleton()->get_last_frame_stats().bytes;
+		case TIME_MESSAGE_QUEUE_FLUSH:
+			return MessageQueue::get_main_singleton()->get_last_frame_stats().usec / 1000000.0;
+
 		default: {
 		}
 	}
@@ -503,6 +536,14 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
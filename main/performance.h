@@ -125,6 +125,14 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		MEMORY_FRAME_ARENA_HIGH_WATER,
+		MEMORY_VARIANT_POOL_ALLOCS,
+		MEMORY_VARIANT_POOL_FREES,
+		MEMORY_VARIANT_POOL_RESERVED,
+		OBJECT_MESSAGE_QUEUE_FLUSHED,
+		OBJECT_MESSAGE_QUEUE_COALESCED,
+		MEMORY_MESSAGE_QUEUE_FLUSHED,
+		TIME_MESSAGE_QUEUE_FLUSH,
 		MONITOR_MAX
 	};
 
@@ -31,8 +31,10 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -742,6 +744,23 @@ void GDScript::_restore_old_static_data() {
 
 #endif
 
+bool GDScript::_should_compile_lazily(bool p_has_instances) const {
+	// Running instances need their functions right away, the editor keeps inspecting scripts, and the bytecode cache saves compiled functions only.
+	if (p_has_instances || Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	return language->should_compile_lazily() && !language->is_bytecode_cache_enabled();
+}
+
+void GDScript::_clear_lazy_compilation() {
+	MutexLock lock(lazy_mutex);
+	if (lazy_compilation != nullptr) {
+		memdelete(lazy_compilation);
+		lazy_compilation = nullptr;
+	}
+}
+
 Error GDScript::reload(bool p_keep_state) {
 	if (reloading) {
 		return OK;
@@ -811,8 +830,28 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	if (!has_instances) {
+		// Skip parsing and compiling entirely when an up to date compiled copy is cached.
+		Error cache_err = GDScriptBytecodeCache::load(this);
+		if (cache_err != ERR_UNAVAILABLE) {
+			if (cache_err) {
+				_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), 0, "Compile Error: Failed to compile depended scripts.", false, ERR_HANDLER_SCRIPT);
+				cache_err = ERR_COMPILATION_FAILED;
+			} else if (ScriptServer::is_scripting_enabled() || is_tool()) {
+				cache_err = _static_init();
+			}
+			reloading = false;
+			return cache_err;
+		}
+	}
+
 	valid = false;
-	GDScriptParser parser;
+	_clear_lazy_compilation();
+
+	// In lazy mode the tree outlives this call, so that member functions can be compiled on their first call.
+	GDScriptLazyCompilation *lazy = _should_compile_lazily(has_instances) ? memnew(GDScriptLazyCompilation) : nullptr;
+	GDScriptParser local_parser;
+	GDScriptParser &parser = lazy ? *lazy->parser : local_parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
@@ -825,6 +864,7 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 		// TODO: Show all error messages.
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+		memdelete_notnull(lazy);
 		reloading = false;
 		return ERR_PARSE_ERROR;
 	}
@@ -842,6 +882,7 @@ Error GDScript::reload(bool p_keep_state) {
 			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 			e = e->next();
 		}
+		memdelete_notnull(lazy);
 		reloading = false;
 		return ERR_PARSE_ERROR;
 	}
@@ -849,9 +890,15 @@ Error GDScript::reload(bool p_keep_state) {
 	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
 	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+	err = compiler.compile(&parser, this, p_keep_state, lazy);
 
 	if (err) {
+		if (lazy) {
+			for (GDScriptFunction *function : lazy->functions) {
+				function->lazy_pending.clear();
+			}
+			memdelete(lazy);
+		}
 		// TODO: Provide the script function as the first argument.
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 		if (can_run) {
@@ -866,6 +913,8 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	GDScriptBytecodeCache::save(this, &parser);
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -882,6 +931,19 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	if (lazy && lazy->functions.is_empty()) {
+		memdelete(lazy);
+	} else if (lazy) {
+		lazy->track_dependencies();
+		{
+			MutexLock lock(lazy_mutex);
+			lazy_compilation = lazy;
+		}
+		if (GDScriptLanguage::get_singleton()->should_prewarm_lazy_functions()) {
+			GDScriptCompiler::prewarm_lazy_functions(this);
+		}
+	}
+
 	if (can_run) {
 		err = _static_init();
 		if (err) {
@@ -1413,6 +1475,8 @@ void GDScript::_collect_dependencies(RBSet<GDScript *> &p_dependencies, const GD
 
 GDScript::GDScript() :
 		script_list(this) {
+	// A script allocated where a freed one was must not match the entries cached for it.
+	inline_cache_version.set(GDScriptInlineCache::next_version());
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 
@@ -1539,6 +1603,8 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptInlineCache::invalidate(this);
+	_clear_lazy_compilation();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -2288,6 +2354,11 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	GDScriptSampler::initialize();
+	if (sampling_profiler_frequency > 0 && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSampler::start(sampling_profiler_frequency);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2329,8 +2400,20 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (GDScriptSampler::is_running()) {
+		GDScriptSampler::stop();
+		if (sampling_profiler_frequency > 0 && !sampling_profiler_output.is_empty()) {
+			GDScriptSampler::save(sampling_profiler_output);
+		}
+	}
+	GDScriptSampler::finalize();
+
+	// The background compilation reads trees owned by the cache.
+	GDScriptCompiler::finish_prewarm();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
+	GDScriptBytecodeCache::clear();
 
 	// Clear dependencies between scripts, to ensure cyclic references are broken
 	// (to avoid leaks at exit).
@@ -2381,6 +2464,8 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
+		elem->self()->profile.inline_cache_hits.set(0);
+		elem->self()->profile.inline_cache_misses.set(0);
 		elem->self()->profile.native_calls.clear();
 		elem->self()->profile.last_native_calls.clear();
 		elem = elem->next();
@@ -2436,6 +2521,23 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 			++nat_calls;
 		}
 		p_info_arr[last_non_internal].internal_time = nat_time;
+
+		// Inline cache counters of the untyped property accesses and calls, reported as call counts.
+		if (profile_native_calls) {
+			const uint64_t cache_counts[2] = { elem->self()->profile.inline_cache_hits.get(), elem->self()->profile.inline_cache_misses.get() };
+			const char *cache_names[2] = { "inline cache hits", "inline cache misses" };
+			for (int i = 0; i < 2 && current < p_info_max; i++) {
+				if (cache_counts[i] == 0) {
+					continue;
+				}
+				p_info_arr[current].call_count = cache_counts[i];
+				p_info_arr[current].total_time = 0;
+				p_info_arr[current].self_time = 0;
+				p_info_arr[current].internal_time = 0;
+				p_info_arr[current].signature = vformat("%s (%s)", elem->self()->profile.signature, cache_names[i]);
+				current++;
+			}
+		}
 		elem = elem->next();
 	}
 #endif
@@ -2959,6 +3061,14 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	bytecode_cache_enabled = GLOBAL_DEF_RST("debug/settings/gdscript/bytecode_cache", false);
+	bytecode_cache_path = GLOBAL_DEF_RST("debug/settings/gdscript/bytecode_cache_path", "user://.gdscript_cache");
+	optimize_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/optimize_bytecode", true);
+	threaded_code_threshold = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/threaded_code_call_threshold", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 0);
+	lazy_compilation = GLOBAL_DEF_RST("debug/settings/gdscript/lazy_compilation", false);
+	lazy_compilation_prewarm = GLOBAL_DEF_RST("debug/settings/gdscript/lazy_compilation_prewarm", false);
+	sampling_profiler_frequency = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_frequency", PROPERTY_HINT_RANGE, "0,10000,1,suffix:Hz"), 0);
+	sampling_profiler_output = GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "debug/settings/gdscript/sampling_profiler_output", PROPERTY_HINT_SAVE_FILE, "*.txt,*.json"), "user://gdscript_samples.txt");
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
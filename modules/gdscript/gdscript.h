@@ -31,6 +31,7 @@
 #pragma once
 
 #include "gdscript_function.h"
+#include "gdscript_sampler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -40,6 +41,8 @@
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
 
+struct GDScriptLazyCompilation;
+
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
 
@@ -84,8 +87,10 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
@@ -192,6 +197,15 @@ private:
 
 	SelfList<GDScriptFunctionState>::List pending_func_states;
 
+	SafeNumeric<uint64_t> inline_cache_version; // See `GDScriptInlineCache::invalidate()`.
+
+	// Tree the stubs of member functions are compiled from, on the root script only.
+	GDScriptLazyCompilation *lazy_compilation = nullptr;
+	Mutex lazy_mutex; // Protects the field above. Taken after the cache mutex when both are needed.
+
+	bool _should_compile_lazily(bool p_has_instances) const;
+	void _clear_lazy_compilation();
+
 	GDScriptFunction *_super_constructor(GDScript *p_script);
 	void _super_implicit_constructor(GDScript *p_script, GDScriptInstance *p_instance, Callable::CallError &r_error);
 	GDScriptInstance *_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, bool p_is_ref_counted, Callable::CallError &r_error);
@@ -365,6 +379,7 @@ class GDScriptInstance : public ScriptInstance {
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptCompiler;
 	friend class GDScriptCache;
+	friend class GDScriptInlineCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	ObjectID owner_id;
@@ -420,6 +435,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptAwaitCallable;
 
 	static GDScriptLanguage *singleton;
 
@@ -451,6 +467,15 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool track_call_stack = false;
 	bool track_locals = false;
 
+	bool bytecode_cache_enabled = false;
+	String bytecode_cache_path;
+	bool optimize_bytecode = true;
+	uint32_t threaded_code_threshold = 0;
+	bool lazy_compilation = false;
+	bool lazy_compilation_prewarm = false;
+	uint32_t sampling_profiler_frequency = 0;
+	String sampling_profiler_output;
+
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
@@ -464,8 +489,14 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	SelfList<GDScript>::List script_list;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
+	friend class GDScriptSampler;
 
 	SelfList<GDScriptFunction>::List function_list;
+
+	GDScriptFramePool frame_pool;
+	HashMap<Pair<ObjectID, StringName>, GDScriptAwaitCallable *> await_callables; // Protected by `mutex`.
+
 #ifdef DEBUG_ENABLED
 	bool profiling;
 	bool profile_native_calls;
@@ -507,6 +538,11 @@ public:
 			return;
 		}
 
+		// Before pushing, so ticks counted until now go to the caller.
+		if (unlikely(GDScriptSampler::is_active())) {
+			GDScriptSampler::poll();
+		}
+
 		call_level->prev = _call_stack;
 		_call_stack = call_level;
 		call_level->stack = p_stack;
@@ -543,6 +579,10 @@ public:
 			return;
 		}
 
+		if (unlikely(GDScriptSampler::is_active())) {
+			GDScriptSampler::poll();
+		}
+
 		_call_stack_size--;
 		_call_stack = _call_stack->prev;
 	}
@@ -580,6 +620,16 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool is_bytecode_cache_enabled() const { return bytecode_cache_enabled; }
+	void set_bytecode_cache_enabled(bool p_enabled) { bytecode_cache_enabled = p_enabled; }
+	_FORCE_INLINE_ const String &get_bytecode_cache_path() const { return bytecode_cache_path; }
+	void set_bytecode_cache_path(const String &p_path) { bytecode_cache_path = p_path; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	_FORCE_INLINE_ uint32_t get_threaded_code_threshold() const { return threaded_code_threshold; }
+	void set_threaded_code_threshold(uint32_t p_threshold) { threaded_code_threshold = p_threshold; }
+	_FORCE_INLINE_ bool should_compile_lazily() const { return lazy_compilation; }
+	void set_lazy_compilation(bool p_enabled) { lazy_compilation = p_enabled; }
+	_FORCE_INLINE_ bool should_prewarm_lazy_functions() const { return lazy_compilation_prewarm; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
@@ -2361,6 +2361,9 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 		}
 	}
 
+	// The list is only iterated, after its element type is known.
+	reduce_non_escaping_container(p_for->list);
+
 	resolve_suite(p_for->loop);
 	p_for->set_datatype(p_for->loop->get_datatype());
 #ifdef DEBUG_ENABLED
@@ -2860,6 +2863,14 @@ void GDScriptAnalyzer::reduce_assignment(GDScriptParser::AssignmentNode *p_assig
 
 	reduce_expression(p_assignment->assignee);
 
+	// Assigning to an element of a literal modifies it, so it must not be shared (see `reduce_non_escaping_container()`).
+	for (GDScriptParser::ExpressionNode *base = p_assignment->assignee; base && base->type == GDScriptParser::Node::SUBSCRIPT;) {
+		base = static_cast<GDScriptParser::SubscriptNode *>(base)->base;
+		if (base && (base->type == GDScriptParser::Node::ARRAY || base->type == GDScriptParser::Node::DICTIONARY)) {
+			base->is_constant = false;
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	{
 		bool is_subscript = false;
@@ -3086,6 +3097,10 @@ void GDScriptAnalyzer::reduce_binary_op(GDScriptParser::BinaryOpNode *p_binary_o
 	reduce_expression(p_binary_op->left_operand);
 	reduce_expression(p_binary_op->right_operand);
 
+	if (p_binary_op->operation == GDScriptParser::BinaryOpNode::OP_CONTENT_TEST && p_binary_op->left_operand && !p_binary_op->left_operand->is_constant) {
+		reduce_non_escaping_container(p_binary_op->right_operand);
+	}
+
 	GDScriptParser::DataType left_type;
 	if (p_binary_op->left_operand) {
 		left_type = p_binary_op->left_operand->get_datatype();
@@ -4890,6 +4905,10 @@ void GDScriptAnalyzer::reduce_subscript(GDScriptParser::SubscriptNode *p_subscri
 		}
 		reduce_expression(p_subscript->index);
 
+		if (!p_subscript->index->is_constant) {
+			reduce_non_escaping_container(p_subscript->base);
+		}
+
 		if (p_subscript->base->is_constant && p_subscript->index->is_constant) {
 			// Just try to get it.
 			bool valid = false;
@@ -5327,6 +5346,44 @@ Variant GDScriptAnalyzer::make_dictionary_reduced_value(GDScriptParser::Dictiona
 	return dictionary;
 }
 
+// Array and dictionary literals that are only read where they appear (iterated, indexed, or tested with `in`) can't be
+// reached from anywhere else, so they are folded into a read-only constant built once, instead of being allocated every
+// time the expression is evaluated. Literals holding other containers are left alone, since the elements would become
+// read-only too.
+void GDScriptAnalyzer::reduce_non_escaping_container(GDScriptParser::ExpressionNode *p_expression) {
+	if (p_expression == nullptr || p_expression->is_constant) {
+		return;
+	}
+	if (p_expression->type != GDScriptParser::Node::ARRAY && p_expression->type != GDScriptParser::Node::DICTIONARY) {
+		return;
+	}
+
+	bool is_reduced = false;
+	Variant value = make_expression_reduced_value(p_expression, is_reduced);
+	if (!is_reduced) {
+		return;
+	}
+
+	if (value.get_type() == Variant::ARRAY) {
+		const Array array = value;
+		for (const Variant &element : array) {
+			if (element.get_type() == Variant::ARRAY || element.get_type() == Variant::DICTIONARY) {
+				return;
+			}
+		}
+	} else {
+		const Dictionary dictionary = value;
+		for (const KeyValue<Variant, Variant> &kv : dictionary) {
+			if (kv.key.get_type() == Variant::ARRAY || kv.key.get_type() == Variant::DICTIONARY || kv.value.get_type() == Variant::ARRAY || kv.value.get_type() == Variant::DICTIONARY) {
+				return;
+			}
+		}
+	}
+
+	p_expression->is_constant = true;
+	p_expression->reduced_value = value;
+}
+
 Variant GDScriptAnalyzer::make_subscript_reduced_value(GDScriptParser::SubscriptNode *p_subscript, bool &is_reduced) {
 	if (p_subscript->base == nullptr || p_subscript->index == nullptr) {
 		return Variant();
@@ -150,6 +150,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		mark_jump_label();
 	}
 }
 
@@ -157,6 +158,48 @@ void GDScriptByteCodeGenerator::end_parameters() {
 	function->default_arguments.reverse();
 }
 
+void GDScriptByteCodeGenerator::add_fusion_candidate(GDScriptFunction::Opcode p_fused_opcode, const Address &p_operand) {
+	// The operator must be the instruction right before, and nothing may jump between the two.
+	if (last_validated_operator_pos < 0 || last_validated_operator_pos + 5 != opcodes.size() || last_jump_label == opcodes.size()) {
+		return;
+	}
+	if (p_operand.mode != last_validated_operator_target.mode || p_operand.address != last_validated_operator_target.address) {
+		return;
+	}
+	FusionCandidate candidate;
+	candidate.position = last_validated_operator_pos;
+	candidate.opcode = p_fused_opcode;
+	fusion_candidates.push_back(candidate);
+}
+
+// Replaces an `OPCODE_OPERATOR_VALIDATED` and the instruction consuming its result with a single superinstruction.
+// The operands stay where they are, so the code keeps its size and no jump needs relocation.
+void GDScriptByteCodeGenerator::fuse_superinstructions() {
+	for (const FusionCandidate &candidate : fusion_candidates) {
+		const int pos = candidate.position;
+		ERR_CONTINUE(pos + 8 > opcodes.size() || opcodes[pos] != GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+
+		const int result = opcodes[pos + 3];
+		bool valid = false;
+		switch (candidate.opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN:
+				valid = opcodes[pos + 5] == GDScriptFunction::OPCODE_ASSIGN && opcodes[pos + 7] == result;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+				valid = opcodes[pos + 5] == GDScriptFunction::OPCODE_JUMP_IF && opcodes[pos + 6] == result;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+				valid = opcodes[pos + 5] == GDScriptFunction::OPCODE_JUMP_IF_NOT && opcodes[pos + 6] == result;
+				break;
+			default:
+				break;
+		}
+		ERR_CONTINUE_MSG(!valid, "Compiler bug: invalid superinstruction candidate.");
+		opcodes.write[pos] = candidate.opcode;
+	}
+	fusion_candidates.clear();
+}
+
 void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) {
 	function = memnew(GDScriptFunction);
 
@@ -193,6 +236,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		fuse_superinstructions();
+	}
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -397,6 +444,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	}
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
+	function->_create_inline_caches(inline_cache_count);
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -556,6 +604,8 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		last_validated_operator_pos = opcodes.size();
+		last_validated_operator_target = p_target;
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -573,6 +623,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(Address());
 	append(p_target);
 	append(p_operator);
+	function->operator_cache_offsets.push_back(opcodes.size());
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -613,6 +664,8 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_validated_operator_pos = opcodes.size();
+		last_validated_operator_target = p_target;
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -630,6 +683,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append(p_right_operand);
 	append(p_target);
 	append(p_operator);
+	function->operator_cache_offsets.push_back(opcodes.size());
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -691,6 +745,7 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_left_operand);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
@@ -698,6 +753,7 @@ void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_ope
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_right_operand);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
@@ -718,9 +774,11 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	logic_op_jump_pos2.pop_back();
 	append_opcode(GDScriptFunction::OPCODE_ASSIGN_FALSE);
 	append(p_target);
+	mark_jump_label();
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF, p_left_operand);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
 	append(p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
@@ -728,6 +786,7 @@ void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_oper
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF, p_right_operand);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
 	append(p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
@@ -748,6 +807,7 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	logic_op_jump_pos2.pop_back();
 	append_opcode(GDScriptFunction::OPCODE_ASSIGN_TRUE);
 	append(p_target);
+	mark_jump_label();
 }
 
 void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
@@ -755,6 +815,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
@@ -786,9 +847,50 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Packed arrays whose elements are accessed with dedicated opcodes instead of the validated indexed getter and setter.
+static bool _get_packed_array_index_opcodes(Variant::Type p_type, GDScriptFunction::Opcode &r_set, GDScriptFunction::Opcode &r_get) {
+	switch (p_type) {
+		case Variant::PACKED_INT32_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+			return true;
+		case Variant::PACKED_INT64_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+			return true;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+			return true;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+			return true;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY;
+			return true;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			r_set = GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY;
+			r_get = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY;
+			return true;
+		default:
+			return false;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
+		GDScriptFunction::Opcode set_opcode;
+		GDScriptFunction::Opcode get_opcode;
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && _get_packed_array_index_opcodes(p_target.type.builtin_type, set_opcode, get_opcode) &&
+				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
+			append_opcode(set_opcode);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
 			Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(p_target.type.builtin_type);
@@ -817,7 +919,15 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
+		GDScriptFunction::Opcode set_opcode;
+		GDScriptFunction::Opcode get_opcode;
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && _get_packed_array_index_opcodes(p_source.type.builtin_type, set_opcode, get_opcode)) {
+			append_opcode(get_opcode);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
 			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED);
@@ -859,6 +969,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +988,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -993,6 +1105,7 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_source);
 		append(p_target.type.builtin_type);
 	} else {
+		add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN, p_source);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
@@ -1021,11 +1134,13 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	mark_jump_label();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	function->global_index_offsets.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1091,6 +1206,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1116,6 +1232,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1350,6 +1467,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1363,6 +1481,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1376,6 +1495,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1510,6 +1630,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1730,6 +1851,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	mark_jump_label();
 	append_opcode(iterate_opcode);
 	append(counter);
 	if (p_is_range) {
@@ -1741,6 +1863,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	append(p_use_conversion ? temp : p_variable);
 	for_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
+	mark_jump_label(); // Target of the jump over 'continue' code.
 
 	if (p_use_conversion) {
 		write_assign_with_conversion(p_variable, temp);
@@ -1782,10 +1905,12 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	mark_jump_label();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	add_fusion_candidate(GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, p_condition);
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -97,6 +97,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -160,6 +161,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Superinstruction candidates, fused in `write_end()` once temporaries are resolved.
+	struct FusionCandidate {
+		int position = 0;
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_END;
+	};
+	Vector<FusionCandidate> fusion_candidates;
+	int last_validated_operator_pos = -1;
+	Address last_validated_operator_target;
+	int last_jump_label = -1; // Latest position known to be a jump target.
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -389,6 +400,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(p_code);
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void append(const Address &p_address) {
 		opcodes.push_back(address_of(p_address));
 	}
@@ -451,8 +466,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		mark_jump_label();
 	}
 
+	void mark_jump_label() {
+		last_jump_label = opcodes.size();
+	}
+
+	void add_fusion_candidate(GDScriptFunction::Opcode p_fused_opcode, const Address &p_operand);
+	void fuse_superinstructions();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
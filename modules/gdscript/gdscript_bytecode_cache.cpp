@@ -0,0 +1,1900 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_inline_cache.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+// Reverse lookups from the validated function pointers stored in compiled functions to
+// descriptors that stay stable between runs of the same engine build.
+struct GDScriptBytecodeCache::Descriptors {
+	RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+};
+
+GDScriptBytecodeCache::Descriptors *GDScriptBytecodeCache::descriptors = nullptr;
+Mutex GDScriptBytecodeCache::descriptors_mutex;
+Mutex GDScriptBytecodeCache::hashes_mutex;
+HashMap<String, uint64_t> GDScriptBytecodeCache::file_hashes;
+uint64_t GDScriptBytecodeCache::environment_key = 0;
+bool GDScriptBytecodeCache::environment_key_valid = false;
+
+static constexpr uint32_t CACHE_MAGIC = 0x43424447; // "GDBC".
+static constexpr int MAX_VALUE_DEPTH = 64;
+
+static uint64_t _hash_buffer(const uint8_t *p_data, int64_t p_size) {
+	return (uint64_t(hash_murmur3_buffer(p_data, p_size)) << 32) | hash_djb2_buffer(p_data, p_size);
+}
+
+template <typename K, typename V>
+static void _add_descriptor(RBMap<K, V> &r_map, K p_key, const V &p_value) {
+	// Identical code may be folded into one function; any descriptor resolving to it is valid.
+	if (p_key && !r_map.has(p_key)) {
+		r_map.insert(p_key, p_value);
+	}
+}
+
+template <typename T, typename P>
+static void _bind_table(Vector<T> &p_table, int &r_count, P &r_ptr) {
+	r_count = p_table.size();
+	r_ptr = p_table.is_empty() ? nullptr : p_table.ptrw();
+}
+
+static bool _has_static_data(const GDScriptParser::ClassNode *p_class) {
+	if (p_class->has_static_data) {
+		return true;
+	}
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS && _has_static_data(member.m_class)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const GDScriptBytecodeCache::Descriptors &GDScriptBytecodeCache::_get_descriptors() {
+	MutexLock lock(descriptors_mutex);
+	if (descriptors) {
+		return *descriptors;
+	}
+
+	descriptors = memnew(Descriptors);
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				_add_descriptor(descriptors->operators, Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j)), uint32_t((op << 16) | (i << 8) | j));
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			_add_descriptor(descriptors->setters, Variant::get_member_validated_setter(type, member), Pair<Variant::Type, StringName>(type, member));
+			_add_descriptor(descriptors->getters, Variant::get_member_validated_getter(type, member), Pair<Variant::Type, StringName>(type, member));
+		}
+
+		_add_descriptor(descriptors->keyed_setters, Variant::get_member_validated_keyed_setter(type), type);
+		_add_descriptor(descriptors->keyed_getters, Variant::get_member_validated_keyed_getter(type), type);
+		_add_descriptor(descriptors->indexed_setters, Variant::get_member_validated_indexed_setter(type), type);
+		_add_descriptor(descriptors->indexed_getters, Variant::get_member_validated_indexed_getter(type), type);
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			_add_descriptor(descriptors->builtin_methods, Variant::get_validated_builtin_method(type, method), Pair<Variant::Type, StringName>(type, method));
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			_add_descriptor(descriptors->constructors, Variant::get_validated_constructor(type, j), Pair<Variant::Type, int>(type, j));
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		_add_descriptor(descriptors->utilities, Variant::get_validated_utility_function(utility), utility);
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		_add_descriptor(descriptors->gds_utilities, GDScriptUtilityFunctions::get_function(utility), utility);
+	}
+
+	return *descriptors;
+}
+
+String GDScriptBytecodeCache::_get_cache_file(const String &p_path) {
+	return GDScriptLanguage::get_singleton()->get_bytecode_cache_path().path_join(p_path.md5_text() + ".gdbc");
+}
+
+uint64_t GDScriptBytecodeCache::_get_engine_key() {
+	// Anything that changes the meaning of the stored code or pointer descriptors must be part of this key.
+	String key = vformat("%s|%s|%d|%d|%d|%d|%d|%d", GODOT_VERSION_FULL_BUILD, GODOT_VERSION_HASH, FORMAT_VERSION, GDScriptFunction::OPCODE_END, Variant::VARIANT_MAX, Variant::OP_MAX, (int)sizeof(void *), (int)sizeof(real_t));
+#ifdef DEBUG_ENABLED
+	key += "|debug";
+#endif
+#ifdef TOOLS_ENABLED
+	key += "|tools";
+#endif
+	return key.hash64();
+}
+
+uint64_t GDScriptBytecodeCache::_get_environment_key() {
+	MutexLock lock(hashes_mutex);
+	if (environment_key_valid) {
+		return environment_key;
+	}
+
+	// Global class names and autoloads change how identifiers resolve without touching the scripts using them.
+	String key = GLOBAL_GET("application/config/version");
+
+	List<StringName> global_classes;
+	ScriptServer::get_global_class_list(&global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	for (const StringName &global_class : global_classes) {
+		key += "|" + String(global_class) + "=" + ScriptServer::get_global_class_path(global_class);
+	}
+
+	List<StringName> autoloads;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		autoloads.push_back(E.key);
+	}
+	autoloads.sort_custom<StringName::AlphCompare>();
+	for (const StringName &autoload : autoloads) {
+		const ProjectSettings::AutoloadInfo info = ProjectSettings::get_singleton()->get_autoload(autoload);
+		key += "|" + String(autoload) + (info.is_singleton ? "*" : "") + "=" + info.path;
+	}
+
+	environment_key = key.hash64();
+	environment_key_valid = true;
+	return environment_key;
+}
+
+uint64_t GDScriptBytecodeCache::_get_file_hash(const String &p_path) {
+	{
+		MutexLock lock(hashes_mutex);
+		if (const uint64_t *hash = file_hashes.getptr(p_path)) {
+			return *hash;
+		}
+	}
+
+	uint64_t hash = 0;
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (FileAccess::exists(remapped_path)) {
+		Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(remapped_path);
+		hash = _hash_buffer(bytes.ptr(), bytes.size());
+	}
+
+	MutexLock lock(hashes_mutex);
+	file_hashes[p_path] = hash;
+	return hash;
+}
+
+uint64_t GDScriptBytecodeCache::_get_script_source_hash(const GDScript *p_script) {
+	if (!p_script->binary_tokens.is_empty()) {
+		return _hash_buffer(p_script->binary_tokens.ptr(), p_script->binary_tokens.size());
+	}
+	return p_script->source.hash64();
+}
+
+void GDScriptBytecodeCache::_collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths) {
+	// Interfaces of the scripts the analyzer looked at shape the generated code, so every
+	// parser reached from this one is recorded, not only the direct dependencies.
+	HashSet<String> visited;
+	List<GDScriptParser *> pending;
+	pending.push_back(p_parser);
+
+	while (!pending.is_empty()) {
+		GDScriptParser *parser = pending.front()->get();
+		pending.pop_front();
+
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : parser->get_depended_parsers()) {
+			r_paths.insert(E.key);
+			if (visited.has(E.key)) {
+				continue;
+			}
+			visited.insert(E.key);
+			if (E.value.is_valid() && E.value->get_status() != GDScriptParserRef::EMPTY) {
+				pending.push_back(E.value->get_parser());
+			}
+		}
+	}
+}
+
+/* Writing */
+
+void GDScriptBytecodeCache::_put_bytes(const uint8_t *p_data, int64_t p_size) {
+	const int64_t pos = buffer.size();
+	buffer.resize(pos + p_size);
+	if (p_size > 0) {
+		memcpy(buffer.ptrw() + pos, p_data, p_size);
+	}
+}
+
+void GDScriptBytecodeCache::_put_u8(uint8_t p_value) {
+	buffer.push_back(p_value);
+}
+
+void GDScriptBytecodeCache::_put_u32(uint32_t p_value) {
+	uint8_t bytes[4];
+	encode_uint32(p_value, bytes);
+	_put_bytes(bytes, 4);
+}
+
+void GDScriptBytecodeCache::_put_u64(uint64_t p_value) {
+	uint8_t bytes[8];
+	encode_uint64(p_value, bytes);
+	_put_bytes(bytes, 8);
+}
+
+void GDScriptBytecodeCache::_put_string(const String &p_string) {
+	const CharString utf8 = p_string.utf8();
+	_put_u32(utf8.length());
+	_put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+void GDScriptBytecodeCache::_put_value(const Variant &p_value) {
+	if (value_depth >= MAX_VALUE_DEPTH) {
+		failed = true;
+		return;
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				_put_u8(VALUE_NULL_OBJECT);
+			} else if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+				_put_u8(VALUE_NATIVE_CLASS);
+				_put_string(native_class->get_name());
+			} else if (const Script *script = Object::cast_to<Script>(object)) {
+				_put_u8(VALUE_GDSCRIPT);
+				_put_script(script);
+			} else if (const Resource *resource = Object::cast_to<Resource>(object)) {
+				// Preloaded resources are loaded again by path; built-in ones cannot be.
+				if (resource->get_path().is_empty() || resource->is_built_in()) {
+					failed = true;
+					return;
+				}
+				_put_u8(VALUE_RESOURCE);
+				_put_string(resource->get_path());
+			} else {
+				failed = true;
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			_put_u8(VALUE_ARRAY);
+			_put_u8(array.is_read_only());
+			_put_u8(array.is_typed());
+			value_depth++;
+			if (array.is_typed()) {
+				_put_u8(array.get_typed_builtin());
+				_put_string(array.get_typed_class_name());
+				_put_value(array.get_typed_script());
+			}
+			_put_u32(array.size());
+			for (const Variant &element : array) {
+				_put_value(element);
+			}
+			value_depth--;
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			_put_u8(VALUE_DICTIONARY);
+			_put_u8(dictionary.is_read_only());
+			_put_u8(dictionary.is_typed());
+			value_depth++;
+			if (dictionary.is_typed()) {
+				_put_u8(dictionary.get_typed_key_builtin());
+				_put_string(dictionary.get_typed_key_class_name());
+				_put_value(dictionary.get_typed_key_script());
+				_put_u8(dictionary.get_typed_value_builtin());
+				_put_string(dictionary.get_typed_value_class_name());
+				_put_value(dictionary.get_typed_value_script());
+			}
+			_put_u32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				_put_value(kv.key);
+				_put_value(kv.value);
+			}
+			value_depth--;
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			// Only meaningful within the process that created them.
+			failed = true;
+		} break;
+		default: {
+			int len = 0;
+			if (encode_variant(p_value, nullptr, len, false) != OK) {
+				failed = true;
+				return;
+			}
+			_put_u8(VALUE_PLAIN);
+			_put_u32(len);
+			const int64_t pos = buffer.size();
+			buffer.resize(pos + len);
+			encode_variant(p_value, buffer.ptrw() + pos, len, false);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::_put_script(const Script *p_script) {
+	const GDScript *script = Object::cast_to<GDScript>(p_script);
+	if (script == nullptr || script->path.is_empty() || script->path.contains("::")) {
+		failed = true;
+		return;
+	}
+	_put_string(script->path);
+	_put_string(script->fully_qualified_name);
+	if (script->path != main_script->path) {
+		referenced_scripts.insert(script->path);
+	}
+}
+
+void GDScriptBytecodeCache::_put_data_type(const GDScriptDataType &p_type) {
+	_put_u8(p_type.kind);
+	_put_u8(p_type.has_type);
+	_put_u8(p_type.builtin_type);
+	_put_string(p_type.native_type);
+	_put_u8(p_type.script_type != nullptr);
+	if (p_type.script_type != nullptr) {
+		_put_script(p_type.script_type);
+		_put_u8(p_type.script_type_ref.is_valid());
+	}
+	_put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_put_data_type(element_type);
+	}
+}
+
+void GDScriptBytecodeCache::_put_member_info(const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	_put_string(p_name);
+	_put_u32(p_info.index);
+	_put_string(p_info.setter);
+	_put_string(p_info.getter);
+	_put_data_type(p_info.data_type);
+	_put_value(Dictionary(p_info.property_info));
+}
+
+void GDScriptBytecodeCache::_put_function(const GDScript *p_script, const GDScriptFunction *p_function) {
+	const Descriptors &desc = _get_descriptors();
+
+	_put_string(p_function->name);
+	_put_u8(p_function->_static);
+	_put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &type : p_function->argument_types) {
+		_put_data_type(type);
+	}
+	_put_data_type(p_function->return_type);
+	_put_value(Dictionary(p_function->method_info));
+	_put_value(p_function->rpc_config);
+
+	_put_u32(p_function->_initial_line);
+	_put_u32(p_function->_argument_count);
+	_put_u32(p_function->_vararg_index);
+	_put_u32(p_function->_stack_size);
+	_put_u32(p_function->_instruction_args_size);
+	_put_u32(p_function->_inline_cache_count);
+
+	_put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		_put_u32(E.key);
+		_put_u8(E.value);
+	}
+
+	// Runtime caches in the code are reset and global indices are stored by name, since
+	// both depend on the process that compiled the function.
+	Vector<int> code = p_function->code;
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	for (int offset : p_function->operator_cache_offsets) {
+		if (offset < 0 || offset + 2 + pointer_size > code.size()) {
+			failed = true;
+			return;
+		}
+		for (int i = 0; i < 2 + pointer_size; i++) {
+			code.write[offset + i] = 0;
+		}
+	}
+
+	if (!p_function->global_index_offsets.is_empty() && global_names_by_index.is_empty()) {
+		const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+		global_names_by_index.resize(language->get_global_array_size());
+		for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+			global_names_by_index.write[E.value] = E.key;
+		}
+	}
+	Vector<StringName> global_index_names;
+	for (int offset : p_function->global_index_offsets) {
+		const int index = (offset >= 0 && offset < code.size()) ? code[offset] : -1;
+		if (index < 0 || index >= global_names_by_index.size() || global_names_by_index[index] == StringName()) {
+			failed = true;
+			return;
+		}
+		global_index_names.push_back(global_names_by_index[index]);
+		code.write[offset] = 0;
+	}
+
+	_put_u32(code.size());
+	for (int word : code) {
+		_put_u32(word);
+	}
+	_put_u32(p_function->operator_cache_offsets.size());
+	for (int offset : p_function->operator_cache_offsets) {
+		_put_u32(offset);
+	}
+	_put_u32(p_function->global_index_offsets.size());
+	for (int i = 0; i < p_function->global_index_offsets.size(); i++) {
+		_put_u32(p_function->global_index_offsets[i]);
+		_put_string(global_index_names[i]);
+	}
+
+	_put_u32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		_put_u32(address);
+	}
+	_put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_put_value(constant);
+	}
+	_put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		_put_string(global_name);
+	}
+
+#define PUT_DESCRIPTORS(m_table, m_map, m_put)        \
+	_put_u32(p_function->m_table.size());             \
+	for (const auto &func : p_function->m_table) {   \
+		const auto *E = desc.m_map.find(func);        \
+		if (E == nullptr) {                           \
+			failed = true;                            \
+			return;                                   \
+		}                                             \
+		const auto &descriptor = E->value();          \
+		m_put;                                        \
+	}
+
+	PUT_DESCRIPTORS(operator_funcs, operators, _put_u32(descriptor));
+	PUT_DESCRIPTORS(setters, setters, (_put_u8(descriptor.first), _put_string(descriptor.second)));
+	PUT_DESCRIPTORS(getters, getters, (_put_u8(descriptor.first), _put_string(descriptor.second)));
+	PUT_DESCRIPTORS(keyed_setters, keyed_setters, _put_u8(descriptor));
+	PUT_DESCRIPTORS(keyed_getters, keyed_getters, _put_u8(descriptor));
+	PUT_DESCRIPTORS(indexed_setters, indexed_setters, _put_u8(descriptor));
+	PUT_DESCRIPTORS(indexed_getters, indexed_getters, _put_u8(descriptor));
+	PUT_DESCRIPTORS(builtin_methods, builtin_methods, (_put_u8(descriptor.first), _put_string(descriptor.second)));
+	PUT_DESCRIPTORS(constructors, constructors, (_put_u8(descriptor.first), _put_u32(descriptor.second)));
+	PUT_DESCRIPTORS(utilities, utilities, _put_string(descriptor));
+	PUT_DESCRIPTORS(gds_utilities, gds_utilities, _put_string(descriptor));
+
+#undef PUT_DESCRIPTORS
+
+	_put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		_put_string(method->get_instance_class());
+		_put_string(method->get_name());
+	}
+
+	_put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = p_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		_put_u8(info != nullptr);
+		if (info != nullptr) {
+			_put_u32(info->capture_count);
+			_put_u8(info->use_self);
+		}
+		_put_function(p_script, lambda);
+	}
+
+#ifdef DEBUG_ENABLED
+	const Vector<String> *debug_names[] = {
+		&p_function->operator_names,
+		&p_function->setter_names,
+		&p_function->getter_names,
+		&p_function->builtin_methods_names,
+		&p_function->constructors_names,
+		&p_function->utilities_names,
+		&p_function->gds_utilities_names,
+	};
+	for (const Vector<String> *names : debug_names) {
+		_put_u32(names->size());
+		for (const String &debug_name : *names) {
+			_put_string(debug_name);
+		}
+	}
+#endif
+}
+
+void GDScriptBytecodeCache::_put_class(const GDScript *p_script) {
+	_put_u8(p_script->tool);
+	_put_u8(p_script->_is_abstract);
+	_put_string(p_script->native.is_valid() ? String(p_script->native->get_name()) : String());
+	_put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		_put_script(p_script->base.ptr());
+	}
+
+	_put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		_put_member_info(E.key, E.value);
+		_put_u8(p_script->members.has(E.key));
+	}
+	_put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		_put_member_info(E.key, E.value);
+	}
+
+	_put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		_put_string(E.key);
+		_put_value(E.value);
+	}
+	_put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		_put_string(E.key);
+		_put_value(Dictionary(E.value));
+	}
+	_put_value(p_script->rpc_config);
+
+	_put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_put_function(p_script, E.value);
+	}
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		_put_u8(function != nullptr);
+		if (function != nullptr) {
+			_put_function(p_script, function);
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	_put_u32(p_script->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		_put_string(E.key);
+		_put_value(E.value);
+	}
+#endif
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_put_class(E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_put_skeleton(const GDScript *p_script) {
+	_put_string(p_script->global_name);
+	_put_string(p_script->simplified_icon_path);
+	_put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_put_string(E.key);
+		_put_string(E.value->fully_qualified_name);
+		_put_skeleton(E.value.ptr());
+	}
+}
+
+/* Reading */
+
+bool GDScriptBytecodeCache::_can_read(int64_t p_size) {
+	if (failed || p_size < 0 || read_pos + p_size > read_size) {
+		failed = true;
+		return false;
+	}
+	return true;
+}
+
+uint32_t GDScriptBytecodeCache::_get_count(int64_t p_min_element_size) {
+	// Rejects counts the remaining data cannot hold, so corrupted files never cause huge allocations.
+	const uint32_t count = _get_u32();
+	if (!_can_read(int64_t(count) * p_min_element_size)) {
+		return 0;
+	}
+	return count;
+}
+
+uint8_t GDScriptBytecodeCache::_get_u8() {
+	if (!_can_read(1)) {
+		return 0;
+	}
+	return read_ptr[read_pos++];
+}
+
+uint32_t GDScriptBytecodeCache::_get_u32() {
+	if (!_can_read(4)) {
+		return 0;
+	}
+	const uint32_t value = decode_uint32(read_ptr + read_pos);
+	read_pos += 4;
+	return value;
+}
+
+uint64_t GDScriptBytecodeCache::_get_u64() {
+	if (!_can_read(8)) {
+		return 0;
+	}
+	const uint64_t value = decode_uint64(read_ptr + read_pos);
+	read_pos += 8;
+	return value;
+}
+
+String GDScriptBytecodeCache::_get_string() {
+	const uint32_t len = _get_u32();
+	if (len == 0 || !_can_read(len)) {
+		return String();
+	}
+	String string = String::utf8((const char *)read_ptr + read_pos, len);
+	read_pos += len;
+	return string;
+}
+
+Variant GDScriptBytecodeCache::_get_value() {
+	if (value_depth >= MAX_VALUE_DEPTH) {
+		failed = true;
+		return Variant();
+	}
+
+	switch (_get_u8()) {
+		case VALUE_PLAIN: {
+			const uint32_t len = _get_u32();
+			if (!_can_read(len)) {
+				return Variant();
+			}
+			Variant value;
+			if (decode_variant(value, read_ptr + read_pos, len, nullptr, false) != OK) {
+				failed = true;
+				return Variant();
+			}
+			read_pos += len;
+			return value;
+		}
+		case VALUE_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		}
+		case VALUE_NATIVE_CLASS: {
+			const StringName name = _get_string();
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			const int *index = language->get_global_map().getptr(name);
+			if (index == nullptr || Object::cast_to<GDScriptNativeClass>(language->get_global_array()[*index]) == nullptr) {
+				failed = true;
+				return Variant();
+			}
+			return language->get_global_array()[*index];
+		}
+		case VALUE_GDSCRIPT: {
+			GDScript *script = _get_script();
+			if (script == nullptr) {
+				return Variant();
+			}
+			return Ref<GDScript>(script);
+		}
+		case VALUE_RESOURCE: {
+			const String path = _get_string();
+			if (failed) {
+				return Variant();
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				failed = true;
+			}
+			return resource;
+		}
+		case VALUE_ARRAY: {
+			const bool read_only = _get_u8();
+			const bool typed = _get_u8();
+			value_depth++;
+			uint32_t type = Variant::NIL;
+			StringName class_name;
+			Variant script;
+			if (typed) {
+				type = _get_u8();
+				class_name = _get_string();
+				script = _get_value();
+			}
+			Array array;
+			const uint32_t size = _get_count(1);
+			for (uint32_t i = 0; i < size && !failed; i++) {
+				array.push_back(_get_value());
+			}
+			value_depth--;
+			if (failed) {
+				return Variant();
+			}
+			if (typed) {
+				array = Array(array, type, class_name, script);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VALUE_DICTIONARY: {
+			const bool read_only = _get_u8();
+			const bool typed = _get_u8();
+			value_depth++;
+			uint32_t key_type = Variant::NIL;
+			uint32_t value_type = Variant::NIL;
+			StringName key_class_name;
+			StringName value_class_name;
+			Variant key_script;
+			Variant value_script;
+			if (typed) {
+				key_type = _get_u8();
+				key_class_name = _get_string();
+				key_script = _get_value();
+				value_type = _get_u8();
+				value_class_name = _get_string();
+				value_script = _get_value();
+			}
+			Dictionary dictionary;
+			const uint32_t size = _get_count(2);
+			for (uint32_t i = 0; i < size && !failed; i++) {
+				const Variant key = _get_value();
+				dictionary[key] = _get_value();
+			}
+			value_depth--;
+			if (failed) {
+				return Variant();
+			}
+			if (typed) {
+				dictionary = Dictionary(dictionary, key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		default: {
+			failed = true;
+			return Variant();
+		}
+	}
+}
+
+GDScript *GDScriptBytecodeCache::_get_script() {
+	const String path = _get_string();
+	const String fully_qualified_name = _get_string();
+	if (failed) {
+		return nullptr;
+	}
+
+	GDScript *root = main_script;
+	if (path != main_script->path) {
+		// Same as the compiler: other scripts are only needed shallow here, the owner
+		// finishes compiling them once it is done.
+		Error err = OK;
+		Ref<GDScript> root_ref = GDScriptCache::get_shallow_script(path, err, main_script->path);
+		if (err != OK || root_ref.is_null()) {
+			failed = true;
+			return nullptr;
+		}
+		root = root_ref.ptr();
+	}
+
+	GDScript *script = root->find_class(fully_qualified_name);
+	if (script == nullptr) {
+		failed = true;
+	}
+	return script;
+}
+
+GDScriptDataType GDScriptBytecodeCache::_get_data_type() {
+	GDScriptDataType type;
+	type.kind = GDScriptDataType::Kind(_get_u8());
+	type.has_type = _get_u8();
+	type.builtin_type = Variant::Type(_get_u8());
+	type.native_type = _get_string();
+	if (type.kind > GDScriptDataType::GDSCRIPT || type.builtin_type >= Variant::VARIANT_MAX) {
+		failed = true;
+		return GDScriptDataType();
+	}
+	if (_get_u8()) {
+		GDScript *script = _get_script();
+		const bool strong = _get_u8();
+		if (script != nullptr) {
+			type.script_type = script;
+			if (strong) {
+				type.script_type_ref = Ref<Script>(script);
+			}
+		}
+	}
+	const uint32_t element_count = _get_count(1);
+	for (uint32_t i = 0; i < element_count && !failed; i++) {
+		type.container_element_types.push_back(_get_data_type());
+	}
+	return type;
+}
+
+GDScript::MemberInfo GDScriptBytecodeCache::_get_member_info(StringName &r_name) {
+	GDScript::MemberInfo info;
+	r_name = _get_string();
+	info.index = _get_u32();
+	info.setter = _get_string();
+	info.getter = _get_string();
+	info.data_type = _get_data_type();
+	info.property_info = PropertyInfo::from_dict(_get_value());
+	return info;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_get_function(GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = _get_string();
+	function->_static = _get_u8();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	const uint32_t argument_count = _get_count(1);
+	for (uint32_t i = 0; i < argument_count && !failed; i++) {
+		function->argument_types.push_back(_get_data_type());
+	}
+	function->return_type = _get_data_type();
+	function->method_info = MethodInfo::from_dict(_get_value());
+	function->rpc_config = _get_value();
+
+	function->_initial_line = int32_t(_get_u32());
+	function->_argument_count = int32_t(_get_u32());
+	function->_vararg_index = int32_t(_get_u32());
+	function->_stack_size = int32_t(_get_u32());
+	function->_instruction_args_size = int32_t(_get_u32());
+	const uint32_t inline_cache_count = _get_u32();
+
+	const uint32_t temporary_count = _get_count(5);
+	for (uint32_t i = 0; i < temporary_count; i++) {
+		const int slot = int32_t(_get_u32());
+		const Variant::Type type = Variant::Type(_get_u8());
+		function->temporary_slots[slot] = type;
+	}
+
+	const uint32_t code_size = _get_count(4);
+	function->code.resize(code_size);
+	for (uint32_t i = 0; i < code_size; i++) {
+		function->code.write[i] = int32_t(_get_u32());
+	}
+	// Each cache belongs to an instruction, so there can't be more than code words.
+	if (inline_cache_count > code_size) {
+		failed = true;
+	} else {
+		function->_create_inline_caches(inline_cache_count);
+	}
+
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	const uint32_t operator_cache_count = _get_count(4);
+	for (uint32_t i = 0; i < operator_cache_count; i++) {
+		const int offset = int32_t(_get_u32());
+		if (offset < 0 || offset + 2 + pointer_size > int(code_size)) {
+			failed = true;
+			break;
+		}
+		function->operator_cache_offsets.push_back(offset);
+	}
+
+	const uint32_t global_index_count = _get_count(8);
+	for (uint32_t i = 0; i < global_index_count && !failed; i++) {
+		const int offset = int32_t(_get_u32());
+		const StringName global_name = _get_string();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(global_name);
+		if (offset < 0 || offset >= int(code_size) || index == nullptr) {
+			failed = true;
+			break;
+		}
+		function->code.write[offset] = *index;
+		function->global_index_offsets.push_back(offset);
+	}
+
+	const uint32_t default_argument_count = _get_count(4);
+	for (uint32_t i = 0; i < default_argument_count; i++) {
+		function->default_arguments.push_back(int32_t(_get_u32()));
+	}
+	const uint32_t constant_count = _get_count(1);
+	for (uint32_t i = 0; i < constant_count && !failed; i++) {
+		function->constants.push_back(_get_value());
+	}
+	const uint32_t global_name_count = _get_count(4);
+	for (uint32_t i = 0; i < global_name_count; i++) {
+		function->global_names.push_back(_get_string());
+	}
+
+#define GET_FUNCTIONS(m_table, m_min_size, m_get)                 \
+	{                                                             \
+		const uint32_t count = _get_count(m_min_size);            \
+		for (uint32_t i = 0; i < count && !failed; i++) {         \
+			auto func = m_get;                                    \
+			if (func == nullptr) {                                \
+				failed = true;                                    \
+			}                                                     \
+			function->m_table.push_back(func);                    \
+		}                                                         \
+	}
+
+	GET_FUNCTIONS(operator_funcs, 4, ([this]() {
+		const uint32_t op = _get_u32();
+		const uint32_t a = (op >> 8) & 0xFF;
+		const uint32_t b = op & 0xFF;
+		if ((op >> 16) >= Variant::OP_MAX || a >= Variant::VARIANT_MAX || b >= Variant::VARIANT_MAX) {
+			return Variant::ValidatedOperatorEvaluator(nullptr);
+		}
+		return Variant::get_validated_operator_evaluator(Variant::Operator(op >> 16), Variant::Type(a), Variant::Type(b));
+	}()));
+	GET_FUNCTIONS(setters, 5, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		const StringName member = _get_string();
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(type, member) : nullptr;
+	}()));
+	GET_FUNCTIONS(getters, 5, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		const StringName member = _get_string();
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(type, member) : nullptr;
+	}()));
+	GET_FUNCTIONS(keyed_setters, 1, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_setter(type) : nullptr;
+	}()));
+	GET_FUNCTIONS(keyed_getters, 1, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_getter(type) : nullptr;
+	}()));
+	GET_FUNCTIONS(indexed_setters, 1, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_setter(type) : nullptr;
+	}()));
+	GET_FUNCTIONS(indexed_getters, 1, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_getter(type) : nullptr;
+	}()));
+	GET_FUNCTIONS(builtin_methods, 5, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		const StringName method = _get_string();
+		return type < Variant::VARIANT_MAX ? Variant::get_validated_builtin_method(type, method) : nullptr;
+	}()));
+	GET_FUNCTIONS(constructors, 5, ([this]() {
+		const Variant::Type type = Variant::Type(_get_u8());
+		const int index = int32_t(_get_u32());
+		if (type >= Variant::VARIANT_MAX || index < 0 || index >= Variant::get_constructor_count(type)) {
+			return Variant::ValidatedConstructor(nullptr);
+		}
+		return Variant::get_validated_constructor(type, index);
+	}()));
+	GET_FUNCTIONS(utilities, 4, Variant::get_validated_utility_function(_get_string()));
+	GET_FUNCTIONS(gds_utilities, 4, GDScriptUtilityFunctions::get_function(_get_string()));
+	GET_FUNCTIONS(methods, 8, ([this]() {
+		const StringName class_name = _get_string();
+		const StringName method_name = _get_string();
+		return ClassDB::get_method(class_name, method_name);
+	}()));
+
+#undef GET_FUNCTIONS
+
+	// Lambdas are owned by their parent function, so they are released along with it on failure.
+	const uint32_t lambda_count = _get_count(2);
+	for (uint32_t i = 0; i < lambda_count && !failed; i++) {
+		const bool has_info = _get_u8();
+		GDScript::LambdaInfo info = {};
+		if (has_info) {
+			info.capture_count = int32_t(_get_u32());
+			info.use_self = _get_u8();
+		}
+		GDScriptFunction *lambda = _get_function(p_script, r_lambda_info);
+		function->lambdas.push_back(lambda);
+		if (has_info) {
+			r_lambda_info.insert(lambda, info);
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	Vector<String> *debug_names[] = {
+		&function->operator_names,
+		&function->setter_names,
+		&function->getter_names,
+		&function->builtin_methods_names,
+		&function->constructors_names,
+		&function->utilities_names,
+		&function->gds_utilities_names,
+	};
+	for (Vector<String> *names : debug_names) {
+		const uint32_t count = _get_count(4);
+		for (uint32_t i = 0; i < count; i++) {
+			names->push_back(_get_string());
+		}
+	}
+#endif
+
+	// Same layout as GDScriptByteCodeGenerator::write_end().
+	_bind_table(function->code, function->_code_size, function->_code_ptr);
+	_bind_table(function->constants, function->_constant_count, function->_constants_ptr);
+	_bind_table(function->global_names, function->_global_names_count, function->_global_names_ptr);
+	_bind_table(function->operator_funcs, function->_operator_funcs_count, function->_operator_funcs_ptr);
+	_bind_table(function->setters, function->_setters_count, function->_setters_ptr);
+	_bind_table(function->getters, function->_getters_count, function->_getters_ptr);
+	_bind_table(function->keyed_setters, function->_keyed_setters_count, function->_keyed_setters_ptr);
+	_bind_table(function->keyed_getters, function->_keyed_getters_count, function->_keyed_getters_ptr);
+	_bind_table(function->indexed_setters, function->_indexed_setters_count, function->_indexed_setters_ptr);
+	_bind_table(function->indexed_getters, function->_indexed_getters_count, function->_indexed_getters_ptr);
+	_bind_table(function->builtin_methods, function->_builtin_methods_count, function->_builtin_methods_ptr);
+	_bind_table(function->constructors, function->_constructors_count, function->_constructors_ptr);
+	_bind_table(function->utilities, function->_utilities_count, function->_utilities_ptr);
+	_bind_table(function->gds_utilities, function->_gds_utilities_count, function->_gds_utilities_ptr);
+	_bind_table(function->methods, function->_methods_count, function->_methods_ptr);
+	_bind_table(function->lambdas, function->_lambdas_count, function->_lambdas_ptr);
+	_bind_table(function->default_arguments, function->_default_arg_count, function->_default_arg_ptr);
+	if (function->_default_arg_count > 0) {
+		function->_default_arg_count--;
+	}
+
+	return function;
+}
+
+bool GDScriptBytecodeCache::_validate_function(const GDScriptFunction *p_function, int p_member_count, const HashMap<const GDScript *, int> &p_static_counts) {
+	using GDF = GDScriptFunction;
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	if (code == nullptr || code_size == 0 || code[code_size - 1] != GDF::OPCODE_END) {
+		return false;
+	}
+	// The VM copies arguments and initializes temporaries in the stack before running any code.
+	if (p_function->_argument_count < 0 || p_function->argument_types.size() < p_function->_argument_count) {
+		return false;
+	}
+	if (p_function->_stack_size < GDF::FIXED_ADDRESSES_MAX + p_function->_argument_count || p_function->_stack_size > GDF::ADDR_MASK) {
+		return false;
+	}
+	if (p_function->is_vararg() && (p_function->_vararg_index < GDF::FIXED_ADDRESSES_MAX || p_function->_vararg_index >= p_function->_stack_size)) {
+		return false;
+	}
+	if (p_function->_instruction_args_size < 0 || p_function->_instruction_args_size > code_size || p_function->_default_arg_count > p_function->_argument_count) {
+		return false;
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < GDF::FIXED_ADDRESSES_MAX || E.key >= p_function->_stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+			return false;
+		}
+	}
+
+	const int address_limits[GDF::ADDR_TYPE_MAX] = { p_function->_stack_size, p_function->_constant_count, p_member_count };
+	auto address = [&](int p_address) -> bool {
+		const uint32_t type = (uint32_t(p_address) & GDF::ADDR_TYPE_MASK) >> GDF::ADDR_BITS;
+		return type < GDF::ADDR_TYPE_MAX && (p_address & GDF::ADDR_MASK) < address_limits[type];
+	};
+	auto static_count = [&](int p_class_address) -> int {
+		const GDScript *script = nullptr;
+		if (p_class_address == GDF::ADDR_CLASS) {
+			script = p_function->_script;
+		} else if (((uint32_t(p_class_address) & GDF::ADDR_TYPE_MASK) >> GDF::ADDR_BITS) == GDF::ADDR_TYPE_CONSTANT && (p_class_address & GDF::ADDR_MASK) < p_function->_constant_count) {
+			script = Object::cast_to<GDScript>(p_function->_constants_ptr[p_class_address & GDF::ADDR_MASK].get_validated_object());
+		}
+		if (script == nullptr) {
+			return 0;
+		}
+		const int *count = p_static_counts.getptr(script);
+		return count ? *count : script->static_variables_indices.size();
+	};
+
+	LocalVector<bool> instruction_starts;
+	instruction_starts.resize(code_size);
+	for (bool &start : instruction_starts) {
+		start = false;
+	}
+	LocalVector<int> jump_targets;
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		jump_targets.push_back(p_function->default_arguments[i]);
+	}
+
+#define LENGTH(m_length)                          \
+	length = (m_length);                          \
+	if (length <= 0 || length > code_size - ip) { \
+		return false;                             \
+	}
+#define ADDRESS(m_ofs)                  \
+	if (!address(code[ip + (m_ofs)])) { \
+		return false;                   \
+	}
+#define INDEX(m_ofs, m_count)                                           \
+	if (code[ip + (m_ofs)] < 0 || code[ip + (m_ofs)] >= int(m_count)) { \
+		return false;                                                   \
+	}
+#define JUMP(m_ofs) jump_targets.push_back(code[ip + (m_ofs)])
+// Instructions with a variable operand count store it first, followed by the addresses and then `m_extra` words.
+#define INSTRUCTION_ARGS(m_extra)                                          \
+	if (ip + 1 >= code_size) {                                             \
+		return false;                                                      \
+	}                                                                      \
+	arg_count = code[ip + 1];                                              \
+	if (arg_count < 0 || arg_count > p_function->_instruction_args_size) { \
+		return false;                                                      \
+	}                                                                      \
+	LENGTH(2 + arg_count + (m_extra));                                     \
+	for (int i = 0; i < arg_count; i++) {                                  \
+		ADDRESS(2 + i);                                                    \
+	}                                                                      \
+	extra = ip + 1 + arg_count
+#define EXTRA_INDEX(m_ofs, m_count) INDEX(extra - ip + (m_ofs), m_count)
+#define ARGC(m_ofs, m_per_arg, m_fixed)                                                                                        \
+	if (arg_count < (m_fixed) || code[extra + (m_ofs)] < 0 || code[extra + (m_ofs)] > (arg_count - (m_fixed)) / (m_per_arg)) { \
+		return false;                                                                                                          \
+	}
+
+	int ip = 0;
+	while (ip < code_size) {
+		instruction_starts[ip] = true;
+		int length = 0;
+		int arg_count = 0;
+		int extra = 0;
+
+		const int opcode = code[ip];
+		switch (opcode) {
+			case GDF::OPCODE_OPERATOR: {
+				constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+				LENGTH(7 + pointer_size);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				INDEX(4, Variant::OP_MAX);
+				// A non-zero signature makes the VM call the stored evaluator pointer, so it has to start out empty.
+				for (int i = 5; i < 7 + pointer_size; i++) {
+					if (code[ip + i] != 0) {
+						return false;
+					}
+				}
+			} break;
+			case GDF::OPCODE_OPERATOR_VALIDATED:
+			case GDF::OPCODE_OPERATOR_VALIDATED_ASSIGN:
+			case GDF::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case GDF::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				LENGTH(opcode == GDF::OPCODE_OPERATOR_VALIDATED ? 5 : 8);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				INDEX(4, p_function->_operator_funcs_count);
+				if (opcode == GDF::OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+					ADDRESS(6);
+				} else if (opcode != GDF::OPCODE_OPERATOR_VALIDATED) {
+					JUMP(7);
+				}
+			} break;
+			case GDF::OPCODE_TYPE_TEST_BUILTIN:
+			case GDF::OPCODE_ASSIGN_TYPED_BUILTIN:
+			case GDF::OPCODE_CAST_TO_BUILTIN: {
+				LENGTH(4);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, Variant::VARIANT_MAX);
+			} break;
+			case GDF::OPCODE_TYPE_TEST_ARRAY:
+			case GDF::OPCODE_ASSIGN_TYPED_ARRAY: {
+				LENGTH(6);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				INDEX(4, Variant::VARIANT_MAX);
+				INDEX(5, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_TYPE_TEST_DICTIONARY:
+			case GDF::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+				LENGTH(9);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				ADDRESS(4);
+				INDEX(5, Variant::VARIANT_MAX);
+				INDEX(6, p_function->_global_names_count);
+				INDEX(7, Variant::VARIANT_MAX);
+				INDEX(8, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_TYPE_TEST_NATIVE: {
+				LENGTH(4);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_TYPE_TEST_SCRIPT:
+			case GDF::OPCODE_SET_KEYED:
+			case GDF::OPCODE_GET_KEYED:
+			case GDF::OPCODE_ASSIGN_TYPED_NATIVE:
+			case GDF::OPCODE_ASSIGN_TYPED_SCRIPT:
+			case GDF::OPCODE_CAST_TO_NATIVE:
+			case GDF::OPCODE_CAST_TO_SCRIPT:
+			case GDF::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY:
+			case GDF::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY:
+			case GDF::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY:
+			case GDF::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY:
+			case GDF::OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY:
+			case GDF::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY:
+			case GDF::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY: {
+				LENGTH(4);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+			} break;
+			case GDF::OPCODE_SET_KEYED_VALIDATED:
+			case GDF::OPCODE_SET_INDEXED_VALIDATED:
+			case GDF::OPCODE_GET_KEYED_VALIDATED:
+			case GDF::OPCODE_GET_INDEXED_VALIDATED: {
+				LENGTH(5);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				if (opcode == GDF::OPCODE_SET_KEYED_VALIDATED) {
+					INDEX(4, p_function->_keyed_setters_count);
+				} else if (opcode == GDF::OPCODE_SET_INDEXED_VALIDATED) {
+					INDEX(4, p_function->_indexed_setters_count);
+				} else if (opcode == GDF::OPCODE_GET_KEYED_VALIDATED) {
+					INDEX(4, p_function->_keyed_getters_count);
+				} else {
+					INDEX(4, p_function->_indexed_getters_count);
+				}
+			} break;
+			case GDF::OPCODE_SET_NAMED:
+			case GDF::OPCODE_GET_NAMED: {
+				LENGTH(5);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, p_function->_global_names_count);
+				INDEX(4, p_function->_inline_cache_count);
+			} break;
+			case GDF::OPCODE_SET_NAMED_VALIDATED:
+			case GDF::OPCODE_GET_NAMED_VALIDATED: {
+				LENGTH(4);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, opcode == GDF::OPCODE_SET_NAMED_VALIDATED ? p_function->_setters_count : p_function->_getters_count);
+			} break;
+			case GDF::OPCODE_SET_MEMBER:
+			case GDF::OPCODE_GET_MEMBER:
+			case GDF::OPCODE_STORE_NAMED_GLOBAL: {
+				LENGTH(3);
+				ADDRESS(1);
+				INDEX(2, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_SET_STATIC_VARIABLE:
+			case GDF::OPCODE_GET_STATIC_VARIABLE: {
+				LENGTH(4);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, static_count(code[ip + 2]));
+			} break;
+			case GDF::OPCODE_ASSIGN:
+			case GDF::OPCODE_ASSERT: {
+				LENGTH(3);
+				ADDRESS(1);
+				ADDRESS(2);
+			} break;
+			case GDF::OPCODE_ASSIGN_NULL:
+			case GDF::OPCODE_ASSIGN_TRUE:
+			case GDF::OPCODE_ASSIGN_FALSE:
+			case GDF::OPCODE_AWAIT_RESUME:
+			case GDF::OPCODE_RETURN: {
+				LENGTH(2);
+				ADDRESS(1);
+			} break;
+			case GDF::OPCODE_AWAIT: {
+				LENGTH(2);
+				ADDRESS(1);
+				// The result is stored through the operand of the resume instruction that always follows.
+				if (ip + 2 >= code_size || code[ip + 2] != GDF::OPCODE_AWAIT_RESUME) {
+					return false;
+				}
+			} break;
+			case GDF::OPCODE_CONSTRUCT:
+			case GDF::OPCODE_CONSTRUCT_VALIDATED: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 1);
+				if (opcode == GDF::OPCODE_CONSTRUCT) {
+					EXTRA_INDEX(2, Variant::VARIANT_MAX);
+				} else {
+					EXTRA_INDEX(2, p_function->_constructors_count);
+				}
+			} break;
+			case GDF::OPCODE_CONSTRUCT_ARRAY: {
+				INSTRUCTION_ARGS(1);
+				ARGC(1, 1, 1);
+			} break;
+			case GDF::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+				INSTRUCTION_ARGS(3);
+				ARGC(1, 1, 2);
+				EXTRA_INDEX(2, Variant::VARIANT_MAX);
+				EXTRA_INDEX(3, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_CONSTRUCT_DICTIONARY: {
+				INSTRUCTION_ARGS(1);
+				ARGC(1, 2, 1);
+			} break;
+			case GDF::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+				INSTRUCTION_ARGS(5);
+				ARGC(1, 2, 3);
+				EXTRA_INDEX(2, Variant::VARIANT_MAX);
+				EXTRA_INDEX(3, p_function->_global_names_count);
+				EXTRA_INDEX(4, Variant::VARIANT_MAX);
+				EXTRA_INDEX(5, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_CALL:
+			case GDF::OPCODE_CALL_RETURN:
+			case GDF::OPCODE_CALL_ASYNC: {
+				INSTRUCTION_ARGS(3);
+				ARGC(1, 1, 2);
+				EXTRA_INDEX(2, p_function->_global_names_count);
+				EXTRA_INDEX(3, p_function->_inline_cache_count);
+			} break;
+			case GDF::OPCODE_CALL_METHOD_BIND:
+			case GDF::OPCODE_CALL_METHOD_BIND_RET:
+			case GDF::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDF::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 2);
+				EXTRA_INDEX(2, p_function->_methods_count);
+			} break;
+			case GDF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case GDF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 1);
+				EXTRA_INDEX(2, p_function->_methods_count);
+			} break;
+			case GDF::OPCODE_CALL_BUILTIN_STATIC: {
+				INSTRUCTION_ARGS(3);
+				EXTRA_INDEX(1, Variant::VARIANT_MAX);
+				EXTRA_INDEX(2, p_function->_global_names_count);
+				ARGC(3, 1, 1);
+			} break;
+			case GDF::OPCODE_CALL_NATIVE_STATIC: {
+				INSTRUCTION_ARGS(2);
+				EXTRA_INDEX(1, p_function->_methods_count);
+				ARGC(2, 1, 1);
+			} break;
+			case GDF::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 2);
+				EXTRA_INDEX(2, p_function->_builtin_methods_count);
+			} break;
+			case GDF::OPCODE_CALL_UTILITY:
+			case GDF::OPCODE_CALL_UTILITY_VALIDATED:
+			case GDF::OPCODE_CALL_GDSCRIPT_UTILITY:
+			case GDF::OPCODE_CALL_SELF_BASE: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 1);
+				if (opcode == GDF::OPCODE_CALL_UTILITY_VALIDATED) {
+					EXTRA_INDEX(2, p_function->_utilities_count);
+				} else if (opcode == GDF::OPCODE_CALL_GDSCRIPT_UTILITY) {
+					EXTRA_INDEX(2, p_function->_gds_utilities_count);
+				} else {
+					EXTRA_INDEX(2, p_function->_global_names_count);
+				}
+			} break;
+			case GDF::OPCODE_CREATE_LAMBDA:
+			case GDF::OPCODE_CREATE_SELF_LAMBDA: {
+				INSTRUCTION_ARGS(2);
+				ARGC(1, 1, 1);
+				EXTRA_INDEX(2, p_function->_lambdas_count);
+			} break;
+			case GDF::OPCODE_JUMP: {
+				LENGTH(2);
+				JUMP(1);
+			} break;
+			case GDF::OPCODE_JUMP_IF:
+			case GDF::OPCODE_JUMP_IF_NOT:
+			case GDF::OPCODE_JUMP_IF_SHARED: {
+				LENGTH(3);
+				ADDRESS(1);
+				JUMP(2);
+			} break;
+			case GDF::OPCODE_RETURN_TYPED_BUILTIN: {
+				LENGTH(3);
+				ADDRESS(1);
+				INDEX(2, Variant::VARIANT_MAX);
+			} break;
+			case GDF::OPCODE_RETURN_TYPED_ARRAY: {
+				LENGTH(5);
+				ADDRESS(1);
+				ADDRESS(2);
+				INDEX(3, Variant::VARIANT_MAX);
+				INDEX(4, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_RETURN_TYPED_DICTIONARY: {
+				LENGTH(8);
+				ADDRESS(1);
+				ADDRESS(2);
+				ADDRESS(3);
+				INDEX(4, Variant::VARIANT_MAX);
+				INDEX(5, p_function->_global_names_count);
+				INDEX(6, Variant::VARIANT_MAX);
+				INDEX(7, p_function->_global_names_count);
+			} break;
+			case GDF::OPCODE_RETURN_TYPED_NATIVE:
+			case GDF::OPCODE_RETURN_TYPED_SCRIPT: {
+				LENGTH(3);
+				ADDRESS(1);
+				ADDRESS(2);
+			} break;
+			case GDF::OPCODE_ITERATE_BEGIN_RANGE: {
+				LENGTH(7);
+				for (int i = 1; i <= 5; i++) {
+					ADDRESS(i);
+				}
+				JUMP(6);
+			} break;
+			case GDF::OPCODE_ITERATE_RANGE: {
+				LENGTH(6);
+				for (int i = 1; i <= 4; i++) {
+					ADDRESS(i);
+				}
+				JUMP(5);
+			} break;
+			case GDF::OPCODE_STORE_GLOBAL: {
+				LENGTH(3);
+				ADDRESS(1);
+				INDEX(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+			} break;
+			case GDF::OPCODE_LINE: {
+				LENGTH(2);
+			} break;
+			case GDF::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			case GDF::OPCODE_BREAKPOINT:
+			case GDF::OPCODE_END: {
+				LENGTH(1);
+			} break;
+			default: {
+				if ((opcode >= GDF::OPCODE_ITERATE_BEGIN && opcode <= GDF::OPCODE_ITERATE_BEGIN_OBJECT) || (opcode >= GDF::OPCODE_ITERATE && opcode <= GDF::OPCODE_ITERATE_OBJECT)) {
+					LENGTH(5);
+					ADDRESS(1);
+					ADDRESS(2);
+					ADDRESS(3);
+					JUMP(4);
+				} else if (opcode >= GDF::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDF::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+					LENGTH(2);
+					ADDRESS(1);
+				} else {
+					return false;
+				}
+			} break;
+		}
+		ip += length;
+	}
+
+#undef ARGC
+#undef EXTRA_INDEX
+#undef INSTRUCTION_ARGS
+#undef JUMP
+#undef INDEX
+#undef ADDRESS
+#undef LENGTH
+
+	for (int target : jump_targets) {
+		if (target < 0 || target >= code_size || !instruction_starts[target]) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < p_function->_lambdas_count; i++) {
+		if (!_validate_function(p_function->_lambdas_ptr[i], p_member_count, p_static_counts)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_validate_classes(const List<ClassData> &p_classes) {
+	HashMap<const GDScript *, int> static_counts;
+	for (const ClassData &data : p_classes) {
+		static_counts[data.script] = data.static_variables_indices.size();
+	}
+
+	for (const ClassData &data : p_classes) {
+		const int member_count = data.member_indices.size();
+		for (const KeyValue<StringName, GDScriptFunction *> &E : data.member_functions) {
+			if (!_validate_function(E.value, member_count, static_counts)) {
+				failed = true;
+				return;
+			}
+		}
+		for (const GDScriptFunction *function : { data.implicit_initializer, data.implicit_ready, data.static_initializer }) {
+			if (function != nullptr && !_validate_function(function, member_count, static_counts)) {
+				failed = true;
+				return;
+			}
+		}
+	}
+}
+
+void GDScriptBytecodeCache::_get_class(GDScript *p_script, List<ClassData> &r_classes) {
+	ClassData &data = r_classes.push_back(ClassData())->get();
+	data.script = p_script;
+	data.tool = _get_u8();
+	data.is_abstract = _get_u8();
+
+	const StringName native_name = _get_string();
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	if (native_index == nullptr) {
+		failed = true;
+		return;
+	}
+	data.native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	if (data.native.is_null()) {
+		failed = true;
+		return;
+	}
+	if (_get_u8()) {
+		data.base = Ref<GDScript>(_get_script());
+	}
+
+	const uint32_t member_count = _get_count(1);
+	for (uint32_t i = 0; i < member_count && !failed; i++) {
+		StringName name;
+		const GDScript::MemberInfo info = _get_member_info(name);
+		data.member_indices[name] = info;
+		if (_get_u8()) {
+			data.members.insert(name);
+		}
+	}
+	const uint32_t static_count = _get_count(1);
+	for (uint32_t i = 0; i < static_count && !failed; i++) {
+		StringName name;
+		const GDScript::MemberInfo info = _get_member_info(name);
+		data.static_variables_indices[name] = info;
+	}
+
+	const uint32_t constant_count = _get_count(5);
+	for (uint32_t i = 0; i < constant_count && !failed; i++) {
+		const StringName name = _get_string();
+		data.constants.insert(name, _get_value());
+	}
+	const uint32_t signal_count = _get_count(5);
+	for (uint32_t i = 0; i < signal_count && !failed; i++) {
+		const StringName name = _get_string();
+		data.signals[name] = MethodInfo::from_dict(_get_value());
+	}
+	data.rpc_config = _get_value();
+
+	const uint32_t function_count = _get_count(1);
+	for (uint32_t i = 0; i < function_count && !failed; i++) {
+		GDScriptFunction *function = _get_function(p_script, data.lambda_info);
+		loaded_functions.push_back(function);
+		data.member_functions[function->name] = function;
+	}
+	GDScriptFunction **special_functions[] = { &data.implicit_initializer, &data.implicit_ready, &data.static_initializer };
+	for (GDScriptFunction **function : special_functions) {
+		if (!failed && _get_u8()) {
+			*function = _get_function(p_script, data.lambda_info);
+			loaded_functions.push_back(*function);
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	const uint32_t default_value_count = _get_count(5);
+	for (uint32_t i = 0; i < default_value_count && !failed; i++) {
+		const StringName name = _get_string();
+		data.member_default_values[name] = _get_value();
+	}
+#endif
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (failed) {
+			return;
+		}
+		_get_class(E.value.ptr(), r_classes);
+	}
+}
+
+void GDScriptBytecodeCache::_get_skeleton(GDScript *p_script) {
+	// Mirrors GDScriptCompiler::make_scripts() with state kept.
+	p_script->global_name = _get_string();
+	p_script->simplified_icon_path = _get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	const uint32_t subclass_count = _get_count(9);
+	for (uint32_t i = 0; i < subclass_count && !failed; i++) {
+		const StringName name = _get_string();
+		const String fully_qualified_name = _get_string();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->fully_qualified_name = fully_qualified_name;
+		subclass->local_name = name;
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_get_skeleton(subclass.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_open(const GDScript *p_script, Vector<uint8_t> &r_data) {
+	const String file = _get_cache_file(p_script->path);
+	if (!FileAccess::exists(file)) {
+		return false;
+	}
+	r_data = FileAccess::get_file_as_bytes(file);
+	read_ptr = r_data.ptr();
+	read_size = r_data.size();
+	read_pos = 0;
+
+	if (_get_u32() != CACHE_MAGIC || _get_u32() != FORMAT_VERSION || _get_u64() != _get_engine_key() || _get_u64() != _get_environment_key()) {
+		return false;
+	}
+	if (_get_string() != p_script->path || _get_u64() != _get_script_source_hash(p_script)) {
+		return false;
+	}
+
+	const uint32_t dependency_count = _get_count(12);
+	for (uint32_t i = 0; i < dependency_count; i++) {
+		const String path = _get_string();
+		const uint64_t hash = _get_u64();
+		if (failed || hash != _get_file_hash(path)) {
+			return false;
+		}
+	}
+
+	const uint64_t payload_size = _get_u64();
+	const uint64_t payload_hash = _get_u64();
+	if (failed || payload_size != uint64_t(read_size - read_pos) || payload_hash != _hash_buffer(read_ptr + read_pos, payload_size)) {
+		return false;
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_discard_loaded_functions() {
+	for (GDScriptFunction *function : loaded_functions) {
+		memdelete(function);
+	}
+	loaded_functions.clear();
+}
+
+void GDScriptBytecodeCache::_apply_class(const ClassData &p_data) {
+	GDScript *script = p_data.script;
+	script->tool = p_data.tool;
+	script->_is_abstract = p_data.is_abstract;
+	script->native = p_data.native;
+	script->base = p_data.base;
+	script->_base = p_data.base.ptr();
+	script->member_indices = p_data.member_indices;
+	script->members = p_data.members;
+	script->static_variables_indices = p_data.static_variables_indices;
+	script->static_variables.resize(p_data.static_variables_indices.size());
+	script->constants = p_data.constants;
+	script->_signals = p_data.signals;
+	script->rpc_config = p_data.rpc_config;
+	script->member_functions = p_data.member_functions;
+	script->implicit_initializer = p_data.implicit_initializer;
+	script->implicit_ready = p_data.implicit_ready;
+	script->static_initializer = p_data.static_initializer;
+	script->lambda_info = p_data.lambda_info;
+#ifdef TOOLS_ENABLED
+	script->member_default_values = p_data.member_default_values;
+#endif
+
+	GDScriptFunction *const *initializer = p_data.member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+	script->initializer = initializer ? *initializer : nullptr;
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (language == nullptr || !language->is_bytecode_cache_enabled()) {
+		return false;
+	}
+	// Debugging needs local variable tracking, which the cached code was not built with.
+	return !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active() && !language->should_track_locals();
+}
+
+bool GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled() || p_script->path.is_empty() || p_script->path.contains("::")) {
+		return false;
+	}
+
+	GDScriptBytecodeCache cache;
+	cache.main_script = p_script;
+	Vector<uint8_t> data;
+	if (!cache._open(p_script, data)) {
+		return false;
+	}
+
+	cache._get_u8(); // Flags.
+	const String fully_qualified_name = cache._get_string();
+	const StringName local_name = cache._get_string();
+	if (cache.failed) {
+		return false;
+	}
+	p_script->fully_qualified_name = fully_qualified_name;
+	p_script->local_name = local_name;
+	cache._get_skeleton(p_script);
+	return !cache.failed;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	if (!is_enabled() || !p_script->is_root_script() || p_script->path.is_empty() || p_script->path.contains("::")) {
+		return ERR_UNAVAILABLE;
+	}
+	if (p_script->valid || !p_script->member_functions.is_empty() || p_script->implicit_initializer != nullptr) {
+		return ERR_UNAVAILABLE;
+	}
+
+	GDScriptBytecodeCache cache;
+	cache.main_script = p_script;
+	Vector<uint8_t> data;
+	if (!cache._open(p_script, data)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const uint8_t flags = cache._get_u8();
+	const String fully_qualified_name = cache._get_string();
+	const StringName local_name = cache._get_string();
+	if (cache.failed) {
+		return ERR_UNAVAILABLE;
+	}
+	p_script->fully_qualified_name = fully_qualified_name;
+	p_script->local_name = local_name;
+	cache._get_skeleton(p_script);
+
+	// Everything is decoded before the script is touched, so a bad entry leaves it ready for compiling.
+	List<ClassData> classes;
+	if (!cache.failed) {
+		cache._get_class(p_script, classes);
+	}
+	if (!cache.failed && cache.read_pos == cache.read_size) {
+		cache._validate_classes(classes);
+	}
+	if (cache.failed || cache.read_pos != cache.read_size) {
+		cache._discard_loaded_functions();
+		print_verbose(vformat(R"(GDScript: Ignoring unusable bytecode cache entry for "%s".)", p_script->path));
+		return ERR_UNAVAILABLE;
+	}
+
+	for (const ClassData &class_data : classes) {
+		_apply_class(class_data);
+	}
+	for (List<ClassData>::Element *E = classes.back(); E; E = E->prev()) {
+		E->get().script->_static_default_init();
+		E->get().script->valid = true;
+	}
+	GDScriptInlineCache::invalidate(p_script);
+
+	if (flags & FLAG_STATIC_DATA) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+void GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser *p_parser) {
+	if (!is_enabled() || !p_script->is_root_script() || p_script->path.is_empty() || p_script->path.contains("::")) {
+		return;
+	}
+
+	GDScriptBytecodeCache cache;
+	cache.main_script = p_script;
+
+	const GDScriptParser::ClassNode *tree = p_parser->get_tree();
+	cache._put_u8(_has_static_data(tree) && !tree->annotated_static_unload ? FLAG_STATIC_DATA : 0);
+	cache._put_string(p_script->fully_qualified_name);
+	cache._put_string(p_script->local_name);
+	cache._put_skeleton(p_script);
+	cache._put_class(p_script);
+	if (cache.failed) {
+		print_verbose(vformat(R"(GDScript: "%s" contains values that cannot be stored in the bytecode cache.)", p_script->path));
+		return;
+	}
+
+	const Vector<uint8_t> payload = cache.buffer;
+	HashSet<String> dependencies = cache.referenced_scripts;
+	_collect_dependencies(p_parser, dependencies);
+	dependencies.erase(p_script->path);
+
+	cache.buffer.clear();
+	cache._put_u32(CACHE_MAGIC);
+	cache._put_u32(FORMAT_VERSION);
+	cache._put_u64(_get_engine_key());
+	cache._put_u64(_get_environment_key());
+	cache._put_string(p_script->path);
+	cache._put_u64(_get_script_source_hash(p_script));
+	cache._put_u32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		cache._put_string(dependency);
+		cache._put_u64(_get_file_hash(dependency));
+	}
+	cache._put_u64(payload.size());
+	cache._put_u64(_hash_buffer(payload.ptr(), payload.size()));
+	cache._put_bytes(payload.ptr(), payload.size());
+
+	const String file = _get_cache_file(p_script->path);
+	const String base_dir = file.get_base_dir();
+	if (!DirAccess::exists(base_dir)) {
+		Error err = DirAccess::make_dir_recursive_absolute(base_dir);
+		ERR_FAIL_COND_MSG(err != OK, vformat(R"(Could not create the GDScript bytecode cache directory "%s".)", base_dir));
+	}
+
+	// Written next to the final file and renamed, so concurrent readers never see partial entries.
+	const String temp_file = file + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_file, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Could not write the GDScript bytecode cache file "%s".)", temp_file));
+		f->store_buffer(cache.buffer.ptr(), cache.buffer.size());
+	}
+	Ref<DirAccess> da = DirAccess::create_for_path(base_dir);
+	ERR_FAIL_COND(da.is_null());
+	if (da->exists(file)) {
+		da->remove(file);
+	}
+	da->rename(temp_file, file);
+}
+
+void GDScriptBytecodeCache::clear() {
+	{
+		MutexLock lock(hashes_mutex);
+		file_hashes.clear();
+		environment_key_valid = false;
+	}
+
+	MutexLock lock(descriptors_mutex);
+	if (descriptors) {
+		memdelete(descriptors);
+		descriptors = nullptr;
+	}
+}
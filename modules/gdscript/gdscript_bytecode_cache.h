@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/list.h"
+
+class GDScriptParser;
+
+// Persists compiled scripts so that later runs can skip parsing, analysis and code generation.
+// One cache file is written per root script. It is only used when the engine build, the global
+// class and autoload environment, and the source of the script and of every script it depended
+// on during analysis all match; any mismatch or decoding error falls back to compiling.
+class GDScriptBytecodeCache {
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	struct Descriptors;
+	static Descriptors *descriptors;
+	static Mutex descriptors_mutex;
+
+	static Mutex hashes_mutex;
+	static HashMap<String, uint64_t> file_hashes;
+	static uint64_t environment_key;
+	static bool environment_key_valid;
+
+	enum ValueTag {
+		VALUE_PLAIN,
+		VALUE_NULL_OBJECT,
+		VALUE_NATIVE_CLASS,
+		VALUE_GDSCRIPT,
+		VALUE_RESOURCE,
+		VALUE_ARRAY,
+		VALUE_DICTIONARY,
+	};
+
+	enum Flags {
+		FLAG_STATIC_DATA = 1 << 0,
+	};
+
+	struct ClassData {
+		GDScript *script = nullptr;
+		bool tool = false;
+		bool is_abstract = false;
+		Ref<GDScriptNativeClass> native;
+		Ref<GDScript> base;
+		HashMap<StringName, GDScript::MemberInfo> member_indices;
+		HashSet<StringName> members;
+		HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+		HashMap<StringName, Variant> constants;
+		HashMap<StringName, MethodInfo> signals;
+		Dictionary rpc_config;
+		HashMap<StringName, GDScriptFunction *> member_functions;
+		GDScriptFunction *implicit_initializer = nullptr;
+		GDScriptFunction *implicit_ready = nullptr;
+		GDScriptFunction *static_initializer = nullptr;
+		HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+#ifdef TOOLS_ENABLED
+		HashMap<StringName, Variant> member_default_values;
+#endif
+	};
+
+	// State of a single save or load.
+	GDScript *main_script = nullptr;
+	bool failed = false;
+	int value_depth = 0;
+
+	Vector<uint8_t> buffer;
+	HashSet<String> referenced_scripts;
+	Vector<StringName> global_names_by_index;
+
+	const uint8_t *read_ptr = nullptr;
+	int64_t read_size = 0;
+	int64_t read_pos = 0;
+	List<GDScriptFunction *> loaded_functions;
+
+	static const Descriptors &_get_descriptors();
+	static String _get_cache_file(const String &p_path);
+	static uint64_t _get_engine_key();
+	static uint64_t _get_environment_key();
+	static uint64_t _get_file_hash(const String &p_path);
+	static uint64_t _get_script_source_hash(const GDScript *p_script);
+	static void _collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths);
+
+	void _put_u8(uint8_t p_value);
+	void _put_bytes(const uint8_t *p_data, int64_t p_size);
+	void _put_u32(uint32_t p_value);
+	void _put_u64(uint64_t p_value);
+	void _put_string(const String &p_string);
+	void _put_value(const Variant &p_value);
+	void _put_script(const Script *p_script);
+	void _put_data_type(const GDScriptDataType &p_type);
+	void _put_member_info(const StringName &p_name, const GDScript::MemberInfo &p_info);
+	void _put_function(const GDScript *p_script, const GDScriptFunction *p_function);
+	void _put_class(const GDScript *p_script);
+	void _put_skeleton(const GDScript *p_script);
+
+	bool _can_read(int64_t p_size);
+	uint32_t _get_count(int64_t p_min_element_size);
+	uint8_t _get_u8();
+	uint32_t _get_u32();
+	uint64_t _get_u64();
+	String _get_string();
+	Variant _get_value();
+	GDScript *_get_script();
+	GDScriptDataType _get_data_type();
+	GDScript::MemberInfo _get_member_info(StringName &r_name);
+	GDScriptFunction *_get_function(GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info);
+	void _get_class(GDScript *p_script, List<ClassData> &r_classes);
+	void _get_skeleton(GDScript *p_script);
+
+	// The cache directory is writable and release builds of the VM trust the code they run, so every
+	// address, table index and jump target is checked against the decoded tables before it is used.
+	static bool _validate_function(const GDScriptFunction *p_function, int p_member_count, const HashMap<const GDScript *, int> &p_static_counts);
+	void _validate_classes(const List<ClassData> &p_classes);
+
+	bool _open(const GDScript *p_script, Vector<uint8_t> &r_data);
+	void _discard_loaded_functions();
+	static void _apply_class(const ClassData &p_data);
+
+public:
+	static bool is_enabled();
+
+	// Recreates the inner class tree of a shallow script without parsing it.
+	static bool make_scripts(GDScript *p_script);
+	// Fills a script from its cache entry. Returns ERR_UNAVAILABLE if there is no usable entry.
+	static Error load(GDScript *p_script);
+	// Stores a freshly compiled root script. Scripts that cannot be represented are skipped.
+	static void save(GDScript *p_script, GDScriptParser *p_parser);
+
+	static void clear();
+};
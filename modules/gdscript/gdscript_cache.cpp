@@ -32,10 +32,12 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -75,16 +77,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = _parse(get_parser(), path, source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -107,6 +100,28 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 	return result;
 }
 
+Error GDScriptParserRef::_parse(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash) {
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+	String source = GDScriptCache::get_source_code(remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
+// Adopts a parser that was filled outside of this reference (see `GDScriptCache::_parse_ahead()`).
+void GDScriptParserRef::_set_parsed(GDScriptParser *p_parser, Error p_result, uint32_t p_source_hash) {
+	// Nothing was parsed yet, so this only drops a parser or analyzer that may have been created empty.
+	clear();
+	parser = p_parser;
+	status = PARSED;
+	result = p_result;
+	source_hash = p_source_hash;
+}
+
 void GDScriptParserRef::clear() {
 	if (clearing) {
 		return;
@@ -327,9 +342,11 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (!GDScriptBytecodeCache::make_scripts(script.ptr())) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -337,6 +354,95 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	return script;
 }
 
+thread_local bool GDScriptCache::parsing_ahead = false;
+
+void GDScriptCache::_parse_job(uint32_t p_index, ParseJob *p_jobs) {
+	ParseJob &job = p_jobs[p_index];
+	job.result = GDScriptParserRef::_parse(job.parser, job.path, job.source_hash);
+}
+
+// Parses the scripts `p_path` (transitively) refers to on the worker thread pool, one dependency level at a time.
+// Parsing is the only step that doesn't need other scripts, so it's the one done ahead. The analyzer and compiler
+// then find the parsers in the cache and resolve and link classes serially in dependency order, as usual.
+// Must be called with the mutex locked; it's released while waiting for the workers.
+void GDScriptCache::_parse_ahead(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsers) {
+	HashSet<String> visited;
+	visited.insert(p_path);
+	LocalVector<String> level;
+	level.push_back(p_path);
+
+	while (!level.is_empty()) {
+		HashSet<String> referenced;
+		LocalVector<ParseJob> jobs;
+
+		for (const String &path : level) {
+			GDScriptParserRef **existing = singleton->parser_map.getptr(path);
+			if (existing != nullptr) {
+				Ref<GDScriptParserRef> ref = Ref<GDScriptParserRef>(*existing);
+				if (ref.is_null()) {
+					// Being destructed, leave it to the regular path.
+					continue;
+				}
+				if (ref->status != GDScriptParserRef::EMPTY) {
+					if (ref->result == OK) {
+						ref->parser->get_referenced_script_paths(referenced);
+						r_parsers.push_back(ref);
+					}
+					continue;
+				}
+			}
+			if (!FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+			ParseJob job;
+			job.path = path;
+			// Constructed here as the first construction initializes static data.
+			job.parser = memnew(GDScriptParser);
+			jobs.push_back(job);
+		}
+
+		if (jobs.size() == 1) {
+			singleton->_parse_job(0, jobs.ptr());
+		} else if (jobs.size() > 1) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(singleton, &GDScriptCache::_parse_job, jobs.ptr(), jobs.size(), -1, true, SNAME("GDScriptParseAhead"));
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(mutex);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		for (const ParseJob &job : jobs) {
+			Ref<GDScriptParserRef> ref;
+			GDScriptParserRef **existing = singleton->parser_map.getptr(job.path);
+			if (existing != nullptr) {
+				ref = Ref<GDScriptParserRef>(*existing);
+				if (ref.is_null() || ref->status != GDScriptParserRef::EMPTY) {
+					// Being destructed, or parsed by another thread while the mutex was released.
+					memdelete(job.parser);
+					continue;
+				}
+			} else {
+				ref.instantiate();
+				ref->path = job.path;
+				singleton->parser_map[job.path] = ref.ptr();
+			}
+
+			ref->_set_parsed(job.parser, job.result, job.source_hash);
+			r_parsers.push_back(ref);
+			if (job.result == OK) {
+				job.parser->get_referenced_script_paths(referenced);
+			}
+		}
+
+		level.clear();
+		for (const String &path : referenced) {
+			if (!visited.has(path)) {
+				visited.insert(path);
+				level.push_back(path);
+			}
+		}
+	}
+}
+
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
 	MutexLock lock(singleton->mutex);
 
@@ -379,11 +485,25 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Parse what the script depends on in parallel before the (serial) reload needs it.
+	// Only done from the outermost call on a thread that isn't a pool worker itself; nested
+	// calls made while compiling find their dependencies already parsed.
+	LocalVector<Ref<GDScriptParserRef>> parsed_ahead;
+	bool parse_ahead = !parsing_ahead && !p_update_from_disk && WorkerThreadPool::get_singleton()->get_thread_index() == -1 && WorkerThreadPool::get_singleton()->get_thread_count() > 1 && !GDScriptBytecodeCache::is_enabled();
+	if (parse_ahead) {
+		parsing_ahead = true;
+		_parse_ahead(p_path, parsed_ahead);
+	}
+
 	// Allowing lifting the lock might cause a script to be reloaded multiple times,
 	// which, as a last resort deadlock prevention strategy, is a good tradeoff.
 	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
 	r_error = script->reload(true);
 	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+	if (parse_ahead) {
+		parsing_ahead = false;
+	}
 	if (r_error) {
 		return script;
 	}
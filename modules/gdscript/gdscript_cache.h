@@ -36,6 +36,7 @@
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
 class GDScriptAnalyzer;
 class GDScriptParser;
@@ -65,6 +66,9 @@ private:
 	friend class GDScriptCache;
 	friend class GDScript;
 
+	static Error _parse(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash);
+	void _set_parsed(GDScriptParser *p_parser, Error p_result, uint32_t p_source_hash);
+
 public:
 	Status get_status() const;
 	String get_path() const;
@@ -89,6 +93,7 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
 	friend class GDScript;
+	friend class GDScriptCompiler;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -96,6 +101,18 @@ class GDScriptCache {
 
 	bool cleared = false;
 
+	struct ParseJob {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+	};
+
+	static thread_local bool parsing_ahead;
+
+	void _parse_job(uint32_t p_index, ParseJob *p_jobs);
+	static void _parse_ahead(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsers);
+
 public:
 	static const int BINARY_MUTEX_TAG = 2;
 
@@ -31,8 +31,10 @@
 #include "gdscript_compiler.h"
 
 #include "gdscript.h"
+#include "gdscript_analyzer.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -2368,6 +2370,10 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 	bool is_initializer = p_func && !p_for_lambda && p_func->identifier->name == GDScriptLanguage::get_singleton()->strings._init;
 	bool is_implicit_ready = !p_func && p_for_ready;
 
+	// Member functions of a lazily compiled script only get their signature, see `compile_lazy_function()`.
+	bool is_lazy_stub = lazy_compilation != nullptr && p_func && !p_for_lambda && !is_abstract;
+	bool is_lazy_body = lazy_function != nullptr && !p_for_lambda;
+
 	if (!p_for_lambda && is_implicit_initializer) {
 		// Initialize the default values for typed variables before anything.
 		// This avoids crashes if they are accessed with validated calls before being properly initialized.
@@ -2442,7 +2448,7 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 	}
 
 	// Parse default argument code if applies.
-	if (p_func) {
+	if (p_func && !is_lazy_stub) {
 		if (optional_parameters > 0) {
 			codegen.generator->start_parameters();
 			for (int i = p_func->parameters.size() - optional_parameters; i < p_func->parameters.size(); i++) {
@@ -2507,7 +2513,14 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	GDScriptFunction *gd_function = codegen.generator->write_end();
 
-	if (is_initializer) {
+	if (is_lazy_stub) {
+		gd_function->lazy_pending.set();
+		lazy_compilation->functions.insert(gd_function);
+	}
+
+	if (is_lazy_body) {
+		// The stub is already registered and takes over this code.
+	} else if (is_initializer) {
 		p_script->initializer = gd_function;
 	} else if (is_implicit_initializer) {
 		p_script->implicit_initializer = gd_function;
@@ -2534,7 +2547,7 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	gd_function->method_info = method_info;
 
-	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda) {
+	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda && !is_lazy_body) {
 		p_script->member_functions[func_name] = gd_function;
 	}
 
@@ -3307,16 +3320,20 @@ void GDScriptCompiler::_get_function_ptr_replacements(HashMap<GDScriptFunction *
 	}
 }
 
-Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state) {
+Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state, GDScriptLazyCompilation *p_lazy_compilation) {
 	err_line = -1;
 	err_column = -1;
 	error = "";
 	parser = p_parser;
 	main_script = p_script;
+	lazy_compilation = p_lazy_compilation;
 	const GDScriptParser::ClassNode *root = parser->get_tree();
 
 	source = p_script->get_path();
 
+	// Lookups cached by the running code must not outlive the members and functions replaced here.
+	GDScriptInlineCache::invalidate(main_script);
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
@@ -3330,6 +3347,7 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	}
 
 	err = _compile_class(main_script, root, p_keep_state);
+	GDScriptInlineCache::invalidate(main_script);
 	if (err) {
 		return err;
 	}
@@ -3351,6 +3369,231 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	return err;
 }
 
+void GDScriptLazyCompilation::track_dependencies() {
+	dependencies.clear();
+	dependency_parsers.clear();
+
+	HashSet<const GDScriptParserRef *> visited;
+	LocalVector<GDScriptParser *> pending;
+	pending.push_back(parser);
+	while (!pending.is_empty()) {
+		GDScriptParser *current = pending[pending.size() - 1];
+		pending.remove_at(pending.size() - 1);
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : current->get_depended_parsers()) {
+			if (E.value.is_null() || visited.has(E.value.ptr()) || E.value->get_status() == GDScriptParserRef::EMPTY) {
+				continue;
+			}
+			visited.insert(E.value.ptr());
+			dependencies.push_back(E.value);
+			dependency_parsers.push_back(E.value->get_parser());
+			pending.push_back(E.value->get_parser());
+		}
+	}
+}
+
+bool GDScriptLazyCompilation::are_dependencies_valid() {
+	for (uint32_t i = 0; i < dependencies.size(); i++) {
+		// Depended trees are cleared when their script is removed from the cache.
+		if (dependencies[i]->get_status() == GDScriptParserRef::EMPTY || dependencies[i]->get_parser() != dependency_parsers[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+BinaryMutex GDScriptCompiler::prewarm_mutex;
+LocalVector<Ref<GDScript>> GDScriptCompiler::prewarm_queue;
+WorkerThreadPool::TaskID GDScriptCompiler::prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+LocalVector<WorkerThreadPool::TaskID> GDScriptCompiler::prewarm_finished_tasks;
+bool GDScriptCompiler::prewarm_running = false;
+
+bool GDScriptCompiler::compile_lazy_function(GDScriptFunction *p_function) {
+	GDScript *root = p_function->get_script()->get_root_script();
+	Error err = _compile_lazy_function(root, p_function, false);
+	if (err == ERR_BUSY) {
+		// The retained tree points into trees of other scripts, which are only freed under the cache mutex.
+		MutexLock cache_lock(GDScriptCache::mutex);
+		err = _compile_lazy_function(root, p_function, true);
+	}
+	return err == OK;
+}
+
+// Compiles the first pending function when `p_function` is null. Returns ERR_DOES_NOT_EXIST when there is none,
+// and ERR_BUSY when the cache mutex is needed but not held by the caller.
+Error GDScriptCompiler::_compile_lazy_function(GDScript *p_root, GDScriptFunction *p_function, bool p_cache_locked) {
+	MutexLock lock(p_root->lazy_mutex);
+
+	GDScriptLazyCompilation *lazy = p_root->lazy_compilation;
+	if (p_function == nullptr) {
+		if (lazy == nullptr || lazy->functions.is_empty()) {
+			return ERR_DOES_NOT_EXIST;
+		}
+		p_function = *lazy->functions.begin();
+	}
+
+	if (!p_function->lazy_pending.is_set()) {
+		return OK; // Compiled by another thread meanwhile.
+	}
+	ERR_FAIL_NULL_V(lazy, ERR_BUG);
+	if (!p_cache_locked && !lazy->dependencies.is_empty()) {
+		return ERR_BUSY;
+	}
+	const String &path = p_root->path;
+
+	if (!lazy->are_dependencies_valid()) {
+		// The retained tree points into a tree that is gone, so analyze the source again.
+		memdelete(lazy->parser);
+		lazy->parser = memnew(GDScriptParser);
+		Error err = p_root->binary_tokens.is_empty() ? lazy->parser->parse(p_root->source, path, false) : lazy->parser->parse_binary(p_root->binary_tokens, path);
+		if (err == OK) {
+			GDScriptAnalyzer analyzer(lazy->parser);
+			err = analyzer.analyze();
+		}
+		if (err) {
+			_err_print_error("GDScriptCompiler::compile_lazy_function", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), 0, "Parse Error: Could not analyze the script again to compile its functions.", false, ERR_HANDLER_SCRIPT);
+			for (GDScriptFunction *function : lazy->functions) {
+				function->lazy_pending.clear();
+			}
+			p_root->_clear_lazy_compilation();
+			return ERR_PARSE_ERROR;
+		}
+		lazy->track_dependencies();
+	}
+
+	const GDScriptParser::ClassNode *class_node = lazy->parser->get_tree();
+	LocalVector<StringName> class_names;
+	for (GDScript *scr = p_function->get_script(); scr->_owner != nullptr; scr = scr->_owner) {
+		class_names.push_back(scr->local_name);
+	}
+	for (int64_t i = (int64_t)class_names.size() - 1; i >= 0 && class_node != nullptr; i--) {
+		const StringName &class_name = class_names[i];
+		if (class_node->has_member(class_name) && class_node->get_member(class_name).type == GDScriptParser::ClassNode::Member::CLASS) {
+			class_node = class_node->get_member(class_name).m_class;
+		} else {
+			class_node = nullptr;
+		}
+	}
+
+	const StringName function_name = p_function->get_name();
+	lazy->functions.erase(p_function);
+
+	Error err = ERR_COMPILATION_FAILED;
+	GDScriptCompiler compiler;
+	if (class_node != nullptr && class_node->has_function(function_name)) {
+		compiler.parser = lazy->parser;
+		compiler.main_script = p_root;
+		compiler.source = path;
+		compiler.lazy_function = p_function;
+
+		GDScriptFunction *function = compiler._parse_function(err, p_function->get_script(), class_node, class_node->get_member(function_name).function);
+		if (err == OK) {
+			p_function->_take_code(function);
+			function->name = StringName(); // Keep the stub registered in the script.
+			memdelete(function);
+		}
+	} else {
+		compiler._set_error(vformat(R"(Compiler bug (please report): Could not find function "%s" in the retained tree.)", function_name), nullptr);
+	}
+
+	if (err) {
+		_err_print_error("GDScriptCompiler::compile_lazy_function", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+	}
+
+	// Publishes the code to the threads checking the flag before calling.
+	p_function->lazy_pending.clear();
+
+	if (lazy->functions.is_empty()) {
+		p_root->_clear_lazy_compilation();
+	}
+
+	return err;
+}
+
+void GDScriptCompiler::_prewarm_lazy_functions(void *p_userdata) {
+	while (true) {
+		Ref<GDScript> scr; // Released after the lock.
+		{
+			MutexLock lock(prewarm_mutex);
+			if (prewarm_queue.is_empty()) {
+				prewarm_running = false;
+				return;
+			}
+			scr = prewarm_queue[prewarm_queue.size() - 1];
+		}
+
+		// One function per lock, so calls on other threads compiling their own stubs are not held for long.
+		Error err = _compile_lazy_function(scr.ptr(), nullptr, false);
+		if (err == ERR_BUSY) {
+			MutexLock cache_lock(GDScriptCache::mutex);
+			err = _compile_lazy_function(scr.ptr(), nullptr, true);
+		}
+
+		if (err == ERR_DOES_NOT_EXIST) {
+			MutexLock lock(prewarm_mutex);
+			int64_t index = prewarm_queue.find(scr);
+			if (index >= 0) {
+				prewarm_queue.remove_at(index);
+			}
+		}
+	}
+}
+
+void GDScriptCompiler::_reclaim_prewarm_tasks(LocalVector<WorkerThreadPool::TaskID> &p_tasks) {
+	LocalVector<WorkerThreadPool::TaskID> busy;
+	for (WorkerThreadPool::TaskID task : p_tasks) {
+		// Pool threads may not wait for older tasks, those are left to the next call.
+		if (WorkerThreadPool::get_singleton()->wait_for_task_completion(task) == ERR_BUSY) {
+			busy.push_back(task);
+		}
+	}
+
+	if (!busy.is_empty()) {
+		MutexLock lock(prewarm_mutex);
+		for (WorkerThreadPool::TaskID task : busy) {
+			prewarm_finished_tasks.push_back(task);
+		}
+	}
+}
+
+void GDScriptCompiler::prewarm_lazy_functions(GDScript *p_script) {
+	LocalVector<WorkerThreadPool::TaskID> finished_tasks;
+	{
+		MutexLock lock(prewarm_mutex);
+
+		prewarm_queue.push_back(Ref<GDScript>(p_script));
+		if (prewarm_running) {
+			return;
+		}
+
+		// The previous task ran out of work, it is reclaimed below rather than waited for under the lock.
+		SWAP(finished_tasks, prewarm_finished_tasks);
+		if (prewarm_task != WorkerThreadPool::INVALID_TASK_ID) {
+			finished_tasks.push_back(prewarm_task);
+		}
+		prewarm_running = true;
+		prewarm_task = WorkerThreadPool::get_singleton()->add_native_task(&GDScriptCompiler::_prewarm_lazy_functions, nullptr, false, SNAME("GDScriptLazyCompilation"));
+	}
+
+	_reclaim_prewarm_tasks(finished_tasks);
+}
+
+void GDScriptCompiler::finish_prewarm() {
+	LocalVector<Ref<GDScript>> queue;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	{
+		MutexLock lock(prewarm_mutex);
+		// An empty queue makes the task stop after the function it is compiling.
+		SWAP(queue, prewarm_queue);
+		SWAP(tasks, prewarm_finished_tasks);
+		if (prewarm_task != WorkerThreadPool::INVALID_TASK_ID) {
+			tasks.push_back(prewarm_task);
+		}
+		prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	_reclaim_prewarm_tasks(tasks);
+}
+
 String GDScriptCompiler::get_error() const {
 	return error;
 }
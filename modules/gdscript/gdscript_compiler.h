@@ -35,13 +35,42 @@
 #include "gdscript_function.h"
 #include "gdscript_parser.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Analyzed tree kept by a root script whose member functions are compiled on their first call.
+struct GDScriptLazyCompilation {
+	GDScriptParser *parser = memnew(GDScriptParser);
+	HashSet<GDScriptFunction *> functions; // Still only holding their signature.
+
+	// Trees the retained one points into, with the parsers they held when it was analyzed.
+	LocalVector<Ref<GDScriptParserRef>> dependencies;
+	LocalVector<const GDScriptParser *> dependency_parsers;
+
+	void track_dependencies();
+	bool are_dependencies_valid();
+
+	~GDScriptLazyCompilation() { memdelete(parser); }
+};
 
 class GDScriptCompiler {
 	const GDScriptParser *parser = nullptr;
 	HashSet<GDScript *> parsed_classes;
 	HashSet<GDScript *> parsing_classes;
 	GDScript *main_script = nullptr;
+	GDScriptLazyCompilation *lazy_compilation = nullptr; // Member functions only get a signature when set.
+	const GDScriptFunction *lazy_function = nullptr; // Stub whose body is being compiled.
+
+	static BinaryMutex prewarm_mutex;
+	static LocalVector<Ref<GDScript>> prewarm_queue; // Protected by the mutex above, like the fields below.
+	static WorkerThreadPool::TaskID prewarm_task;
+	static LocalVector<WorkerThreadPool::TaskID> prewarm_finished_tasks; // Not reclaimed yet.
+	static bool prewarm_running;
+
+	static Error _compile_lazy_function(GDScript *p_root, GDScriptFunction *p_function, bool p_cache_locked);
+	static void _prewarm_lazy_functions(void *p_userdata);
+	static void _reclaim_prewarm_tasks(LocalVector<WorkerThreadPool::TaskID> &p_tasks);
 
 	struct FunctionLambdaInfo {
 		GDScriptFunction *function = nullptr;
@@ -177,7 +206,11 @@ class GDScriptCompiler {
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
-	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
+	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false, GDScriptLazyCompilation *p_lazy_compilation = nullptr);
+
+	static bool compile_lazy_function(GDScriptFunction *p_function);
+	static void prewarm_lazy_functions(GDScript *p_script);
+	static void finish_prewarm();
 
 	String get_error() const;
 	int get_error_line() const;
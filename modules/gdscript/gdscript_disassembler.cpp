@@ -141,6 +141,41 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator-assign ";
+
+				text += DADDR(6);
+				text += " = ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 8;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				if (opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+					text += "validated operator-jump-if ";
+				} else {
+					text += "validated operator-jump-if-not ";
+				}
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -300,6 +335,34 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_INDEXED_PACKED_ARRAY(m_type)                 \
+	case OPCODE_SET_INDEXED_PACKED_##m_type##_ARRAY: {           \
+		text += "set indexed (typed PACKED_" #m_type "_ARRAY) "; \
+		text += DADDR(1);                                        \
+		text += "[";                                             \
+		text += DADDR(2);                                        \
+		text += "] = ";                                          \
+		text += DADDR(3);                                        \
+		incr += 4;                                               \
+	} break;                                                     \
+	case OPCODE_GET_INDEXED_PACKED_##m_type##_ARRAY: {           \
+		text += "get indexed (typed PACKED_" #m_type "_ARRAY) "; \
+		text += DADDR(3);                                        \
+		text += " = ";                                           \
+		text += DADDR(1);                                        \
+		text += "[";                                             \
+		text += DADDR(2);                                        \
+		text += "]";                                             \
+		incr += 4;                                               \
+	} break
+
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(INT32);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(INT64);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(FLOAT32);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(FLOAT64);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(VECTOR2);
+				DISASSEMBLE_INDEXED_PACKED_ARRAY(VECTOR3);
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -308,7 +371,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +392,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -708,7 +771,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
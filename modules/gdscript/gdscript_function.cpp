@@ -31,6 +31,11 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_inline_cache.h"
+#include "gdscript_threaded_code.h"
+
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
@@ -104,6 +109,115 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+GDScriptThreadedCode *GDScriptFunction::_get_threaded_code(uint32_t p_threshold) {
+	GDScriptThreadedCode *tc = threaded_code.load(std::memory_order_acquire);
+	if (likely(tc) || threaded_code_unsupported.is_set()) {
+		return tc;
+	}
+	if (threaded_code_call_count.increment() < p_threshold) {
+		return nullptr;
+	}
+
+	tc = GDScriptThreadedCode::create(this);
+	if (!tc) {
+		threaded_code_unsupported.set();
+		return nullptr;
+	}
+
+	// Another thread may have translated the function at the same time.
+	GDScriptThreadedCode *expected = nullptr;
+	if (!threaded_code.compare_exchange_strong(expected, tc, std::memory_order_acq_rel)) {
+		memdelete(tc);
+		return expected;
+	}
+	return tc;
+}
+
+void GDScriptFunction::_create_inline_caches(int p_count) {
+	ERR_FAIL_COND(_inline_caches_ptr);
+	_inline_cache_count = p_count;
+	if (p_count > 0) {
+		_inline_caches_ptr = memnew_arr(GDScriptInlineCache, p_count);
+	}
+}
+
+// Exchanges the code generated for `p_from` with this function's, leaving the signature as is.
+void GDScriptFunction::_take_code(GDScriptFunction *p_from) {
+	SWAP(_stack_size, p_from->_stack_size);
+	SWAP(_instruction_args_size, p_from->_instruction_args_size);
+	SWAP(temporary_slots, p_from->temporary_slots);
+	SWAP(stack_debug, p_from->stack_debug);
+
+	SWAP(code, p_from->code);
+	SWAP(default_arguments, p_from->default_arguments);
+	SWAP(constants, p_from->constants);
+	SWAP(global_names, p_from->global_names);
+	SWAP(operator_funcs, p_from->operator_funcs);
+	SWAP(setters, p_from->setters);
+	SWAP(getters, p_from->getters);
+	SWAP(keyed_setters, p_from->keyed_setters);
+	SWAP(keyed_getters, p_from->keyed_getters);
+	SWAP(indexed_setters, p_from->indexed_setters);
+	SWAP(indexed_getters, p_from->indexed_getters);
+	SWAP(builtin_methods, p_from->builtin_methods);
+	SWAP(constructors, p_from->constructors);
+	SWAP(utilities, p_from->utilities);
+	SWAP(gds_utilities, p_from->gds_utilities);
+	SWAP(methods, p_from->methods);
+	SWAP(lambdas, p_from->lambdas);
+	SWAP(operator_cache_offsets, p_from->operator_cache_offsets);
+	SWAP(global_index_offsets, p_from->global_index_offsets);
+
+	SWAP(_code_size, p_from->_code_size);
+	SWAP(_default_arg_count, p_from->_default_arg_count);
+	SWAP(_constant_count, p_from->_constant_count);
+	SWAP(_global_names_count, p_from->_global_names_count);
+	SWAP(_operator_funcs_count, p_from->_operator_funcs_count);
+	SWAP(_setters_count, p_from->_setters_count);
+	SWAP(_getters_count, p_from->_getters_count);
+	SWAP(_keyed_setters_count, p_from->_keyed_setters_count);
+	SWAP(_keyed_getters_count, p_from->_keyed_getters_count);
+	SWAP(_indexed_setters_count, p_from->_indexed_setters_count);
+	SWAP(_indexed_getters_count, p_from->_indexed_getters_count);
+	SWAP(_builtin_methods_count, p_from->_builtin_methods_count);
+	SWAP(_constructors_count, p_from->_constructors_count);
+	SWAP(_utilities_count, p_from->_utilities_count);
+	SWAP(_gds_utilities_count, p_from->_gds_utilities_count);
+	SWAP(_methods_count, p_from->_methods_count);
+	SWAP(_lambdas_count, p_from->_lambdas_count);
+
+	SWAP(_code_ptr, p_from->_code_ptr);
+	SWAP(_default_arg_ptr, p_from->_default_arg_ptr);
+	SWAP(_constants_ptr, p_from->_constants_ptr);
+	SWAP(_global_names_ptr, p_from->_global_names_ptr);
+	SWAP(_operator_funcs_ptr, p_from->_operator_funcs_ptr);
+	SWAP(_setters_ptr, p_from->_setters_ptr);
+	SWAP(_getters_ptr, p_from->_getters_ptr);
+	SWAP(_keyed_setters_ptr, p_from->_keyed_setters_ptr);
+	SWAP(_keyed_getters_ptr, p_from->_keyed_getters_ptr);
+	SWAP(_indexed_setters_ptr, p_from->_indexed_setters_ptr);
+	SWAP(_indexed_getters_ptr, p_from->_indexed_getters_ptr);
+	SWAP(_builtin_methods_ptr, p_from->_builtin_methods_ptr);
+	SWAP(_constructors_ptr, p_from->_constructors_ptr);
+	SWAP(_utilities_ptr, p_from->_utilities_ptr);
+	SWAP(_gds_utilities_ptr, p_from->_gds_utilities_ptr);
+	SWAP(_methods_ptr, p_from->_methods_ptr);
+	SWAP(_lambdas_ptr, p_from->_lambdas_ptr);
+
+	SWAP(_inline_caches_ptr, p_from->_inline_caches_ptr);
+	SWAP(_inline_cache_count, p_from->_inline_cache_count);
+
+#ifdef DEBUG_ENABLED
+	SWAP(operator_names, p_from->operator_names);
+	SWAP(setter_names, p_from->setter_names);
+	SWAP(getter_names, p_from->getter_names);
+	SWAP(builtin_methods_names, p_from->builtin_methods_names);
+	SWAP(constructors_names, p_from->constructors_names);
+	SWAP(utilities_names, p_from->utilities_names);
+	SWAP(gds_utilities_names, p_from->gds_utilities_names);
+#endif
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -126,6 +240,15 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	GDScriptThreadedCode *tc = threaded_code.load(std::memory_order_acquire);
+	if (tc) {
+		memdelete(tc);
+	}
+
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
@@ -134,26 +257,82 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+uint32_t GDScriptFramePool::get_frame_size(uint32_t p_size) {
+	if (p_size <= 256) {
+		return 256;
+	}
+	if (p_size <= 4096) {
+		return next_power_of_2(p_size);
+	}
+	return p_size;
+}
+
+uint8_t *GDScriptFramePool::alloc(uint32_t p_frame_size) {
+	switch (p_frame_size) {
+		case 256:
+			return frames_256.alloc()->data;
+		case 512:
+			return frames_512.alloc()->data;
+		case 1024:
+			return frames_1024.alloc()->data;
+		case 2048:
+			return frames_2048.alloc()->data;
+		case 4096:
+			return frames_4096.alloc()->data;
+		default:
+			return (uint8_t *)memalloc(p_frame_size);
+	}
+}
+
+void GDScriptFramePool::free(uint8_t *p_frame, uint32_t p_frame_size) {
+	switch (p_frame_size) {
+		case 256:
+			frames_256.free(reinterpret_cast<Frame<256> *>(p_frame));
+			break;
+		case 512:
+			frames_512.free(reinterpret_cast<Frame<512> *>(p_frame));
+			break;
+		case 1024:
+			frames_1024.free(reinterpret_cast<Frame<1024> *>(p_frame));
+			break;
+		case 2048:
+			frames_2048.free(reinterpret_cast<Frame<2048> *>(p_frame));
+			break;
+		case 4096:
+			frames_4096.free(reinterpret_cast<Frame<4096> *>(p_frame));
+			break;
+		default:
+			memfree(p_frame);
+	}
+}
+
+/////////////////////
+
+Variant GDScriptFunctionState::_get_signal_result(const Variant **p_args, int p_argcount) {
+	if (p_argcount == 0) {
+		return Variant();
+	} else if (p_argcount == 1) {
+		return *p_args[0];
+	}
+
+	Array args;
+	for (int i = 0; i < p_argcount; i++) {
+		args.push_back(*p_args[i]);
+	}
+	return args;
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
+	Variant arg = _get_signal_result(p_args, p_argcount - 1);
+
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
 
 	if (self.is_null()) {
@@ -240,7 +419,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
 		// and not copied to the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
@@ -248,6 +427,13 @@ void GDScriptFunctionState::_clear_stack() {
 		}
 		state.stack_size = 0;
 	}
+	if (state.stack) {
+		if (GDScriptLanguage::singleton) {
+			GDScriptLanguage::singleton->frame_pool.free(state.stack, state.frame_size);
+		}
+		state.stack = nullptr;
+		state.frame_size = 0;
+	}
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -257,6 +443,13 @@ void GDScriptFunctionState::_clear_connections() {
 	for (Object::Connection &c : conns) {
 		c.signal.disconnect(c.callable);
 	}
+
+	Ref<GDScriptFunctionState> self; // May free this state when going out of scope.
+	{
+		MutexLock lock(GDScriptLanguage::singleton->mutex);
+		await_list.remove_from_list();
+		self = std::move(await_ref);
+	}
 }
 
 void GDScriptFunctionState::_bind_methods() {
@@ -269,7 +462,8 @@ void GDScriptFunctionState::_bind_methods() {
 
 GDScriptFunctionState::GDScriptFunctionState() :
 		scripts_list(this),
-		instances_list(this) {
+		instances_list(this),
+		await_list(this) {
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
@@ -277,5 +471,124 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
+		await_list.remove_from_list();
+	}
+	_clear_stack();
+}
+
+/////////////////////
+
+bool GDScriptAwaitCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+	return p_a == p_b;
+}
+
+bool GDScriptAwaitCallable::compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+	return p_a < p_b;
+}
+
+void GDScriptAwaitCallable::_unregister() const {
+	if (!registered) {
+		return;
+	}
+	registered = false;
+
+	HashMap<Pair<ObjectID, StringName>, GDScriptAwaitCallable *>::Iterator E = GDScriptLanguage::singleton->await_callables.find(key);
+	if (E && E->value == this) {
+		GDScriptLanguage::singleton->await_callables.remove(E);
+	}
+}
+
+Error GDScriptAwaitCallable::await(const Ref<GDScriptFunctionState> &p_state, const Signal &p_signal) {
+	GDScriptLanguage *language = GDScriptLanguage::singleton;
+	const Pair<ObjectID, StringName> key(p_signal.get_object_id(), p_signal.get_name());
+
+	{
+		MutexLock lock(language->mutex);
+		HashMap<Pair<ObjectID, StringName>, GDScriptAwaitCallable *>::Iterator E = language->await_callables.find(key);
+		if (E) {
+			E->value->waiters.add_last(&p_state->await_list);
+			p_state->await_ref = p_state;
+			return OK;
+		}
+	}
+
+	// First function awaiting this signal (since its last emission).
+	GDScriptAwaitCallable *await_callable = memnew(GDScriptAwaitCallable(key));
+	Callable callable(await_callable);
+	Error err = Signal(p_signal).connect(callable, Object::CONNECT_ONE_SHOT);
+	if (err != OK) {
+		return err;
+	}
+
+	MutexLock lock(language->mutex);
+	language->await_callables[key] = await_callable;
+	await_callable->registered = true;
+	await_callable->waiters.add_last(&p_state->await_list);
+	p_state->await_ref = p_state;
+	return OK;
+}
+
+uint32_t GDScriptAwaitCallable::hash() const {
+	return hash_murmur3_one_64((uint64_t)this);
+}
+
+String GDScriptAwaitCallable::get_as_text() const {
+	return "await(" + String(key.second) + ")";
+}
+
+CallableCustom::CompareEqualFunc GDScriptAwaitCallable::get_compare_equal_func() const {
+	return compare_equal;
+}
+
+CallableCustom::CompareLessFunc GDScriptAwaitCallable::get_compare_less_func() const {
+	return compare_less;
+}
+
+ObjectID GDScriptAwaitCallable::get_object() const {
+	return ObjectID();
+}
+
+void GDScriptAwaitCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+	r_call_error.error = Callable::CallError::CALL_OK;
+	const Variant result = GDScriptFunctionState::_get_signal_result(p_arguments, p_argcount);
+
+	{
+		// The connection is one-shot, so functions awaiting from now on need a new one.
+		MutexLock lock(GDScriptLanguage::singleton->mutex);
+		_unregister();
+	}
+
+	// Resume in the order the functions started waiting. Functions canceled meanwhile (by a script reload or by
+	// their instance being freed) are removed from the list, so they are skipped.
+	while (true) {
+		Ref<GDScriptFunctionState> state;
+		{
+			MutexLock lock(GDScriptLanguage::singleton->mutex);
+			SelfList<GDScriptFunctionState> *first = waiters.first();
+			if (first == nullptr) {
+				break;
+			}
+			waiters.remove(first);
+			state = std::move(first->self()->await_ref);
+		}
+		state->resume(result);
+	}
+}
+
+GDScriptAwaitCallable::GDScriptAwaitCallable(const Pair<ObjectID, StringName> &p_key) :
+		key(p_key) {
+}
+
+GDScriptAwaitCallable::~GDScriptAwaitCallable() {
+	// The connection is gone without being emitted (e.g. the object was freed), release the waiting functions
+	// the same way losing their connections did.
+	LocalVector<Ref<GDScriptFunctionState>> states;
+	if (GDScriptLanguage::singleton) {
+		MutexLock lock(GDScriptLanguage::singleton->mutex);
+		_unregister();
+		while (SelfList<GDScriptFunctionState> *first = waiters.first()) {
+			waiters.remove(first);
+			states.push_back(std::move(first->self()->await_ref));
+		}
 	}
 }
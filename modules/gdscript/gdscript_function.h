@@ -35,13 +35,17 @@
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
 #include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 #include "core/string/string_name.h"
+#include "core/templates/paged_allocator.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
 class GDScriptInstance;
 class GDScript;
+class GDScriptThreadedCode;
+class GDScriptInlineCache;
 
 class GDScriptDataType {
 public:
@@ -269,6 +273,10 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Superinstructions. Same layout as the pair they replace, see `GDScriptByteCodeGenerator::fuse_superinstructions()`.
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -280,6 +288,19 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		// Element access on packed arrays of numeric and vector types, see `GDScriptByteCodeGenerator::write_get()`.
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -458,7 +479,11 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptLanguage;
+	friend class GDScriptThreadedCode;
+	friend class GDScriptInlineCache;
+	friend class TestGDScriptInlineCacheAccessor;
 
 	StringName name;
 	StringName source;
@@ -498,6 +523,10 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Code offsets holding values that only make sense in the running process.
+	Vector<int> operator_cache_offsets; // Signature, return type and evaluator cached by `OPCODE_OPERATOR`.
+	Vector<int> global_index_offsets; // `OPCODE_STORE_GLOBAL` indices into the language global array.
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -534,6 +563,24 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Pre-decoded code used once the function gets hot, see `GDScriptThreadedCode`.
+	std::atomic<GDScriptThreadedCode *> threaded_code = nullptr;
+	SafeNumeric<uint32_t> threaded_code_call_count;
+	SafeFlag threaded_code_unsupported;
+
+	GDScriptThreadedCode *_get_threaded_code(uint32_t p_threshold);
+
+	// One cache per untyped `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL`, see `GDScriptInlineCache`.
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
+	int _inline_cache_count = 0;
+
+	void _create_inline_caches(int p_count);
+
+	// Set while the function only holds its signature, see `GDScriptCompiler::compile_lazy_function()`.
+	SafeFlag lazy_pending;
+
+	void _take_code(GDScriptFunction *p_from);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -554,6 +601,8 @@ private:
 		SafeNumeric<uint64_t> frame_call_count;
 		SafeNumeric<uint64_t> frame_self_time;
 		SafeNumeric<uint64_t> frame_total_time;
+		SafeNumeric<uint64_t> inline_cache_hits;
+		SafeNumeric<uint64_t> inline_cache_misses;
 		uint64_t last_frame_call_count = 0;
 		uint64_t last_frame_self_time = 0;
 		uint64_t last_frame_total_time = 0;
@@ -582,7 +631,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Frame from `GDScriptFramePool`, followed by the instruction arguments.
+		uint32_t frame_size = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -615,9 +665,32 @@ public:
 	~GDScriptFunction();
 };
 
+// Fixed-size frames holding the stack of suspended functions, pooled by size class
+// so that awaiting doesn't go through the general purpose allocator.
+class GDScriptFramePool {
+	template <uint32_t SIZE>
+	struct Frame {
+		alignas(Variant) uint8_t data[SIZE];
+	};
+
+	PagedAllocator<Frame<256>, true> frames_256{ 256 };
+	PagedAllocator<Frame<512>, true> frames_512{ 128 };
+	PagedAllocator<Frame<1024>, true> frames_1024{ 64 };
+	PagedAllocator<Frame<2048>, true> frames_2048{ 32 };
+	PagedAllocator<Frame<4096>, true> frames_4096{ 16 };
+
+public:
+	// Size of the frame that holds `p_size` bytes. Bigger frames than the largest size class aren't pooled.
+	static uint32_t get_frame_size(uint32_t p_size);
+
+	uint8_t *alloc(uint32_t p_frame_size);
+	void free(uint8_t *p_frame, uint32_t p_frame_size);
+};
+
 class GDScriptFunctionState : public RefCounted {
 	GDCLASS(GDScriptFunctionState, RefCounted);
 	friend class GDScriptFunction;
+	friend class GDScriptAwaitCallable;
 	GDScriptFunction *function = nullptr;
 	GDScriptFunction::CallState state;
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
@@ -626,6 +699,12 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// While waiting in a `GDScriptAwaitCallable`, the state keeps itself alive like a connection would.
+	SelfList<GDScriptFunctionState> await_list;
+	Ref<GDScriptFunctionState> await_ref;
+
+	static Variant _get_signal_result(const Variant **p_args, int p_argcount);
+
 protected:
 	static void _bind_methods();
 
@@ -646,3 +725,30 @@ public:
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
+
+// Resumes every function awaiting the same signal from a single one-shot connection,
+// so an emission doesn't go through one connection per suspended function.
+class GDScriptAwaitCallable : public CallableCustom {
+	Pair<ObjectID, StringName> key;
+	mutable SelfList<GDScriptFunctionState>::List waiters;
+	mutable bool registered = false;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
+
+	void _unregister() const;
+
+public:
+	// Suspends `p_state` until `p_signal` is emitted.
+	static Error await(const Ref<GDScriptFunctionState> &p_state, const Signal &p_signal);
+
+	uint32_t hash() const override;
+	String get_as_text() const override;
+	CompareEqualFunc get_compare_equal_func() const override;
+	CompareLessFunc get_compare_less_func() const override;
+	ObjectID get_object() const override;
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
+
+	GDScriptAwaitCallable(const Pair<ObjectID, StringName> &p_key);
+	~GDScriptAwaitCallable();
+};
@@ -0,0 +1,371 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_inline_cache.h"
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint64_t> GDScriptInlineCache::last_version;
+
+bool GDScriptInlineCache::_depends_on(const GDScript *p_script, const GDScript *p_dependency) {
+	// Entries resolved on a script can point into its bases, and nested classes are compiled along with their owner.
+	if (p_script == nullptr) {
+		return false;
+	}
+	return p_script == p_dependency || _depends_on(p_script->_base, p_dependency) || _depends_on(p_script->_owner, p_dependency);
+}
+
+void GDScriptInlineCache::invalidate(GDScript *p_script) {
+	p_script->inline_cache_version.set(next_version());
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	MutexLock lock(language->mutex);
+	for (SelfList<GDScript> *E = language->script_list.first(); E; E = E->next()) {
+		if (E->self() != p_script && _depends_on(E->self(), p_script)) {
+			E->self()->inline_cache_version.set(next_version());
+		}
+	}
+}
+
+GDScriptFunction *GDScriptInlineCache::_find_script_function(const GDScript *p_script, const StringName &p_name) {
+	// Same lookup as `GDScriptInstance::callp()`.
+	const GDScript *sptr = p_script;
+	while (sptr) {
+		if (likely(sptr->valid)) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+			if (E) {
+				return E->value;
+			}
+		}
+		sptr = sptr->_base;
+	}
+	return nullptr;
+}
+
+GDScriptInstance *GDScriptInlineCache::_get_script_instance(Object *p_object, bool &r_cacheable) {
+	ScriptInstance *si = p_object->get_script_instance();
+	if (!si) {
+		r_cacheable = true;
+		return nullptr;
+	}
+	r_cacheable = si->get_language() == GDScriptLanguage::get_singleton() && !si->is_placeholder();
+	return r_cacheable ? static_cast<GDScriptInstance *>(si) : nullptr;
+}
+
+bool GDScriptInlineCache::_is_native_cacheable(const StringName &p_class) {
+	// Extension classes can be unloaded along with their method binds, and may override `_get()`/`_set()`.
+	const ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_find(Object *p_object, const GDScriptInstance *p_instance) const {
+	const GDScript *script = p_instance ? p_instance->script.ptr() : nullptr;
+	const uint64_t version = script ? script->inline_cache_version.get() : 0;
+	const StringName &class_name = p_object->get_class_name();
+
+	// Newer entries come first, so one resolved again is found before the stale one it replaces.
+	const Entry *e = entry.load(std::memory_order_acquire);
+	for (uint32_t i = 0; e && i < MAX_SHAPES; i++, e = e->previous) {
+		if (likely(e->script == script && e->version == version && e->class_name == class_name)) {
+			return e;
+		}
+	}
+	return nullptr;
+}
+
+GDScriptInlineCache::Entry *GDScriptInlineCache::_begin_resolve(Object *p_object, const GDScriptInstance *p_instance) {
+	if (misses.get() >= MAX_MISSES) {
+		return nullptr;
+	}
+
+	const GDScript *script = p_instance ? p_instance->script.ptr() : nullptr;
+	const StringName &class_name = p_object->get_class_name();
+	const Entry *head = entry.load(std::memory_order_acquire);
+	bool new_shape = true;
+	for (const Entry *e = head; e; e = e->previous) {
+		if (e->script == script && e->class_name == class_name) {
+			new_shape = false; // Its script changed since it was resolved.
+			break;
+		}
+	}
+	if (new_shape) {
+		if (entry_count.get() >= MAX_ENTRIES) {
+			return nullptr;
+		}
+		if (head) {
+			// Other receiver shapes were cached before, the site is polymorphic.
+			misses.increment();
+		}
+	}
+
+	Entry *resolved = memnew(Entry);
+	resolved->script = script;
+	resolved->version = script ? script->inline_cache_version.get() : 0;
+	resolved->new_shape = new_shape;
+	resolved->class_name = class_name;
+	return resolved;
+}
+
+const GDScriptInlineCache::Entry *GDScriptInlineCache::_end_resolve(Entry *p_entry, bool p_resolved) {
+	if (!p_resolved) {
+		memdelete(p_entry);
+		misses.increment();
+		return nullptr;
+	}
+
+	// Threads resolving the same site at once may each add one entry past the limit.
+	if (p_entry->new_shape) {
+		entry_count.increment();
+	}
+	Entry *previous = entry.load(std::memory_order_acquire);
+	do {
+		p_entry->previous = previous;
+	} while (!entry.compare_exchange_weak(previous, p_entry, std::memory_order_acq_rel));
+	return p_entry;
+}
+
+void GDScriptInlineCache::_record(GDScriptFunction *p_function, bool p_hit) const {
+#ifdef DEBUG_ENABLED
+	if (unlikely(GDScriptLanguage::get_singleton()->profiling)) {
+		if (p_hit) {
+			p_function->profile.inline_cache_hits.increment();
+		} else {
+			p_function->profile.inline_cache_misses.increment();
+		}
+	}
+#endif
+}
+
+bool GDScriptInlineCache::get_named(GDScriptFunction *p_function, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *object = p_base->get_validated_object();
+	bool cacheable = false;
+	GDScriptInstance *instance = object ? _get_script_instance(object, cacheable) : nullptr;
+	if (!cacheable) {
+		return false;
+	}
+
+	const Entry *e = _find(object, instance);
+	_record(p_function, e != nullptr);
+	if (unlikely(!e)) {
+		Entry *resolved = _begin_resolve(object, instance);
+		if (!resolved) {
+			return false;
+		}
+
+		bool ok = false;
+		if (instance) {
+			// Same lookup as `GDScriptInstance::get()`, only for member variables.
+			const GDScript *script = instance->script.ptr();
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+			if (E) {
+				if (likely(script->valid) && E->value.getter) {
+					resolved->kind = KIND_SCRIPT_FUNCTION;
+					resolved->function = _find_script_function(script, E->value.getter);
+					ok = resolved->function != nullptr;
+				} else {
+					resolved->kind = KIND_MEMBER;
+					resolved->member_index = E->value.index;
+					ok = true;
+				}
+			}
+		} else if (_is_native_cacheable(resolved->class_name)) {
+			// Same lookup as `ClassDB::get_property()`, only for properties with a plain getter.
+			const StringName getter = ClassDB::get_property_getter(resolved->class_name, p_name);
+			if (getter != StringName() && ClassDB::get_property_index(resolved->class_name, p_name) == -1) {
+				resolved->kind = KIND_METHOD_BIND;
+				resolved->method = ClassDB::get_method(resolved->class_name, getter);
+				ok = resolved->method != nullptr;
+			}
+		}
+
+		e = _end_resolve(resolved, ok);
+		if (!e) {
+			return false;
+		}
+	}
+
+	switch (e->kind) {
+		case KIND_MEMBER: {
+			r_ret = instance->members[e->member_index];
+		} break;
+		case KIND_SCRIPT_FUNCTION: {
+			Callable::CallError err;
+			const Variant ret = e->function->call(instance, nullptr, 0, err);
+			r_ret = (err.error == Callable::CallError::CALL_OK) ? ret : Variant();
+		} break;
+		case KIND_METHOD_BIND: {
+			Callable::CallError err;
+			r_ret = e->method->call(object, nullptr, 0, err);
+		} break;
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::set_named(GDScriptFunction *p_function, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *object = p_base->get_validated_object();
+	bool cacheable = false;
+	GDScriptInstance *instance = object ? _get_script_instance(object, cacheable) : nullptr;
+	if (!instance) {
+		// Native properties keep going through `Object::set()`.
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	// `Object::set()` marks the object as edited, which only matters to the editor.
+	if (!object->is_edited() && Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif
+
+	const Entry *e = _find(object, instance);
+	_record(p_function, e != nullptr);
+	if (unlikely(!e)) {
+		Entry *resolved = _begin_resolve(object, instance);
+		if (!resolved) {
+			return false;
+		}
+
+		// Same lookup as `GDScriptInstance::set()`, only for member variables.
+		const GDScript *script = instance->script.ptr();
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		bool ok = false;
+		if (E) {
+			resolved->member_type = &E->value.data_type;
+			if (likely(script->valid) && E->value.setter) {
+				resolved->kind = KIND_SCRIPT_FUNCTION;
+				resolved->function = _find_script_function(script, E->value.setter);
+				ok = resolved->function != nullptr;
+			} else {
+				resolved->kind = KIND_MEMBER;
+				resolved->member_index = E->value.index;
+				ok = true;
+			}
+		}
+
+		e = _end_resolve(resolved, ok);
+		if (!e) {
+			return false;
+		}
+	}
+
+	if (e->member_type->has_type && !e->member_type->is_type(p_value)) {
+		// Let the generic path convert the value or fail.
+		return false;
+	}
+
+	if (e->kind == KIND_MEMBER) {
+		instance->members.write[e->member_index] = p_value;
+		r_valid = true;
+	} else {
+		const Variant value = p_value;
+		const Variant *args = &value;
+		Callable::CallError err;
+		e->function->call(instance, &args, 1, err);
+		r_valid = err.error == Callable::CallError::CALL_OK;
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::call(GDScriptFunction *p_function, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *object = p_base->get_validated_object();
+	bool cacheable = false;
+	GDScriptInstance *instance = object ? _get_script_instance(object, cacheable) : nullptr;
+	if (!cacheable) {
+		return false;
+	}
+
+	const Entry *e = _find(object, instance);
+	_record(p_function, e != nullptr);
+	if (unlikely(!e)) {
+		Entry *resolved = _begin_resolve(object, instance);
+		if (!resolved) {
+			return false;
+		}
+
+		// Same lookup as `Object::callp()`, except for the methods it handles specially.
+		bool ok = false;
+		if (p_name != CoreStringName(free_) && p_name != SceneStringName(_ready)) {
+			if (instance) {
+				resolved->function = _find_script_function(instance->script.ptr(), p_name);
+			}
+			if (resolved->function) {
+				resolved->kind = KIND_SCRIPT_FUNCTION;
+				ok = true;
+			} else if (_is_native_cacheable(resolved->class_name)) {
+				resolved->kind = KIND_METHOD_BIND;
+				resolved->method = ClassDB::get_method(resolved->class_name, p_name);
+				ok = resolved->method != nullptr;
+			}
+		}
+
+		e = _end_resolve(resolved, ok);
+		if (!e) {
+			return false;
+		}
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(object);
+#endif
+	if (e->kind == KIND_SCRIPT_FUNCTION) {
+		r_ret = e->function->call(instance, p_args, p_argcount, r_error);
+		if (unlikely(r_error.error == Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
+			MethodBind *method = ClassDB::get_method(object->get_class_name(), p_name);
+			if (method) {
+				r_ret = method->call(object, p_args, p_argcount, r_error);
+			}
+		}
+	} else {
+		r_ret = e->method->call(object, p_args, p_argcount, r_error);
+	}
+	return true;
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	Entry *e = entry.load(std::memory_order_acquire);
+	while (e) {
+		Entry *previous = e->previous;
+		memdelete(e);
+		e = previous;
+	}
+}
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScript;
+class GDScriptFunction;
+class GDScriptInstance;
+class MethodBind;
+struct GDScriptDataType;
+
+// Inline cache for the untyped `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL` instructions.
+// Each instruction owns one cache, remembering how the name was resolved for the last few receiver shapes:
+// the script of the receiver (or none) and its native class. When the next receiver has a known shape,
+// the member index, script function or `MethodBind` is used directly instead of going through the
+// lookups done by `Object::get()`, `Object::set()` and `Object::callp()`.
+//
+// Only resolutions that are guaranteed to give the same result as the generic path are cached; anything
+// else (typed member conversions, `_get()`/`_set()` fallbacks, extension classes, ...) returns `false`
+// so the interpreter takes the generic path. Entries hold the version of the receiver's script, which
+// changes when that script, one of its bases or the class it is nested in is recompiled or cleared.
+class GDScriptInlineCache {
+	enum Kind {
+		KIND_MEMBER, // Script member variable without accessor.
+		KIND_SCRIPT_FUNCTION, // Script method, or accessor of a script member variable.
+		KIND_METHOD_BIND, // Native method, or getter of a native property.
+	};
+
+	struct Entry {
+		Entry *previous = nullptr; // Replaced entries may still be read by other threads, they are freed with the cache.
+		const GDScript *script = nullptr; // `nullptr` for receivers without a script.
+		uint64_t version = 0; // Of the script, see `invalidate()`.
+		bool new_shape = true; // Not a shape resolved again after its script changed.
+		StringName class_name;
+		Kind kind = KIND_MEMBER;
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+	};
+
+	// Number of receiver shapes checked on lookup. Sites that keep seeing new shapes, or names that can't
+	// be cached, are left to the generic path after `MAX_MISSES` attempts.
+	static constexpr uint32_t MAX_SHAPES = 4;
+	static constexpr uint32_t MAX_MISSES = 8;
+	// Receiver shapes kept per site. Resolving a shape again after its script changed replaces its entry
+	// on lookup without counting, the stale one is only freed with the cache.
+	static constexpr uint32_t MAX_ENTRIES = 16;
+
+	static SafeNumeric<uint64_t> last_version;
+
+	std::atomic<Entry *> entry = nullptr;
+	SafeNumeric<uint32_t> misses;
+	SafeNumeric<uint32_t> entry_count;
+
+	static GDScriptFunction *_find_script_function(const GDScript *p_script, const StringName &p_name);
+	static GDScriptInstance *_get_script_instance(Object *p_object, bool &r_cacheable);
+	static bool _is_native_cacheable(const StringName &p_class);
+	static bool _depends_on(const GDScript *p_script, const GDScript *p_dependency);
+
+	const Entry *_find(Object *p_object, const GDScriptInstance *p_instance) const;
+	Entry *_begin_resolve(Object *p_object, const GDScriptInstance *p_instance);
+	const Entry *_end_resolve(Entry *p_entry, bool p_resolved);
+	void _record(GDScriptFunction *p_function, bool p_hit) const;
+
+public:
+	static uint64_t next_version() { return last_version.increment(); }
+	static void invalidate(GDScript *p_script);
+
+	bool get_named(GDScriptFunction *p_function, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool set_named(GDScriptFunction *p_function, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	bool call(GDScriptFunction *p_function, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	~GDScriptInlineCache();
+};
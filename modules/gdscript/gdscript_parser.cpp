@@ -795,6 +795,48 @@ const HashMap<String, Ref<GDScriptParserRef>> &GDScriptParser::get_depended_pars
 	return depended_parsers;
 }
 
+// Collects the scripts this one is likely to depend on, from the parse tree alone.
+// This is a conservative guess made before analysis (which is what actually resolves dependencies),
+// so it may include paths that end up unused.
+void GDScriptParser::get_referenced_script_paths(HashSet<String> &r_paths) const {
+	const String base_dir = script_path.get_base_dir();
+	const StringName gdscript_language = GDScriptLanguage::get_singleton()->get_name();
+
+	for (const Node *node = list; node != nullptr; node = node->next) {
+		String path;
+		switch (node->type) {
+			case Node::CLASS: {
+				path = static_cast<const ClassNode *>(node)->extends_path;
+			} break;
+			case Node::PRELOAD: {
+				const ExpressionNode *path_node = static_cast<const PreloadNode *>(node)->path;
+				if (path_node != nullptr && path_node->type == Node::LITERAL) {
+					const Variant &value = static_cast<const LiteralNode *>(path_node)->value;
+					if (value.get_type() == Variant::STRING) {
+						path = value;
+					}
+				}
+			} break;
+			case Node::IDENTIFIER: {
+				const StringName &name = static_cast<const IdentifierNode *>(node)->name;
+				if (ScriptServer::is_global_class(name) && ScriptServer::get_global_class_language(name) == gdscript_language) {
+					path = ScriptServer::get_global_class_path(name);
+				}
+			} break;
+			default:
+				break;
+		}
+
+		if (path.is_empty() || path.get_extension().to_lower() != "gd") {
+			continue;
+		}
+		if (path.is_relative_path()) {
+			path = base_dir.path_join(path);
+		}
+		r_paths.insert(path.simplify_path());
+	}
+}
+
 GDScriptParser::ClassNode *GDScriptParser::find_class(const String &p_qualified_name) const {
 	String first = p_qualified_name.get_slice("::", 0);
 
@@ -0,0 +1,283 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#include "gdscript.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+
+SafeFlag GDScriptSampler::active;
+Thread GDScriptSampler::timer_thread;
+uint32_t GDScriptSampler::interval_usec = 10000;
+Mutex GDScriptSampler::mutex;
+LocalVector<GDScriptSampler::ThreadData *> GDScriptSampler::threads;
+HashMap<String, uint64_t> GDScriptSampler::samples;
+thread_local GDScriptSampler::ThreadDataOwner GDScriptSampler::thread_data;
+Ref<GDScriptSampler::Profiler> GDScriptSampler::profiler;
+
+GDScriptSampler::ThreadDataOwner::~ThreadDataOwner() {
+	if (data == nullptr) {
+		return;
+	}
+	MutexLock lock(mutex);
+	threads.erase(data);
+	memdelete(data);
+}
+
+void GDScriptSampler::_timer_thread_func(void *p_userdata) {
+	while (active.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+
+		MutexLock lock(mutex);
+		for (ThreadData *data : threads) {
+			data->pending_ticks.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+GDScriptSampler::ThreadData *GDScriptSampler::_get_thread_data() {
+	if (likely(thread_data.data != nullptr)) {
+		return thread_data.data;
+	}
+
+	ThreadData *data = memnew(ThreadData);
+	if (Thread::get_caller_id() == Thread::get_main_id()) {
+		data->name = "Main Thread";
+	} else {
+		data->name = vformat("Thread %d", (uint64_t)Thread::get_caller_id());
+	}
+
+	MutexLock lock(mutex);
+	threads.push_back(data);
+	thread_data.data = data;
+	return data;
+}
+
+void GDScriptSampler::_record(const String &p_leaf) {
+	ThreadData *data = _get_thread_data();
+	if (data->pending_ticks.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+	const uint32_t weight = data->pending_ticks.exchange(0, std::memory_order_relaxed);
+
+	// Ticks counted while no script was running on this thread are dropped.
+	const GDScriptLanguage::CallLevel *level = GDScriptLanguage::_call_stack;
+	if (level == nullptr || weight == 0) {
+		return;
+	}
+
+	LocalVector<String> frames;
+	for (; level != nullptr; level = level->prev) {
+		if (level->function == nullptr) {
+			continue;
+		}
+		frames.push_back(level->function->get_script()->get_script_path() + ":" + String(level->function->get_name()));
+	}
+
+	String stack = data->name;
+	for (int i = (int)frames.size() - 1; i >= 0; i--) {
+		stack += ";" + frames[i];
+	}
+	if (!p_leaf.is_empty()) {
+		stack += ";" + p_leaf;
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = samples.find(stack);
+	if (E) {
+		E->value += weight;
+	} else {
+		samples.insert(stack, weight);
+	}
+}
+
+void GDScriptSampler::poll_native(const MethodBind *p_method) {
+	ThreadData *data = _get_thread_data();
+	if (data->pending_ticks.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+	_record(String(p_method->get_instance_class()) + "::" + String(p_method->get_name()));
+}
+
+bool GDScriptSampler::start(uint32_t p_frequency) {
+#ifdef THREADS_ENABLED
+	ERR_FAIL_COND_V_MSG(p_frequency == 0, false, "The sampling frequency must be greater than zero.");
+	ERR_FAIL_COND_V_MSG(!GDScriptLanguage::get_singleton()->should_track_call_stack(), false, "The GDScript sampling profiler needs call stacks to be tracked. Enable \"debug/settings/gdscript/always_track_call_stacks\" in the project settings.");
+	if (timer_thread.is_started()) {
+		stop();
+	}
+	interval_usec = MAX(1000000u / p_frequency, 1u);
+	active.set();
+	timer_thread.start(&GDScriptSampler::_timer_thread_func, nullptr);
+	return true;
+#else
+	ERR_FAIL_V_MSG(false, "The GDScript sampling profiler requires thread support.");
+#endif
+}
+
+void GDScriptSampler::stop() {
+	active.clear();
+	if (timer_thread.is_started()) {
+		timer_thread.wait_to_finish();
+	}
+}
+
+void GDScriptSampler::clear() {
+	MutexLock lock(mutex);
+	samples.clear();
+}
+
+String GDScriptSampler::_get_collapsed_stacks(const HashMap<String, uint64_t> &p_samples) {
+	String collapsed;
+	for (const KeyValue<String, uint64_t> &E : p_samples) {
+		collapsed += E.key + " " + itos(E.value) + "\n";
+	}
+	return collapsed;
+}
+
+String GDScriptSampler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+	return _get_collapsed_stacks(samples);
+}
+
+String GDScriptSampler::_get_speedscope_json(const HashMap<String, uint64_t> &p_samples, uint32_t p_interval_usec) {
+	HashMap<String, int> frame_indices;
+	Array frames;
+	Array stacks;
+	Array weights;
+	uint64_t total = 0;
+	for (const KeyValue<String, uint64_t> &E : p_samples) {
+		Array stack;
+		for (const String &name : E.key.split(";")) {
+			HashMap<String, int>::Iterator F = frame_indices.find(name);
+			if (!F) {
+				F = frame_indices.insert(name, frames.size());
+				Dictionary frame;
+				frame["name"] = name;
+				frames.push_back(frame);
+			}
+			stack.push_back(F->value);
+		}
+		stacks.push_back(stack);
+		weights.push_back(E.value * p_interval_usec);
+		total += E.value * p_interval_usec;
+	}
+
+	Dictionary shared;
+	shared["frames"] = frames;
+
+	Dictionary profile;
+	profile["type"] = "sampled";
+	profile["name"] = "GDScript";
+	profile["unit"] = "microseconds";
+	profile["startValue"] = 0;
+	profile["endValue"] = total;
+	profile["samples"] = stacks;
+	profile["weights"] = weights;
+
+	Dictionary file;
+	file["$schema"] = "https://www.speedscope.app/file-format-schema.json";
+	file["shared"] = shared;
+	file["profiles"] = Array{ profile };
+	file["exporter"] = "Godot GDScript sampler";
+	return JSON::stringify(file, "", false);
+}
+
+String GDScriptSampler::get_speedscope_json() {
+	HashMap<String, uint64_t> snapshot;
+	{
+		MutexLock lock(mutex);
+		snapshot = samples;
+	}
+	return _get_speedscope_json(snapshot, interval_usec);
+}
+
+Error GDScriptSampler::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Can't open file to save GDScript samples: \"%s\".", p_path));
+	if (p_path.get_extension().to_lower() == "json") {
+		file->store_string(get_speedscope_json());
+	} else {
+		file->store_string(get_collapsed_stacks());
+	}
+	return OK;
+}
+
+void GDScriptSampler::Profiler::toggle(bool p_enable, const Array &p_opts) {
+	if (!p_enable) {
+		GDScriptSampler::stop();
+		return;
+	}
+	uint32_t frequency = 100;
+	if (p_opts.size() > 0 && p_opts[0].get_type() == Variant::INT) {
+		frequency = MAX(1, int(p_opts[0]));
+	}
+	GDScriptSampler::clear();
+	GDScriptSampler::start(frequency);
+	last_send_time = OS::get_singleton()->get_ticks_msec();
+}
+
+void GDScriptSampler::Profiler::tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+	// Sends the samples collected since the last message about once per second.
+	uint64_t time = OS::get_singleton()->get_ticks_msec();
+	if (time - last_send_time < 1000) {
+		return;
+	}
+	last_send_time = time;
+
+	HashMap<String, uint64_t> taken;
+	{
+		MutexLock lock(mutex);
+		if (samples.is_empty()) {
+			return;
+		}
+		taken = samples;
+		samples.clear();
+	}
+	Array arr = { GDScriptSampler::_get_collapsed_stacks(taken) };
+	EngineDebugger::get_singleton()->send_message("gdscript:sampler", arr);
+}
+
+void GDScriptSampler::initialize() {
+	profiler.instantiate();
+	profiler->bind("gdscript:sampler");
+}
+
+void GDScriptSampler::finalize() {
+	stop();
+	profiler.unref();
+	clear();
+}
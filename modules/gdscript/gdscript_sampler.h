@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+class MethodBind;
+
+// Statistical profiler for GDScript. A timer thread counts ticks for every thread that runs scripts,
+// and each thread records its own call stack the next time it enters or leaves a function (or returns
+// from a native method), weighted by the ticks counted since. This adds no timing work to calls and
+// works in release builds, but it needs call stacks to be tracked, which release builds only do with
+// `debug/settings/gdscript/always_track_call_stacks`.
+//
+// Samples are aggregated as collapsed stacks (one line per unique stack, frames separated by `;`,
+// followed by the weight), which is also the format sent to the debugger through the
+// `gdscript:sampler` profiler.
+class GDScriptSampler {
+	friend class TestGDScriptSamplerAccessor;
+
+	struct ThreadData {
+		std::atomic<uint32_t> pending_ticks = 0;
+		String name;
+	};
+
+	// Unregisters the thread data when the thread exits.
+	struct ThreadDataOwner {
+		ThreadData *data = nullptr;
+		~ThreadDataOwner();
+	};
+
+	class Profiler : public EngineProfiler {
+		uint64_t last_send_time = 0;
+
+	public:
+		void toggle(bool p_enable, const Array &p_opts) override;
+		void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override;
+	};
+
+	static SafeFlag active;
+	static Thread timer_thread;
+	static uint32_t interval_usec;
+	static Mutex mutex;
+	static LocalVector<ThreadData *> threads;
+	static HashMap<String, uint64_t> samples;
+	static thread_local ThreadDataOwner thread_data;
+	static Ref<Profiler> profiler;
+
+	static void _timer_thread_func(void *p_userdata);
+	static ThreadData *_get_thread_data();
+	static void _record(const String &p_leaf);
+	static String _get_collapsed_stacks(const HashMap<String, uint64_t> &p_samples);
+	static String _get_speedscope_json(const HashMap<String, uint64_t> &p_samples, uint32_t p_interval_usec);
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+
+	// Called by the VM with the call stack of the current thread in a consistent state.
+	static void poll() { _record(String()); }
+	static void poll_native(const MethodBind *p_method);
+
+	static bool start(uint32_t p_frequency);
+	static void stop();
+	static bool is_running() { return timer_thread.is_started(); }
+
+	static void clear();
+	static String get_collapsed_stacks();
+	static String get_speedscope_json();
+	// Saves speedscope JSON if the extension is `json`, collapsed stacks otherwise.
+	static Error save(const String &p_path);
+
+	static void initialize();
+	static void finalize();
+};
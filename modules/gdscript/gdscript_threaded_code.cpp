@@ -0,0 +1,780 @@
+/**************************************************************************/
+/*  gdscript_threaded_code.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_threaded_code.h"
+
+#include "gdscript_sampler.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/variant/variant_internal.h"
+
+#define OPERAND(m_idx) (p_ctx.addresses[p_op->operands[m_idx].type] + p_op->operands[m_idx].index)
+#define DEOPT                     \
+	{                             \
+		p_ctx.exit_ip = p_op->ip; \
+		return nullptr;           \
+	}
+
+namespace {
+
+enum Continuation {
+	CONTINUE_NEXT,
+	CONTINUE_ASSIGN,
+	CONTINUE_JUMP_IF,
+	CONTINUE_JUMP_IF_NOT,
+	CONTINUE_MAX,
+};
+
+template <typename T>
+struct ValuePtr;
+
+template <>
+struct ValuePtr<bool> {
+	static _FORCE_INLINE_ bool *get(Variant *p_v) { return VariantInternal::get_bool(p_v); }
+};
+
+template <>
+struct ValuePtr<int64_t> {
+	static _FORCE_INLINE_ int64_t *get(Variant *p_v) { return VariantInternal::get_int(p_v); }
+};
+
+template <>
+struct ValuePtr<double> {
+	static _FORCE_INLINE_ double *get(Variant *p_v) { return VariantInternal::get_float(p_v); }
+};
+
+// Same expressions as the matching `OperatorEvaluator*` in `variant_op.h`.
+struct OpAdd {
+	template <typename T>
+	static _FORCE_INLINE_ T apply(T p_a, T p_b) { return p_a + p_b; }
+};
+struct OpSubtract {
+	template <typename T>
+	static _FORCE_INLINE_ T apply(T p_a, T p_b) { return p_a - p_b; }
+};
+struct OpMultiply {
+	template <typename T>
+	static _FORCE_INLINE_ T apply(T p_a, T p_b) { return p_a * p_b; }
+};
+struct OpEqual {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a == p_b; }
+};
+struct OpNotEqual {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a != p_b; }
+};
+struct OpLess {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a < p_b; }
+};
+struct OpLessEqual {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a <= p_b; }
+};
+struct OpGreater {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a > p_b; }
+};
+struct OpGreaterEqual {
+	template <typename T>
+	static _FORCE_INLINE_ bool apply(T p_a, T p_b) { return p_a >= p_b; }
+};
+
+} // namespace
+
+using Op = GDScriptThreadedCode::Op;
+using Context = GDScriptThreadedCode::Context;
+using Handler = GDScriptThreadedCode::Handler;
+
+template <int CONT>
+static _FORCE_INLINE_ const Op *_continue_operator(const Op *p_op, Context &p_ctx, Variant *p_result, bool p_condition) {
+	if constexpr (CONT == CONTINUE_ASSIGN) {
+		*OPERAND(3) = *p_result;
+	} else if constexpr (CONT == CONTINUE_JUMP_IF) {
+		if (p_condition) {
+			return p_op->jump;
+		}
+	} else if constexpr (CONT == CONTINUE_JUMP_IF_NOT) {
+		if (!p_condition) {
+			return p_op->jump;
+		}
+	}
+	return p_op + 1;
+}
+
+template <int CONT>
+static const Op *_operator_validated(const Op *p_op, Context &p_ctx) {
+	Variant *dst = OPERAND(2);
+	p_op->operator_func(OPERAND(0), OPERAND(1), dst);
+	if constexpr (CONT == CONTINUE_JUMP_IF || CONT == CONTINUE_JUMP_IF_NOT) {
+		return _continue_operator<CONT>(p_op, p_ctx, dst, dst->booleanize());
+	} else {
+		return _continue_operator<CONT>(p_op, p_ctx, dst, false);
+	}
+}
+
+template <typename T, typename R, typename F, int CONT>
+static const Op *_operator_typed(const Op *p_op, Context &p_ctx) {
+	Variant *dst = OPERAND(2);
+	const R result = F::apply(*ValuePtr<T>::get(OPERAND(0)), *ValuePtr<T>::get(OPERAND(1)));
+	*ValuePtr<R>::get(dst) = result;
+	if constexpr (std::is_same_v<R, bool>) {
+		return _continue_operator<CONT>(p_op, p_ctx, dst, result);
+	} else if constexpr (CONT == CONTINUE_JUMP_IF || CONT == CONTINUE_JUMP_IF_NOT) {
+		return _continue_operator<CONT>(p_op, p_ctx, dst, result != 0);
+	} else {
+		return _continue_operator<CONT>(p_op, p_ctx, dst, false);
+	}
+}
+
+struct TypedOperator {
+	Variant::Operator op;
+	Variant::Type type;
+	Handler handlers[CONTINUE_MAX];
+};
+
+#define TYPED_OPERATOR(m_op, m_vtype, m_type, m_ret, m_f)                 \
+	{                                                                     \
+		Variant::m_op, Variant::m_vtype,                                  \
+		{                                                                 \
+			&_operator_typed<m_type, m_ret, m_f, CONTINUE_NEXT>,          \
+			&_operator_typed<m_type, m_ret, m_f, CONTINUE_ASSIGN>,        \
+			&_operator_typed<m_type, m_ret, m_f, CONTINUE_JUMP_IF>,       \
+			&_operator_typed<m_type, m_ret, m_f, CONTINUE_JUMP_IF_NOT>,   \
+		}                                                                 \
+	}
+
+#define TYPED_OPERATORS(m_vtype, m_type)                                        \
+	TYPED_OPERATOR(OP_ADD, m_vtype, m_type, m_type, OpAdd),                     \
+			TYPED_OPERATOR(OP_SUBTRACT, m_vtype, m_type, m_type, OpSubtract),   \
+			TYPED_OPERATOR(OP_MULTIPLY, m_vtype, m_type, m_type, OpMultiply),   \
+			TYPED_OPERATOR(OP_EQUAL, m_vtype, m_type, bool, OpEqual),           \
+			TYPED_OPERATOR(OP_NOT_EQUAL, m_vtype, m_type, bool, OpNotEqual),    \
+			TYPED_OPERATOR(OP_LESS, m_vtype, m_type, bool, OpLess),             \
+			TYPED_OPERATOR(OP_LESS_EQUAL, m_vtype, m_type, bool, OpLessEqual),  \
+			TYPED_OPERATOR(OP_GREATER, m_vtype, m_type, bool, OpGreater),       \
+			TYPED_OPERATOR(OP_GREATER_EQUAL, m_vtype, m_type, bool, OpGreaterEqual)
+
+static const TypedOperator typed_operators[] = {
+	TYPED_OPERATORS(INT, int64_t),
+	TYPED_OPERATORS(FLOAT, double),
+};
+
+#undef TYPED_OPERATORS
+#undef TYPED_OPERATOR
+
+static const Handler operator_validated_handlers[CONTINUE_MAX] = {
+	&_operator_validated<CONTINUE_NEXT>,
+	&_operator_validated<CONTINUE_ASSIGN>,
+	&_operator_validated<CONTINUE_JUMP_IF>,
+	&_operator_validated<CONTINUE_JUMP_IF_NOT>,
+};
+
+static Handler _get_operator_handler(Variant::ValidatedOperatorEvaluator p_func, Continuation p_continuation) {
+	for (const TypedOperator &typed : typed_operators) {
+		if (Variant::get_validated_operator_evaluator(typed.op, typed.type, typed.type) == p_func) {
+			return typed.handlers[p_continuation];
+		}
+	}
+	return operator_validated_handlers[p_continuation];
+}
+
+static const Op *_assign(const Op *p_op, Context &p_ctx) {
+	*OPERAND(0) = *OPERAND(1);
+	return p_op + 1;
+}
+
+static const Op *_assign_null(const Op *p_op, Context &p_ctx) {
+	*OPERAND(0) = Variant();
+	return p_op + 1;
+}
+
+static const Op *_assign_true(const Op *p_op, Context &p_ctx) {
+	*OPERAND(0) = true;
+	return p_op + 1;
+}
+
+static const Op *_assign_false(const Op *p_op, Context &p_ctx) {
+	*OPERAND(0) = false;
+	return p_op + 1;
+}
+
+template <typename T>
+static const Op *_type_adjust(const Op *p_op, Context &p_ctx) {
+	VariantTypeAdjust<T>::adjust(OPERAND(0));
+	return p_op + 1;
+}
+
+static const Op *_jump(const Op *p_op, Context &p_ctx) {
+	return p_op->jump;
+}
+
+static const Op *_jump_if(const Op *p_op, Context &p_ctx) {
+	return OPERAND(0)->booleanize() ? p_op->jump : p_op + 1;
+}
+
+static const Op *_jump_if_not(const Op *p_op, Context &p_ctx) {
+	return OPERAND(0)->booleanize() ? p_op + 1 : p_op->jump;
+}
+
+static const Op *_jump_to_def_argument(const Op *p_op, Context &p_ctx) {
+	return p_ctx.default_args[p_ctx.defarg];
+}
+
+static const Op *_line(const Op *p_op, Context &p_ctx) {
+	if (unlikely(EngineDebugger::is_active())) {
+		DEOPT; // Let the interpreter handle breakpoints and stepping from here on.
+	}
+	*p_ctx.line = p_op->line;
+	return p_op + 1;
+}
+
+static const Op *_return(const Op *p_op, Context &p_ctx) {
+	*p_ctx.retvalue = *OPERAND(0);
+	p_ctx.exit_ip = p_ctx.end_ip;
+	return nullptr;
+}
+
+static const Op *_return_typed_builtin(const Op *p_op, Context &p_ctx) {
+	const Variant *r = OPERAND(0);
+	if (unlikely(r->get_type() != p_op->type)) {
+		DEOPT; // Conversion or error.
+	}
+	*p_ctx.retvalue = *r;
+	p_ctx.exit_ip = p_ctx.end_ip;
+	return nullptr;
+}
+
+static const Op *_iterate_begin_int(const Op *p_op, Context &p_ctx) {
+	Variant *counter = OPERAND(0);
+	const int64_t size = *VariantInternal::get_int(OPERAND(1));
+
+	VariantInternal::initialize(counter, Variant::INT);
+	*VariantInternal::get_int(counter) = 0;
+
+	if (size > 0) {
+		Variant *iterator = OPERAND(2);
+		VariantInternal::initialize(iterator, Variant::INT);
+		*VariantInternal::get_int(iterator) = 0;
+		return p_op + 1;
+	}
+	return p_op->jump;
+}
+
+static const Op *_iterate_int(const Op *p_op, Context &p_ctx) {
+	const int64_t size = *VariantInternal::get_int(OPERAND(1));
+	int64_t *count = VariantInternal::get_int(OPERAND(0));
+
+	(*count)++;
+
+	if (*count >= size) {
+		return p_op->jump;
+	}
+	*VariantInternal::get_int(OPERAND(2)) = *count;
+	return p_op + 1;
+}
+
+static const Op *_iterate_begin_range(const Op *p_op, Context &p_ctx) {
+	Variant *counter = OPERAND(0);
+	const int64_t from = *VariantInternal::get_int(OPERAND(1));
+	const int64_t to = *VariantInternal::get_int(OPERAND(2));
+	const int64_t step = *VariantInternal::get_int(OPERAND(3));
+
+	VariantInternal::initialize(counter, Variant::INT);
+	*VariantInternal::get_int(counter) = from;
+
+	const bool do_continue = from == to ? false : (from < to ? step > 0 : step < 0);
+	if (do_continue) {
+		Variant *iterator = OPERAND(4);
+		VariantInternal::initialize(iterator, Variant::INT);
+		*VariantInternal::get_int(iterator) = from;
+		return p_op + 1;
+	}
+	return p_op->jump;
+}
+
+static const Op *_iterate_range(const Op *p_op, Context &p_ctx) {
+	const int64_t to = *VariantInternal::get_int(OPERAND(1));
+	const int64_t step = *VariantInternal::get_int(OPERAND(2));
+	int64_t *count = VariantInternal::get_int(OPERAND(0));
+
+	*count += step;
+
+	if ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {
+		return p_op->jump;
+	}
+	*VariantInternal::get_int(OPERAND(3)) = *count;
+	return p_op + 1;
+}
+
+static const Op *_get_indexed_validated(const Op *p_op, Context &p_ctx) {
+	bool oob;
+	p_op->indexed_getter(OPERAND(0), *VariantInternal::get_int(OPERAND(1)), OPERAND(2), &oob);
+	if (unlikely(oob)) {
+		DEOPT;
+	}
+	return p_op + 1;
+}
+
+static const Op *_set_indexed_validated(const Op *p_op, Context &p_ctx) {
+	bool oob;
+	p_op->indexed_setter(OPERAND(0), *VariantInternal::get_int(OPERAND(1)), OPERAND(2), &oob);
+	if (unlikely(oob)) {
+		DEOPT;
+	}
+	return p_op + 1;
+}
+
+template <typename T, typename E>
+static const Op *_get_indexed_packed(const Op *p_op, Context &p_ctx) {
+	const Vector<T> *array = VariantGetInternalPtr<Vector<T>>::get_ptr(OPERAND(0));
+	int64_t index = *VariantInternal::get_int(OPERAND(1));
+	if (index < 0) {
+		index += array->size();
+	}
+	if (unlikely((uint64_t)index >= (uint64_t)array->size())) {
+		DEOPT;
+	}
+	Variant *dst = OPERAND(2);
+	VariantTypeAdjust<E>::adjust(dst);
+	*VariantGetInternalPtr<E>::get_ptr(dst) = array->ptr()[index];
+	return p_op + 1;
+}
+
+template <typename T, typename E>
+static const Op *_set_indexed_packed(const Op *p_op, Context &p_ctx) {
+	Vector<T> *array = VariantGetInternalPtr<Vector<T>>::get_ptr(OPERAND(0));
+	int64_t index = *VariantInternal::get_int(OPERAND(1));
+	if (index < 0) {
+		index += array->size();
+	}
+	if (unlikely((uint64_t)index >= (uint64_t)array->size())) {
+		DEOPT;
+	}
+	array->ptrw()[index] = *VariantGetInternalPtr<E>::get_ptr(OPERAND(2));
+	return p_op + 1;
+}
+
+static _FORCE_INLINE_ void _load_call_args(const Op *p_op, Context &p_ctx) {
+	const GDScriptThreadedCode::Operand *operands = p_ctx.call_operands + p_op->call_args;
+	for (uint32_t i = 0; i < p_op->call_arg_count; i++) {
+		p_ctx.instruction_args[i] = p_ctx.addresses[operands[i].type] + operands[i].index;
+	}
+}
+
+static const Op *_call_utility_validated(const Op *p_op, Context &p_ctx) {
+	_load_call_args(p_op, p_ctx);
+	p_op->utility(p_ctx.instruction_args[p_op->argc], (const Variant **)p_ctx.instruction_args, p_op->argc);
+	return p_op + 1;
+}
+
+static const Op *_call_builtin_type_validated(const Op *p_op, Context &p_ctx) {
+	_load_call_args(p_op, p_ctx);
+	Variant **args = p_ctx.instruction_args;
+	p_op->builtin_method(args[p_op->argc], (const Variant **)args, p_op->argc, args[p_op->argc + 1]);
+	return p_op + 1;
+}
+
+template <bool RETURN>
+static const Op *_call_method_bind_validated(const Op *p_op, Context &p_ctx) {
+	_load_call_args(p_op, p_ctx);
+	Variant **args = p_ctx.instruction_args;
+
+#ifdef DEBUG_ENABLED
+	bool freed = false;
+	Object *base_obj = args[p_op->argc]->get_validated_object_with_check(freed);
+	if (unlikely(freed || !base_obj)) {
+		DEOPT;
+	}
+#else
+	Object *base_obj = *VariantInternal::get_object(args[p_op->argc]);
+#endif
+
+	Variant *ret = args[p_op->argc + 1];
+	if constexpr (RETURN) {
+		p_op->method->validated_call(base_obj, (const Variant **)args, ret);
+	} else {
+		VariantInternal::initialize(ret, Variant::NIL);
+		p_op->method->validated_call(base_obj, (const Variant **)args, nullptr);
+	}
+	if (unlikely(GDScriptSampler::is_active())) {
+		GDScriptSampler::poll_native(p_op->method);
+	}
+	return p_op + 1;
+}
+
+static const Op *_end(const Op *p_op, Context &p_ctx) {
+	// Returning `null` is left to the interpreter.
+	p_ctx.exit_ip = p_op->ip;
+	return nullptr;
+}
+
+#undef DEOPT
+#undef OPERAND
+
+bool GDScriptThreadedCode::_translate(const GDScriptFunction *p_function) {
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	if (!code || code_size == 0 || code[code_size - 1] != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+	end_ip = code_size - 1;
+
+	LocalVector<int> op_at_ip;
+	op_at_ip.resize(code_size + 1);
+	for (int &index : op_at_ip) {
+		index = -1;
+	}
+
+	auto operand = [&](int p_address, Operand &r_operand) -> bool {
+		const uint32_t type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		const uint32_t index = p_address & GDScriptFunction::ADDR_MASK;
+		switch (type) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				if (index >= (uint32_t)p_function->_stack_size) {
+					return false;
+				}
+				break;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				if (index >= (uint32_t)p_function->_constant_count) {
+					return false;
+				}
+				break;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				uses_members = true;
+				break;
+			default:
+				return false;
+		}
+		r_operand.type = type;
+		r_operand.index = index;
+		return true;
+	};
+
+#define OPERANDS(m_count)                                 \
+	for (int i = 0; i < m_count; i++) {                   \
+		if (!operand(code[ip + 1 + i], op.operands[i])) { \
+			return false;                                 \
+		}                                                 \
+	}
+#define CHECK_INDEX(m_index, m_count)              \
+	if ((m_index) < 0 || (m_index) >= (m_count)) { \
+		return false;                              \
+	}
+#define LENGTH(m_length)           \
+	length = m_length;             \
+	if (ip + length > code_size) { \
+		return false;              \
+	}
+
+	int ip = 0;
+	while (ip < code_size) {
+		Op op;
+		op.ip = ip;
+		int length = 0;
+
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				LENGTH(code[ip] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED ? 5 : 8);
+				OPERANDS(3);
+				CHECK_INDEX(code[ip + 4], p_function->_operator_funcs_count);
+				op.operator_func = p_function->_operator_funcs_ptr[code[ip + 4]];
+
+				Continuation continuation = CONTINUE_NEXT;
+				if (code[ip] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+					continuation = CONTINUE_ASSIGN;
+					if (!operand(code[ip + 6], op.operands[3])) {
+						return false;
+					}
+				} else if (code[ip] != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+					continuation = code[ip] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF ? CONTINUE_JUMP_IF : CONTINUE_JUMP_IF_NOT;
+					op.jump_ip = code[ip + 7];
+				}
+				op.handler = _get_operator_handler(op.operator_func, continuation);
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				LENGTH(3);
+				OPERANDS(2);
+				op.handler = &_assign;
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				LENGTH(2);
+				OPERANDS(1);
+				if (code[ip] == GDScriptFunction::OPCODE_ASSIGN_NULL) {
+					op.handler = &_assign_null;
+				} else {
+					op.handler = code[ip] == GDScriptFunction::OPCODE_ASSIGN_TRUE ? &_assign_true : &_assign_false;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I: {
+				LENGTH(2);
+				OPERANDS(1);
+				switch (code[ip]) {
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+						op.handler = &_type_adjust<bool>;
+						break;
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+						op.handler = &_type_adjust<int64_t>;
+						break;
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT:
+						op.handler = &_type_adjust<double>;
+						break;
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+						op.handler = &_type_adjust<Vector2>;
+						break;
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I:
+						op.handler = &_type_adjust<Vector2i>;
+						break;
+					case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+						op.handler = &_type_adjust<Vector3>;
+						break;
+					default:
+						op.handler = &_type_adjust<Vector3i>;
+						break;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_JUMP: {
+				LENGTH(2);
+				op.jump_ip = code[ip + 1];
+				op.handler = &_jump;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				LENGTH(3);
+				OPERANDS(1);
+				op.jump_ip = code[ip + 2];
+				op.handler = code[ip] == GDScriptFunction::OPCODE_JUMP_IF ? &_jump_if : &_jump_if_not;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+				LENGTH(1);
+				op.handler = &_jump_to_def_argument;
+			} break;
+			case GDScriptFunction::OPCODE_LINE: {
+				LENGTH(2);
+				op.line = code[ip + 1];
+				op.handler = &_line;
+			} break;
+			case GDScriptFunction::OPCODE_RETURN: {
+				LENGTH(2);
+				OPERANDS(1);
+				op.handler = &_return;
+			} break;
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+				LENGTH(3);
+				OPERANDS(1);
+				CHECK_INDEX(code[ip + 2], Variant::VARIANT_MAX);
+				op.type = (Variant::Type)code[ip + 2];
+				op.handler = &_return_typed_builtin;
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+			case GDScriptFunction::OPCODE_ITERATE_INT: {
+				LENGTH(5);
+				OPERANDS(3);
+				op.jump_ip = code[ip + 4];
+				op.handler = code[ip] == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? &_iterate_begin_int : &_iterate_int;
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+				LENGTH(7);
+				OPERANDS(5);
+				op.jump_ip = code[ip + 6];
+				op.handler = &_iterate_begin_range;
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+				LENGTH(6);
+				OPERANDS(4);
+				op.jump_ip = code[ip + 5];
+				op.handler = &_iterate_range;
+			} break;
+			case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+				LENGTH(5);
+				OPERANDS(3);
+				CHECK_INDEX(code[ip + 4], p_function->_indexed_getters_count);
+				op.indexed_getter = p_function->_indexed_getters_ptr[code[ip + 4]];
+				op.handler = &_get_indexed_validated;
+			} break;
+			case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+				LENGTH(5);
+				OPERANDS(3);
+				CHECK_INDEX(code[ip + 4], p_function->_indexed_setters_count);
+				op.indexed_setter = p_function->_indexed_setters_ptr[code[ip + 4]];
+				op.handler = &_set_indexed_validated;
+			} break;
+#define TRANSLATE_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_variant_elem_type) \
+	case GDScriptFunction::OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY: {         \
+		LENGTH(4);                                                                   \
+		OPERANDS(3);                                                                 \
+		op.handler = &_get_indexed_packed<m_elem_type, m_variant_elem_type>;         \
+	} break;                                                                         \
+	case GDScriptFunction::OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY: {         \
+		LENGTH(4);                                                                   \
+		OPERANDS(3);                                                                 \
+		op.handler = &_set_indexed_packed<m_elem_type, m_variant_elem_type>;         \
+	} break
+
+				TRANSLATE_INDEXED_PACKED_ARRAY(INT32, int32_t, int64_t);
+				TRANSLATE_INDEXED_PACKED_ARRAY(INT64, int64_t, int64_t);
+				TRANSLATE_INDEXED_PACKED_ARRAY(FLOAT32, float, double);
+				TRANSLATE_INDEXED_PACKED_ARRAY(FLOAT64, double, double);
+				TRANSLATE_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, Vector2);
+				TRANSLATE_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, Vector3);
+#undef TRANSLATE_INDEXED_PACKED_ARRAY
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				// Layout: opcode, instruction argument count, addresses..., argc, function index.
+				if (ip + 1 >= code_size) {
+					return false;
+				}
+				const int instr_arg_count = code[ip + 1];
+				if (instr_arg_count < 0 || instr_arg_count > p_function->_instruction_args_size) {
+					return false;
+				}
+				LENGTH(instr_arg_count + 4);
+				op.call_args = call_operands.size();
+				op.call_arg_count = instr_arg_count;
+				for (int i = 0; i < instr_arg_count; i++) {
+					Operand arg;
+					if (!operand(code[ip + 2 + i], arg)) {
+						return false;
+					}
+					call_operands.push_back(arg);
+				}
+				op.argc = code[ip + 2 + instr_arg_count];
+				const int function_index = code[ip + 3 + instr_arg_count];
+
+				// The result (and base for method calls) follow the arguments.
+				const int extra_args = code[ip] == GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED ? 1 : 2;
+				if (op.argc < 0 || op.argc + extra_args > instr_arg_count) {
+					return false;
+				}
+
+				switch (code[ip]) {
+					case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+						CHECK_INDEX(function_index, p_function->_utilities_count);
+						op.utility = p_function->_utilities_ptr[function_index];
+						op.handler = &_call_utility_validated;
+						break;
+					case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+						CHECK_INDEX(function_index, p_function->_builtin_methods_count);
+						op.builtin_method = p_function->_builtin_methods_ptr[function_index];
+						op.handler = &_call_builtin_type_validated;
+						break;
+					default:
+						CHECK_INDEX(function_index, p_function->_methods_count);
+						op.method = p_function->_methods_ptr[function_index];
+						if (code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN) {
+							op.handler = &_call_method_bind_validated<true>;
+						} else {
+							op.handler = &_call_method_bind_validated<false>;
+						}
+						break;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_END: {
+				LENGTH(1);
+				op.handler = &_end;
+			} break;
+			default:
+				return false; // Not supported, keep interpreting this function.
+		}
+
+		op_at_ip[ip] = ops.size();
+		ops.push_back(op);
+		ip += length;
+	}
+
+#undef LENGTH
+#undef CHECK_INDEX
+#undef OPERANDS
+
+	// Resolve jumps once the array does not move anymore.
+	for (Op &op : ops) {
+		if (op.jump_ip < 0) {
+			continue;
+		}
+		if (op.jump_ip > code_size || op_at_ip[op.jump_ip] < 0) {
+			return false;
+		}
+		op.jump = &ops[op_at_ip[op.jump_ip]];
+	}
+
+	if (p_function->_default_arg_count > 0) {
+		for (int i = 0; i <= p_function->_default_arg_count; i++) {
+			const int target = p_function->_default_arg_ptr[i];
+			if (target < 0 || target > code_size || op_at_ip[target] < 0) {
+				return false;
+			}
+			default_args.push_back(&ops[op_at_ip[target]]);
+		}
+	}
+
+	return true;
+}
+
+GDScriptThreadedCode *GDScriptThreadedCode::create(const GDScriptFunction *p_function) {
+	GDScriptThreadedCode *threaded_code = memnew(GDScriptThreadedCode);
+	if (!threaded_code->_translate(p_function)) {
+		memdelete(threaded_code);
+		return nullptr;
+	}
+	return threaded_code;
+}
+
+int GDScriptThreadedCode::run(Variant *const *p_addresses, Variant **p_instruction_args, int p_defarg, int &r_line, Variant &r_retvalue) const {
+	Context ctx;
+	ctx.addresses = p_addresses;
+	ctx.instruction_args = p_instruction_args;
+	ctx.call_operands = call_operands.ptr();
+	ctx.default_args = default_args.ptr();
+	ctx.defarg = p_defarg;
+	ctx.line = &r_line;
+	ctx.retvalue = &r_retvalue;
+	ctx.end_ip = end_ip;
+
+	const Op *op = ops.ptr();
+	do {
+		op = op->handler(op, ctx);
+	} while (op);
+
+	return ctx.exit_ip;
+}
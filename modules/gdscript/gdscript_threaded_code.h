@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  gdscript_threaded_code.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/local_vector.h"
+
+// Second execution tier for hot functions. The bytecode of a function is pre-decoded once into
+// an array of operations, each pointing to a handler specialized for that instruction (and for
+// the operand types of common `int` and `float` operators), so the per-instruction decoding done
+// by the interpreter loop is paid only when the function is translated.
+//
+// Only functions made entirely of supported instructions are translated, which in practice means
+// fully typed code. The interpreter stays the reference implementation: a handler that would have
+// to report an error, or that notices the debugger became active, stops and returns the position
+// of its instruction so the interpreter executes it instead and carries on from there.
+class GDScriptThreadedCode {
+public:
+	struct Context;
+	struct Op;
+	typedef const Op *(*Handler)(const Op *p_op, Context &p_ctx);
+
+	struct Operand {
+		uint32_t type = 0;
+		uint32_t index = 0;
+	};
+
+	struct Op {
+		Handler handler = nullptr;
+		const Op *jump = nullptr;
+		int ip = 0; // Position of the instruction in the bytecode.
+		int jump_ip = -1;
+		Operand operands[5];
+		uint32_t call_args = 0; // Start of the call arguments in `call_operands`.
+		uint32_t call_arg_count = 0;
+		int argc = 0;
+		union {
+			Variant::ValidatedOperatorEvaluator operator_func;
+			Variant::ValidatedIndexedGetter indexed_getter;
+			Variant::ValidatedIndexedSetter indexed_setter;
+			Variant::ValidatedBuiltInMethod builtin_method;
+			Variant::ValidatedUtilityFunction utility;
+			MethodBind *method;
+			Variant::Type type;
+			int line;
+		};
+
+		Op() :
+				operator_func(nullptr) {}
+	};
+
+	struct Context {
+		Variant *const *addresses = nullptr;
+		Variant **instruction_args = nullptr;
+		const Operand *call_operands = nullptr;
+		const Op *const *default_args = nullptr;
+		int defarg = 0;
+		int *line = nullptr;
+		Variant *retvalue = nullptr;
+		int end_ip = 0;
+		int exit_ip = 0;
+	};
+
+private:
+	LocalVector<Op> ops;
+	LocalVector<Operand> call_operands;
+	LocalVector<const Op *> default_args;
+	int end_ip = 0;
+	bool uses_members = false;
+
+	bool _translate(const GDScriptFunction *p_function);
+
+public:
+	// Returns `nullptr` if the function contains instructions this tier does not handle.
+	static GDScriptThreadedCode *create(const GDScriptFunction *p_function);
+
+	_FORCE_INLINE_ bool needs_instance() const { return uses_members; }
+
+	// Runs the function from its start. Returns the bytecode position where the interpreter must
+	// continue: the final `OPCODE_END` if the function returned, otherwise the instruction to redo.
+	int run(Variant *const *p_addresses, Variant **p_instruction_args, int p_defarg, int &r_line, Variant &r_retvalue) const;
+};
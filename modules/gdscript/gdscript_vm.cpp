@@ -29,8 +29,11 @@
 /**************************************************************************/
 
 #include "gdscript.h"
+#include "gdscript_compiler.h"
 #include "gdscript_function.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_threaded_code.h"
 
 #include "core/os/os.h"
 
@@ -254,6 +257,9 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -265,6 +271,18 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                              \
 		&&OPCODE_GET_KEYED_VALIDATED,                    \
 		&&OPCODE_GET_INDEXED_VALIDATED,                  \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,       \
 		&&OPCODE_SET_NAMED,                              \
 		&&OPCODE_SET_NAMED_VALIDATED,                    \
 		&&OPCODE_GET_NAMED,                              \
@@ -497,6 +515,10 @@ void (*type_init_function_table[])(Variant *) = {
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
+	if (unlikely(lazy_pending.is_set()) && !GDScriptCompiler::compile_lazy_function(this)) {
+		return _get_default_variant_for_data_type(return_type);
+	}
+
 	if (!_code_ptr) {
 		return _get_default_variant_for_data_type(return_type);
 	}
@@ -540,11 +562,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->frame_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -735,8 +757,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 	bool awaited = false;
+	bool stack_moved = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	// Hot functions start on their threaded code, which returns where the interpreter has to take over.
+	const uint32_t threaded_code_threshold = GDScriptLanguage::get_singleton()->get_threaded_code_threshold();
+	if (threaded_code_threshold > 0 && !p_state && !EngineDebugger::is_active()) {
+		const GDScriptThreadedCode *tc = _get_threaded_code(threaded_code_threshold);
+#ifdef DEBUG_ENABLED
+		// Profiling is done per instruction, leave it to the interpreter.
+		if (GDScriptLanguage::get_singleton()->profiling) {
+			tc = nullptr;
+		}
+#endif
+		if (tc && (p_instance || !tc->needs_instance())) {
+			ip = tc->run(variant_addresses, instruction_args, defarg, line, retvalue);
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -849,6 +887,71 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+				GET_VARIANT_PTR(target, 5);
+
+				operator_func(a, b, dst);
+				*target = *dst;
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (dst->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1192,8 +1295,72 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#ifdef DEBUG_ENABLED
+#define OPCODE_PACKED_ARRAY_INDEX_OOB(m_access, m_base, m_index)                                                                                 \
+	err_text = "Out of bounds " m_access " index '" + itos(*VariantInternal::get_int(m_index)) + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define OPCODE_PACKED_ARRAY_INDEX_OOB(m_access, m_base, m_index) ((void)0)
+#endif
+
+// Same behavior as the validated indexed getter and setter, with the element access inlined.
+#define OPCODE_SET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_value_get_func) \
+	OPCODE(OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                   \
+		CHECK_SPACE(3);                                                                        \
+		GET_VARIANT_PTR(dst, 0);                                                               \
+		GET_VARIANT_PTR(index, 1);                                                             \
+		GET_VARIANT_PTR(value, 2);                                                             \
+		Vector<m_elem_type> *array = VariantInternal::m_get_func(dst);                         \
+		int64_t int_index = *VariantInternal::get_int(index);                                  \
+		if (int_index < 0) {                                                                   \
+			int_index += array->size();                                                        \
+		}                                                                                      \
+		if (likely((uint64_t)int_index < (uint64_t)array->size())) {                           \
+			array->ptrw()[int_index] = *VariantInternal::m_value_get_func(value);              \
+		} else {                                                                               \
+			OPCODE_PACKED_ARRAY_INDEX_OOB("set", dst, index);                                  \
+		}                                                                                      \
+		ip += 4;                                                                               \
+	}                                                                                          \
+	DISPATCH_OPCODE
+
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                             \
+		CHECK_SPACE(3);                                                                                  \
+		GET_VARIANT_PTR(src, 0);                                                                         \
+		GET_VARIANT_PTR(index, 1);                                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                                         \
+		const Vector<m_elem_type> *array = VariantInternal::m_get_func((const Variant *)src);            \
+		int64_t int_index = *VariantInternal::get_int(index);                                            \
+		if (int_index < 0) {                                                                             \
+			int_index += array->size();                                                                  \
+		}                                                                                                \
+		if (likely((uint64_t)int_index < (uint64_t)array->size())) {                                     \
+			VariantTypeAdjust<m_ret_type>::adjust(dst);                                                  \
+			*VariantInternal::m_ret_get_func(dst) = array->ptr()[int_index];                             \
+		} else {                                                                                         \
+			OPCODE_PACKED_ARRAY_INDEX_OOB("get", src, index);                                            \
+		}                                                                                                \
+		ip += 4;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, get_vector2);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, get_vector3);
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, Vector3, get_vector3);
+
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1203,8 +1370,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_caches_ptr[cache_idx].set_named(this, dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1225,7 +1397,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1245,7 +1417,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1255,13 +1427,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+
+				bool valid = true;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
+				Variant ret;
+				if (!_inline_caches_ptr[cache_idx].get_named(this, src, *index, ret)) {
+					ret = src->get_named(*index, valid);
+				}
 #else
-				*dst = src->get_named(*index, valid);
+				Variant ret;
+				if (_inline_caches_ptr[cache_idx].get_named(this, src, *index, ret)) {
+					*dst = ret;
+				} else {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1270,7 +1452,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1889,7 +2071,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1900,6 +2082,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_cache_count);
+				GDScriptInlineCache *inline_cache = &_inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1918,7 +2104,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!inline_cache->call(this, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1947,7 +2135,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
+				} else if (!inline_cache->call(this, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
@@ -2003,7 +2191,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2054,6 +2242,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					temp_ret = method->call(base_obj, (const Variant **)argptrs, argc, err);
 				}
 
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
+
 #ifdef DEBUG_ENABLED
 
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
@@ -2281,6 +2473,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_INSTRUCTION_ARG(ret, argc + 1);
 				method->validated_call(base_obj, (const Variant **)argptrs, ret);
 
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
+
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					uint64_t t_taken = OS::get_singleton()->get_ticks_usec() - call_time;
@@ -2331,6 +2527,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				VariantInternal::initialize(ret, Variant::NIL);
 				method->validated_call(base_obj, (const Variant **)argptrs, nullptr);
 
+				if (unlikely(GDScriptSampler::is_active())) {
+					GDScriptSampler::poll_native(method);
+				}
+
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling && GDScriptLanguage::get_singleton()->profile_native_calls) {
 					uint64_t t_taken = OS::get_singleton()->get_ticks_usec() - call_time;
@@ -2569,12 +2769,22 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
+					if (p_state) {
+						// Already running from a frame, which the new state takes over.
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.frame_size = p_state->frame_size;
+						p_state->stack = nullptr;
+						p_state->frame_size = 0;
+						p_state->stack_size = 0;
+					} else {
+						gdfs->state.frame_size = GDScriptFramePool::get_frame_size(alloca_size);
+						gdfs->state.stack = GDScriptLanguage::get_singleton()->frame_pool.alloc(gdfs->state.frame_size);
 
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						// Variants can be relocated, so the stack is moved instead of copied.
+						// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
+						memcpy(&gdfs->state.stack[sizeof(Variant) * FIXED_ADDRESSES_MAX], (void *)&stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
 					}
+					stack_moved = true;
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
@@ -2605,7 +2815,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = GDScriptAwaitCallable::await(gdfs, sig);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -3975,9 +4185,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	if (!p_state || awaited) {
 		GDScriptLanguage::get_singleton()->exit_function();
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses. When awaiting, it was moved to the function state.
+		if (!stack_moved) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 	}
 
@@ -0,0 +1,42 @@
+extends SceneTree
+
+# Suspends many functions on signals and measures how long it takes to suspend
+# them all and to resume them with a single emission.
+
+signal tick(value: int)
+
+const COROUTINES = 100_000
+
+var resumed: int = 0
+
+
+func _init() -> void:
+	var start := Time.get_ticks_usec()
+	for i in COROUTINES:
+		_wait_tick()
+	print("await_%d: %d usec" % [COROUTINES, Time.get_ticks_usec() - start])
+
+	start = Time.get_ticks_usec()
+	tick.emit(1)
+	print("resume_%d: %d usec (%d)" % [COROUTINES, Time.get_ticks_usec() - start, resumed])
+
+	start = Time.get_ticks_usec()
+	for i in COROUTINES:
+		_wait_ticks(4)
+	for i in 4:
+		tick.emit(1)
+	print("await_resume_4x%d: %d usec (%d)" % [COROUTINES, Time.get_ticks_usec() - start, resumed])
+	quit()
+
+
+func _wait_tick() -> void:
+	var a: int = 1
+	var b: float = 2.0
+	var name := "npc"
+	resumed += await tick
+	resumed += a + int(b) - name.length()
+
+
+func _wait_ticks(p_count: int) -> void:
+	for i in p_count:
+		resumed += await tick
@@ -0,0 +1,58 @@
+extends SceneTree
+
+# Small helpers called in a tight loop that only read from array and dictionary
+# literals. Literals holding only constants are folded by the analyzer, so none
+# of these allocate a container per call.
+
+const ITERATIONS = 2_000_000
+
+
+func _init() -> void:
+	_run("literal_content_test", _literal_content_test)
+	_run("literal_lookup", _literal_lookup)
+	_run("literal_iteration", _literal_iteration)
+	quit()
+
+
+func _run(p_name: String, p_case: Callable) -> void:
+	var start := Time.get_ticks_usec()
+	var result: Variant = p_case.call()
+	print("%s: %d usec (%s)" % [p_name, Time.get_ticks_usec() - start, result])
+
+
+func _is_vowel(p_char: String) -> bool:
+	return p_char in ["a", "e", "i", "o", "u"]
+
+
+func _weight(p_kind: int) -> float:
+	return {0: 1.0, 1: 2.5, 2: 4.0, 3: 0.5}[p_kind]
+
+
+func _sum_offsets(p_base: int) -> int:
+	var total: int = 0
+	for offset: int in [-1, 0, 1, 2]:
+		total += p_base + offset
+	return total
+
+
+func _literal_content_test() -> int:
+	var letters := "abcdefghijklmnopqrstuvwxyz"
+	var hits: int = 0
+	for i in ITERATIONS:
+		if _is_vowel(letters[i % 26]):
+			hits += 1
+	return hits
+
+
+func _literal_lookup() -> float:
+	var total: float = 0.0
+	for i in ITERATIONS:
+		total += _weight(i & 3)
+	return total
+
+
+func _literal_iteration() -> int:
+	var total: int = 0
+	for i in ITERATIONS:
+		total += _sum_offsets(i)
+	return total
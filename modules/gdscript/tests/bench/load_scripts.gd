@@ -0,0 +1,41 @@
+extends SceneTree
+
+# Generates projects of interdependent scripts and measures how long loading
+# the root script (which pulls in all the others) takes.
+
+const SCRIPT_COUNTS = [500, 2000]
+const BRANCHING = 4
+
+
+func _init() -> void:
+	for count: int in SCRIPT_COUNTS:
+		var dir := "user://bench_load_scripts_%d_%d" % [count, Time.get_ticks_usec()]
+		_generate(dir, count)
+		var start := Time.get_ticks_usec()
+		var script: GDScript = load(dir.path_join("script_0.gd"))
+		print("load_%d_scripts: %d usec (%s)" % [count, Time.get_ticks_usec() - start, script.can_instantiate()])
+		_remove(dir, count)
+	quit()
+
+
+func _generate(p_dir: String, p_count: int) -> void:
+	DirAccess.make_dir_recursive_absolute(p_dir)
+	for i in p_count:
+		var source := "extends RefCounted\n\n"
+		for child in range(i * BRANCHING + 1, mini(i * BRANCHING + BRANCHING + 1, p_count)):
+			source += "const Dep%d = preload(\"script_%d.gd\")\n" % [child, child]
+		source += "\nvar value: int = %d\n" % i
+		for method in 20:
+			source += "\n\nfunc method_%d(p_value: int) -> int:\n" % method
+			source += "\tvar result := p_value\n"
+			source += "\tfor j in p_value:\n"
+			source += "\t\tif j %% 3 == 0:\n\t\t\tresult += j * value\n\t\telse:\n\t\t\tresult -= %d\n" % method
+			source += "\treturn result\n"
+		var file := FileAccess.open(p_dir.path_join("script_%d.gd" % i), FileAccess.WRITE)
+		file.store_string(source)
+
+
+func _remove(p_dir: String, p_count: int) -> void:
+	for i in p_count:
+		DirAccess.remove_absolute(p_dir.path_join("script_%d.gd" % i))
+	DirAccess.remove_absolute(p_dir)
@@ -0,0 +1,43 @@
+extends SceneTree
+
+const ITERATIONS = 5_000_000
+
+
+func _init() -> void:
+	_run("while_compare", _while_compare)
+	_run("for_range_branch", _for_range_branch)
+	_run("logic_operators", _logic_operators)
+	quit()
+
+
+func _run(p_name: String, p_case: Callable) -> void:
+	var start := Time.get_ticks_usec()
+	var result: Variant = p_case.call()
+	print("%s: %d usec (%s)" % [p_name, Time.get_ticks_usec() - start, result])
+
+
+func _while_compare() -> int:
+	var i: int = 0
+	var total: int = 0
+	while i < ITERATIONS:
+		total += i & 7
+		i += 1
+	return total
+
+
+func _for_range_branch() -> int:
+	var even: int = 0
+	for i in ITERATIONS:
+		if i % 2 == 0:
+			even += 1
+	return even
+
+
+func _logic_operators() -> int:
+	var hits: int = 0
+	var x: float = 0.0
+	for i in ITERATIONS:
+		x += 0.5
+		if x > 10.0 and x < 1000.0 or x == 2.0:
+			hits += 1
+	return hits
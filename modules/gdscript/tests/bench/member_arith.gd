@@ -0,0 +1,34 @@
+extends SceneTree
+
+const ITERATIONS = 5_000_000
+
+var counter: int = 0
+var position_sum := Vector2()
+
+
+func _init() -> void:
+	_run("member_int", _member_int)
+	_run("member_vector", _member_vector)
+	quit()
+
+
+func _run(p_name: String, p_case: Callable) -> void:
+	var start := Time.get_ticks_usec()
+	var result: Variant = p_case.call()
+	print("%s: %d usec (%s)" % [p_name, Time.get_ticks_usec() - start, result])
+
+
+func _member_int() -> int:
+	counter = 0
+	for i in ITERATIONS:
+		counter += 3
+		counter -= 1
+	return counter
+
+
+func _member_vector() -> Vector2:
+	position_sum = Vector2()
+	var step := Vector2(0.5, 0.25)
+	for i in ITERATIONS:
+		position_sum += step
+	return position_sum
@@ -131,11 +131,13 @@ void finish_language() {
 
 StringName GDScriptTestRunner::test_function_name;
 
-GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames, bool p_use_binary_tokens) {
+GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames, bool p_use_binary_tokens, bool p_use_threaded_code, bool p_use_lazy_compilation) {
 	test_function_name = StringName("test");
 	do_init_languages = p_init_language;
 	print_filenames = p_print_filenames;
 	binary_tokens = p_use_binary_tokens;
+	threaded_code = p_use_threaded_code;
+	lazy_compilation = p_use_lazy_compilation;
 
 	source_dir = p_source_dir;
 	if (!source_dir.ends_with("/")) {
@@ -145,6 +147,16 @@ GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_l
 	if (do_init_languages) {
 		init_language(p_source_dir);
 	}
+	if (threaded_code) {
+		// Translate functions on their first call, so results must match the interpreter ones.
+		previous_threaded_code_threshold = GDScriptLanguage::get_singleton()->get_threaded_code_threshold();
+		GDScriptLanguage::get_singleton()->set_threaded_code_threshold(1);
+	}
+	if (lazy_compilation) {
+		// Scripts are reloaded before running, so results must match the ones compiled upfront.
+		previous_lazy_compilation = GDScriptLanguage::get_singleton()->should_compile_lazily();
+		GDScriptLanguage::get_singleton()->set_lazy_compilation(true);
+	}
 #ifdef DEBUG_ENABLED
 	// Set all warning levels to "Warn" in order to test them properly, even the ones that default to error.
 	ProjectSettings::get_singleton()->set_setting("debug/gdscript/warnings/enable", true);
@@ -165,6 +177,12 @@ GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_l
 
 GDScriptTestRunner::~GDScriptTestRunner() {
 	test_function_name = StringName();
+	if (threaded_code) {
+		GDScriptLanguage::get_singleton()->set_threaded_code_threshold(previous_threaded_code_threshold);
+	}
+	if (lazy_compilation) {
+		GDScriptLanguage::get_singleton()->set_lazy_compilation(previous_lazy_compilation);
+	}
 	if (do_init_languages) {
 		finish_language();
 	}
@@ -310,6 +328,17 @@ bool GDScriptTestRunner::make_tests_for_dir(const String &p_dir) {
 					GDScriptTest bin_test(current_dir.path_join(next), current_dir.path_join(out_file), source_dir);
 					bin_test.set_tokenizer_mode(GDScriptTest::TOKENIZER_BUFFER);
 					tests.push_back(bin_test);
+				} else if (next.ends_with(".lazy.gd")) {
+					// Test eager compilation first.
+					GDScriptTest eager_test(current_dir.path_join(next), current_dir.path_join(out_file), source_dir);
+					if (binary_tokens) {
+						eager_test.set_tokenizer_mode(GDScriptTest::TOKENIZER_BUFFER);
+					}
+					tests.push_back(eager_test);
+					// Test lazy compilation even without `--use-lazy-compilation`.
+					GDScriptTest lazy_test = eager_test;
+					lazy_test.set_lazy_compilation(true);
+					tests.push_back(lazy_test);
 				} else {
 					GDScriptTest test(current_dir.path_join(next), current_dir.path_join(out_file), source_dir);
 					if (binary_tokens) {
@@ -630,7 +659,12 @@ GDScriptTest::TestResult GDScriptTest::execute_test_code(bool p_is_generating) {
 	add_print_handler(&_print_handler);
 	add_error_handler(&_error_handler);
 
+	bool previous_lazy_compilation = GDScriptLanguage::get_singleton()->should_compile_lazily();
+	if (lazy_compilation) {
+		GDScriptLanguage::get_singleton()->set_lazy_compilation(true);
+	}
 	err = script->reload();
+	GDScriptLanguage::get_singleton()->set_lazy_compilation(previous_lazy_compilation);
 	if (err) {
 		enable_stdout();
 		result.status = GDTEST_LOAD_ERROR;
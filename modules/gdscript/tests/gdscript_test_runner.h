@@ -84,6 +84,7 @@ private:
 	ErrorHandlerList _error_handler;
 
 	TokenizerMode tokenizer_mode = TOKENIZER_TEXT;
+	bool lazy_compilation = false; // Compile member functions on their first call.
 
 	void enable_stdout();
 	void disable_stdout();
@@ -104,6 +105,8 @@ public:
 
 	void set_tokenizer_mode(TokenizerMode p_tokenizer_mode) { tokenizer_mode = p_tokenizer_mode; }
 	TokenizerMode get_tokenizer_mode() const { return tokenizer_mode; }
+	void set_lazy_compilation(bool p_enabled) { lazy_compilation = p_enabled; }
+	bool is_lazy_compilation() const { return lazy_compilation; }
 
 	GDScriptTest(const String &p_source_path, const String &p_output_path, const String &p_base_dir);
 	GDScriptTest() :
@@ -118,6 +121,10 @@ class GDScriptTestRunner {
 	bool do_init_languages = false;
 	bool print_filenames; // Whether filenames should be printed when generated/running tests
 	bool binary_tokens; // Test with buffer tokenizer.
+	bool threaded_code = false; // Run every supported function on threaded code.
+	uint32_t previous_threaded_code_threshold = 0;
+	bool lazy_compilation = false; // Compile member functions on their first call.
+	bool previous_lazy_compilation = false;
 
 	bool make_tests();
 	bool make_tests_for_dir(const String &p_dir);
@@ -130,7 +137,7 @@ public:
 	int run_tests();
 	bool generate_outputs();
 
-	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false);
+	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false, bool p_use_threaded_code = false, bool p_use_lazy_compilation = false);
 	~GDScriptTestRunner();
 };
 
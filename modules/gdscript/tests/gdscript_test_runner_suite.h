@@ -32,7 +32,12 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -42,11 +47,23 @@ TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
 		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
 		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
-		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
+		bool use_threaded_code = OS::get_singleton()->get_cmdline_args().find("--use-threaded-code") != nullptr;
+		bool use_lazy_compilation = OS::get_singleton()->get_cmdline_args().find("--use-lazy-compilation") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens, use_threaded_code, use_lazy_compilation);
 		int fail_count = runner.run_tests();
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime on threaded code") {
+		// Every function that can be translated runs on threaded code from its first call, so the
+		// expected results of the interpreter apply unchanged.
+		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, false, true);
+		int fail_count = runner.run_tests();
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass on threaded code.");
+	}
 }
 #endif // TOOLS_ENABLED
 
@@ -72,6 +89,123 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Load compiled scripts from the bytecode cache") {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	language->init();
+
+	const String script_path = TestUtils::get_temp_path("bytecode_cache_round_trip.gd");
+	const String cache_path = TestUtils::get_temp_path("gdscript_cache");
+	{
+		Ref<FileAccess> file = FileAccess::open(script_path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		// Covers inner classes, lambdas, static variables, default arguments, loops and validated calls.
+		file->store_string(R"(
+extends RefCounted
+
+class Inner:
+	var value := 2
+
+	func scaled(factor: int) -> int:
+		return value * factor
+
+static var calls := 0
+
+var total := 0
+var names: Array[String] = ["a", "b"]
+
+func sum_to(count: int, step: int = 1) -> int:
+	calls += 1
+	var result := 0
+	for i in range(0, count, step):
+		result += i
+	return result
+
+func run() -> Array:
+	var inner := Inner.new()
+	var doubled := names.map(func(n: String) -> String: return n + n)
+	var lookup := { "x": 1, "y": 2 }
+	var packed := PackedInt32Array([3, 4])
+	packed[0] += 1
+	total = sum_to(5) + sum_to(10, 3)
+	var kind := "big" if total > 10 else "small"
+	return [total, inner.scaled(3), doubled, lookup["y"], packed[0], kind, calls, str(Vector2i(1, 2)), absi(-7)]
+)");
+	}
+
+	const bool was_enabled = language->is_bytecode_cache_enabled();
+	const String previous_cache_path = language->get_bytecode_cache_path();
+	language->set_bytecode_cache_enabled(true);
+	language->set_bytecode_cache_path(cache_path);
+	GDScriptBytecodeCache::clear();
+
+	const Array expected = { 28, 6, Array({ "aa", "bb" }), 2, 4, "big", 2, "(1, 2)", 7 };
+	auto run_script = [](const Ref<GDScript> &p_script) -> Variant {
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(p_script);
+		return ref_counted->call("run");
+	};
+	auto make_script = [&]() -> Ref<GDScript> {
+		Ref<GDScript> script;
+		script.instantiate();
+		script->set_path(script_path, true);
+		CHECK(script->load_source_code(script_path) == OK);
+		return script;
+	};
+
+	// Compiling the script stores it in the cache.
+	{
+		Error err = OK;
+		Ref<GDScript> compiled = GDScriptCache::get_full_script(script_path, err);
+		REQUIRE(err == OK);
+		CHECK(run_script(compiled) == expected);
+		GDScriptCache::remove_script(script_path);
+	}
+
+	Vector<String> cache_files;
+	{
+		Ref<DirAccess> dir = DirAccess::open(cache_path);
+		REQUIRE(dir.is_valid());
+		for (const String &file : dir->get_files()) {
+			if (file.get_extension() == "gdbc") {
+				cache_files.push_back(cache_path.path_join(file));
+			}
+		}
+	}
+	REQUIRE(cache_files.size() == 1);
+
+	SUBCASE("A stored script loads without compiling and runs the same") {
+		Ref<GDScript> cached = make_script();
+		CHECK(GDScriptBytecodeCache::load(cached.ptr()) == OK);
+		CHECK(cached->is_valid());
+		CHECK(run_script(cached) == expected);
+	}
+
+	SUBCASE("A damaged entry is ignored and the script compiles again") {
+		{
+			Ref<FileAccess> file = FileAccess::open(cache_files[0], FileAccess::READ_WRITE);
+			REQUIRE(file.is_valid());
+			file->seek(file->get_length() - 1);
+			const uint8_t last = file->get_8();
+			file->seek(file->get_length() - 1);
+			file->store_8(last ^ 0xFF);
+		}
+		Ref<GDScript> damaged = make_script();
+		CHECK(GDScriptBytecodeCache::load(damaged.ptr()) == ERR_UNAVAILABLE);
+		CHECK_FALSE(damaged->is_valid());
+		CHECK(damaged->reload() == OK);
+		CHECK(run_script(damaged) == expected);
+	}
+
+	GDScriptCache::remove_script(script_path);
+	language->set_bytecode_cache_enabled(was_enabled);
+	language->set_bytecode_cache_path(previous_cache_path);
+	GDScriptBytecodeCache::clear();
+	for (const String &file : cache_files) {
+		DirAccess::remove_absolute(file);
+	}
+	DirAccess::remove_absolute(script_path);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,3 @@
+func test():
+	var values := PackedFloat32Array([1.0])
+	print(values[1])
@@ -0,0 +1,56 @@
+signal tick(value)
+signal other
+
+const COUNT = 100000
+
+var resumed := 0
+var total := 0
+var order: Array[int] = []
+
+func wait_tick():
+	var value = await tick
+	resumed += 1
+	total += value
+
+func wait_twice():
+	await tick
+	await tick
+	resumed += 1
+
+func wait_in_order(index: int):
+	await other
+	order.append(index)
+
+func wait_on_freed(object):
+	await object.done
+	print("not reached")
+
+func test():
+	for i in COUNT:
+		wait_tick()
+	print(resumed)
+	tick.emit(2)
+	print(resumed)
+	print(total)
+	tick.emit(2)
+	print(resumed)
+
+	# Functions awaiting again while being resumed wait for the next emission.
+	resumed = 0
+	for i in 3:
+		wait_twice()
+	tick.emit(0)
+	print(resumed)
+	tick.emit(0)
+	print(resumed)
+
+	for i in 5:
+		wait_in_order(i)
+	other.emit()
+	print(order)
+
+	var object := Object.new()
+	object.add_user_signal("done")
+	wait_on_freed(object)
+	object.free()
+	print("ok")
@@ -0,0 +1,40 @@
+# Functions whose body is compiled on their first call, `.lazy.gd` tests also run with lazy compilation.
+
+class Inner:
+	var value: int
+
+	func _init(p_value: int = 3) -> void:
+		value = p_value
+
+	func doubled() -> int:
+		return value * 2
+
+	static func named(p_name: String, p_suffix := "!") -> String:
+		return p_name + p_suffix
+
+func factorial(n: int) -> int:
+	if n <= 1:
+		return 1
+	return n * factorial(n - 1)
+
+func greet(p_name: String, p_greeting: String = "Hello") -> String:
+	return "%s, %s" % [p_greeting, p_name]
+
+func make_adder(amount: int) -> Callable:
+	return func(x: int) -> int: return x + amount
+
+func describe(first: int, ...rest: Array) -> String:
+	return "%d %s" % [first, rest]
+
+func test():
+	print(factorial(5))
+	print(greet("world"))
+	print(greet("there", "Hi"))
+	print(make_adder(10).call(5))
+	print(describe(1, 2, 3))
+	print(Inner.new().doubled())
+	print(Inner.new(7).doubled())
+	print(Inner.named("done"))
+	print(get_method_argument_count("greet"))
+	var callable := factorial
+	print(callable.call(3))
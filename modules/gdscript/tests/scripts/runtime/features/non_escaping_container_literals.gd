@@ -0,0 +1,29 @@
+func is_vowel(c: String) -> bool:
+	return c in ["a", "e", "i", "o", "u"]
+
+func weight(kind: int) -> float:
+	return {0: 1.0, 1: 2.5}[kind]
+
+func test():
+	var total := 0
+	for i in 3:
+		for x in [1, 2, 3]:
+			total += x * i
+	print(total)
+
+	print(is_vowel("a"), is_vowel("b"))
+	print(weight(0) + weight(1))
+
+	var key := "b"
+	print({"a": 1, "b": 2}[key])
+
+	# Nested containers are still built on each evaluation and can be modified.
+	for row in [[1], [2]]:
+		row.append(0)
+		print(row)
+
+	# Elements of a literal that is assigned to must stay writable.
+	var index := 1
+	[0, 0][index] = 5
+	{"a": 0}[key] = 5
+	print("ok")
@@ -0,0 +1,46 @@
+# Fully typed code, which the threaded code tier can run. The suite runs it on both tiers.
+
+var scale: float = 2.0
+
+func sum_range(from: int, to: int, step: int = 1) -> int:
+	var total: int = 0
+	for i in range(from, to, step):
+		total += i
+	return total
+
+func count_multiples(limit: int, divisor: int) -> int:
+	var count: int = 0
+	for i in limit:
+		if i % divisor == 0:
+			count += 1
+	return count
+
+func scaled_length(v: Vector2) -> float:
+	return v.length() * scale
+
+func fill(size: int) -> PackedInt32Array:
+	var values := PackedInt32Array()
+	values.resize(size)
+	for i in size:
+		values[i] = i * i
+	return values
+
+func sum_values(values: PackedInt32Array) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < values.size():
+		total += values[i]
+		i += 1
+	return total
+
+func to_float(value: int) -> float:
+	return value # Needs a conversion on return.
+
+func test():
+	print(sum_range(0, 10))
+	print(sum_range(10, 0, -2))
+	print(count_multiples(100, 7))
+	print(scaled_length(Vector2(3.0, 4.0)))
+	print(sum_values(fill(5)))
+	print(to_float(3))
+	print(absi(-5) + maxi(2, 3))
@@ -0,0 +1,43 @@
+# Typed operators followed by a jump or an assignment are fused into a single instruction.
+
+var counter: int = 0
+
+func test():
+	var i: int = 0
+	var total: int = 0
+	while i < 5:
+		total += i
+		i += 1
+	print(total)
+
+	for j in 4:
+		counter += j
+	print(counter)
+
+	var a: float = 1.5
+	var b: float = 2.5
+	if a > b:
+		print("wrong")
+	else:
+		print("a <= b")
+
+	if a < b and b < 3.0:
+		print("and ok")
+	if a > b or b > 2.0:
+		print("or ok")
+
+	print("ternary ok" if a * 2.0 < b + 1.0 else "ternary wrong")
+
+	var x: int = 3
+	x = x * x
+	print(x)
+
+	# Jump targets between the operator and its consumer must prevent fusion.
+	var k: int = 0
+	var hits: int = 0
+	while k < 3:
+		k += 1
+		if k == 2:
+			continue
+		hits += 1
+	print(hits)
@@ -0,0 +1,32 @@
+# Element access on typed packed arrays uses dedicated opcodes.
+
+func test():
+	var floats := PackedFloat32Array([0.5, 1.5, 2.5])
+	var sum := 0.0
+	for i in floats.size():
+		sum += floats[i]
+	print(sum)
+	floats[-1] = 4.0
+	print(floats)
+
+	var ints := PackedInt32Array([1, 2, 3])
+	var copy := ints
+	for i in copy.size():
+		copy[i] *= 10
+	print(ints)
+	print(copy)
+
+	var longs := PackedInt64Array([1 << 40])
+	print(longs[0] + 1)
+
+	var doubles := PackedFloat64Array([0.25])
+	doubles[0] += 0.5
+	print(doubles[-1])
+
+	var points := PackedVector3Array([Vector3(1, 2, 3), Vector3()])
+	points[1] = points[0] * 2.0
+	print(points[1])
+
+	var vectors := PackedVector2Array([Vector2(1, 1)])
+	vectors[0].x = 5.0
+	print(vectors[0])
@@ -0,0 +1,66 @@
+# Untyped property accesses and calls go through per-instruction inline caches.
+# Running each site several times with different receivers checks that hits and
+# misses both give the same results as the generic lookups.
+
+class A:
+	var value = 1
+	var with_accessors = 0:
+		get:
+			return with_accessors * 10
+		set(v):
+			with_accessors = v + 1
+	var typed: float = 0.0
+
+	func describe():
+		return "A(%s)" % value
+
+class B extends A:
+	func describe():
+		return "B(%s)" % value
+
+class C:
+	var value = "c"
+
+	func describe():
+		return "C"
+
+func read(obj):
+	return obj.value
+
+func write(obj, v):
+	obj.value = v
+
+func call_describe(obj):
+	return obj.describe()
+
+func test():
+	var a := A.new()
+	var b := B.new()
+	var c := C.new()
+
+	for i in 3:
+		write(a, i)
+		print(read(a), " ", call_describe(a))
+	for obj in [a, b, c, a, b, c]:
+		print(read(obj), " ", call_describe(obj))
+
+	write(c, 5)
+	print(read(c))
+
+	for i in 2:
+		var untyped = a
+		untyped.with_accessors = i
+		print(untyped.with_accessors)
+
+	# Typed members still convert the assigned value.
+	var untyped_a = a
+	for i in 2:
+		untyped_a.typed = i
+		print(typeof(untyped_a.typed) == TYPE_FLOAT, " ", untyped_a.typed)
+
+	# Native properties and methods.
+	var node = Node.new()
+	for i in 2:
+		node.name = "Node%d" % i
+		print(node.name, " ", node.get_child_count())
+	node.free()
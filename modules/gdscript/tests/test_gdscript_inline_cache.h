@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  test_gdscript_inline_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG_ENABLED
+
+#include "../gdscript.h"
+
+#include "tests/test_macros.h"
+
+class TestGDScriptInlineCacheAccessor {
+public:
+	static uint64_t get_hits(const GDScriptFunction *p_function) { return p_function->profile.inline_cache_hits.get(); }
+	static uint64_t get_misses(const GDScriptFunction *p_function) { return p_function->profile.inline_cache_misses.get(); }
+};
+
+namespace GDScriptTests {
+
+static Ref<GDScript> _compile_inline_cache_script(const String &p_source) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	CHECK(err == OK);
+	return script;
+}
+
+TEST_CASE("[Modules][GDScript][InlineCache] Sites keep hitting when unrelated scripts are compiled") {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	language->init();
+
+	Ref<GDScript> reader_script = _compile_inline_cache_script(R"(
+extends RefCounted
+
+func read(target):
+	return target.value
+)");
+	Ref<GDScript> target_script = _compile_inline_cache_script(R"(
+extends RefCounted
+
+var value := 7
+)");
+	REQUIRE(reader_script->get_member_functions().has("read"));
+	const GDScriptFunction *read = reader_script->get_member_functions()["read"];
+
+	Ref<RefCounted> reader = memnew(RefCounted);
+	reader->set_script(reader_script);
+	Ref<RefCounted> target = memnew(RefCounted);
+	target->set_script(target_script);
+
+	language->profiling_start();
+	CHECK(int(reader->call("read", target)) == 7);
+	CHECK(TestGDScriptInlineCacheAccessor::get_misses(read) == 1);
+
+	// Far more compilations than the site keeps entries, none of them of the receiver's script.
+	for (int i = 0; i < 40; i++) {
+		_compile_inline_cache_script(vformat("extends RefCounted\n\nvar other := %d\n", i));
+		CHECK(int(reader->call("read", target)) == 7);
+	}
+	CHECK(TestGDScriptInlineCacheAccessor::get_hits(read) == 40);
+	CHECK(TestGDScriptInlineCacheAccessor::get_misses(read) == 1);
+
+	// Recompiling the receiver's script resolves the site again, as many times as it happens.
+	for (int i = 0; i < 40; i++) {
+		target_script->set_source_code(vformat("extends RefCounted\n\nvar padding := %d\nvar value := 7\n", i));
+		ERR_PRINT_OFF;
+		CHECK(target_script->reload(true) == OK);
+		ERR_PRINT_ON;
+		CHECK(int(reader->call("read", target)) == 7);
+		CHECK(int(reader->call("read", target)) == 7);
+	}
+	CHECK(TestGDScriptInlineCacheAccessor::get_hits(read) == 80);
+	CHECK(TestGDScriptInlineCacheAccessor::get_misses(read) == 41);
+	language->profiling_stop();
+}
+
+} // namespace GDScriptTests
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  test_gdscript_sampler.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript_sampler.h"
+
+#include "core/io/json.h"
+#include "tests/test_macros.h"
+
+class TestGDScriptSamplerAccessor {
+public:
+	static String get_collapsed_stacks(const HashMap<String, uint64_t> &p_samples) {
+		return GDScriptSampler::_get_collapsed_stacks(p_samples);
+	}
+	static String get_speedscope_json(const HashMap<String, uint64_t> &p_samples, uint32_t p_interval_usec) {
+		return GDScriptSampler::_get_speedscope_json(p_samples, p_interval_usec);
+	}
+};
+
+namespace GDScriptTests {
+
+static HashMap<String, uint64_t> _make_samples() {
+	HashMap<String, uint64_t> samples;
+	samples.insert("Main Thread;res://main.gd:_process;res://main.gd:update", 3);
+	samples.insert("Main Thread;res://main.gd:_process", 1);
+	samples.insert("Thread 7;res://worker.gd:run;Node::get_child", 2);
+	return samples;
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Collapsed stacks") {
+	CHECK(TestGDScriptSamplerAccessor::get_collapsed_stacks(HashMap<String, uint64_t>()).is_empty());
+	CHECK(TestGDScriptSamplerAccessor::get_collapsed_stacks(_make_samples()) ==
+			"Main Thread;res://main.gd:_process;res://main.gd:update 3\n"
+			"Main Thread;res://main.gd:_process 1\n"
+			"Thread 7;res://worker.gd:run;Node::get_child 2\n");
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Speedscope JSON") {
+	const Variant parsed = JSON::parse_string(TestGDScriptSamplerAccessor::get_speedscope_json(_make_samples(), 1000));
+	REQUIRE(parsed.get_type() == Variant::DICTIONARY);
+	const Dictionary file = parsed;
+	CHECK(String(file["$schema"]) == "https://www.speedscope.app/file-format-schema.json");
+
+	// Frames are shared between stacks, in order of first appearance.
+	const Array frames = Dictionary(file["shared"])["frames"];
+	const Vector<String> frame_names = { "Main Thread", "res://main.gd:_process", "res://main.gd:update", "Thread 7", "res://worker.gd:run", "Node::get_child" };
+	REQUIRE(frames.size() == frame_names.size());
+	for (int i = 0; i < frame_names.size(); i++) {
+		CHECK(String(Dictionary(frames[i])["name"]) == frame_names[i]);
+	}
+
+	const Array profiles = file["profiles"];
+	REQUIRE(profiles.size() == 1);
+	const Dictionary profile = profiles[0];
+	CHECK(String(profile["type"]) == "sampled");
+	CHECK(String(profile["unit"]) == "microseconds");
+	CHECK(int(profile["startValue"]) == 0);
+	CHECK(int(profile["endValue"]) == 6000);
+
+	// Each stack lists frame indices from the root, weighted by its ticks times the sampling interval.
+	const Vector<Vector<int>> expected_stacks = { { 0, 1, 2 }, { 0, 1 }, { 3, 4, 5 } };
+	const Vector<int> expected_weights = { 3000, 1000, 2000 };
+	const Array stacks = profile["samples"];
+	const Array weights = profile["weights"];
+	REQUIRE(stacks.size() == expected_stacks.size());
+	REQUIRE(weights.size() == expected_weights.size());
+	for (int i = 0; i < expected_stacks.size(); i++) {
+		const Array stack = stacks[i];
+		REQUIRE(stack.size() == expected_stacks[i].size());
+		for (int j = 0; j < stack.size(); j++) {
+			CHECK(int(stack[j]) == expected_stacks[i][j]);
+		}
+		CHECK(int(weights[i]) == expected_weights[i]);
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Speedscope JSON without samples") {
+	const Dictionary file = JSON::parse_string(TestGDScriptSamplerAccessor::get_speedscope_json(HashMap<String, uint64_t>(), 1000));
+	CHECK(Array(Dictionary(file["shared"])["frames"]).is_empty());
+	const Dictionary profile = Array(file["profiles"])[0];
+	CHECK(Array(profile["samples"]).is_empty());
+	CHECK(int(profile["endValue"]) == 0);
+}
+
+} // namespace GDScriptTests
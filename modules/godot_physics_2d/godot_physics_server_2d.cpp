@@ -1292,6 +1292,8 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 		return;
 	}
 
+	HeapProfiler::TagScope memory_tag("physics");
+
 	_update_shapes();
 
 	island_count = 0;
@@ -1675,6 +1675,8 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	HeapProfiler::TagScope memory_tag("physics");
+
 	_update_shapes();
 
 	island_count = 0;
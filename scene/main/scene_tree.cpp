@@ -337,6 +337,23 @@ void SceneTree::_update_group_order(Group &g) {
 	g.changed = false;
 }
 
+// Nodes in a group are usually of the same class, so when they have no script the method
+// is resolved once here, instead of by name for every node when the queue is flushed.
+static void _push_group_call_deferred(Node *p_node, const StringName &p_function, const Variant **p_args, int p_argcount, StringName &r_resolved_class, MethodBind *&r_resolved_method) {
+	if (!p_node->get_script_instance()) {
+		const StringName &class_name = p_node->get_class_name();
+		if (class_name != r_resolved_class) {
+			r_resolved_class = class_name;
+			r_resolved_method = ClassDB::get_method(class_name, p_function);
+		}
+		if (r_resolved_method) {
+			MessageQueue::get_singleton()->push_method_bindp(p_node, r_resolved_method, p_args, p_argcount);
+			return;
+		}
+	}
+	MessageQueue::get_singleton()->push_callp(p_node, p_function, p_args, p_argcount);
+}
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -384,6 +401,9 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_removed_on_group_call_lock++;
 	}
 
+	StringName resolved_class;
+	MethodBind *resolved_method = nullptr;
+
 	if (p_call_flags & GROUP_CALL_REVERSE) {
 		for (int i = gr_node_count - 1; i >= 0; i--) {
 			if (nodes_removed_on_group_call_lock && nodes_removed_on_group_call.has(gr_nodes[i])) {
@@ -398,7 +418,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
 			} else {
-				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
+				_push_group_call_deferred(node, p_function, p_args, p_argcount, resolved_class, resolved_method);
 			}
 		}
 
@@ -416,7 +436,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
 			} else {
-				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
+				_push_group_call_deferred(node, p_function, p_args, p_argcount, resolved_class, resolved_method);
 			}
 		}
 	}
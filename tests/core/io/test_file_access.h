@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
@@ -107,6 +108,65 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
 
+TEST_CASE("[FileAccess] Buffer view") {
+	const uint64_t size = FileAccess::BUFFER_VIEW_MIN_SIZE * 2 + 1000;
+	Vector<uint8_t> content;
+	content.resize(size);
+	for (uint64_t i = 0; i < size; i++) {
+		content.write[i] = (i * 7) % 251;
+	}
+	const String path = TestUtils::get_temp_path("buffer_view.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(content);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	// Small ranges are read through the buffer instead.
+	CHECK(f->get_buffer_view(16).is_empty());
+	CHECK(f->get_position() == 0);
+
+	// A view taken after buffered reads must start at the position, and move it past the view.
+	const uint64_t offset = 1000;
+	f->seek(offset - 100);
+	CHECK(f->get_buffer(100) == content.slice(offset - 100, offset));
+	const Span<uint8_t> view = f->get_buffer_view(FileAccess::BUFFER_VIEW_MIN_SIZE);
+#if defined(UNIX_ENABLED) && !defined(WEB_ENABLED)
+	CHECK_FALSE(view.is_empty());
+#endif
+	if (view.is_empty()) {
+		// Not every backend can provide a view.
+		CHECK(f->get_position() == offset);
+	} else {
+		CHECK(view.size() == FileAccess::BUFFER_VIEW_MIN_SIZE);
+		CHECK(memcmp(view.ptr(), content.ptr() + offset, FileAccess::BUFFER_VIEW_MIN_SIZE) == 0);
+		CHECK(f->get_position() == offset + FileAccess::BUFFER_VIEW_MIN_SIZE);
+		CHECK(f->get_buffer(100) == content.slice(offset + FileAccess::BUFFER_VIEW_MIN_SIZE, offset + FileAccess::BUFFER_VIEW_MIN_SIZE + 100));
+	}
+
+	// Views never extend past the end of the file.
+	f->seek(0);
+	CHECK(f->get_buffer_view(f->get_length() + 1).is_empty());
+	CHECK(f->get_position() == 0);
+
+	f.unref();
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[FileAccess] Prefetch") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	// Whether or not the backend reads ahead, it must not disturb reading.
+	f->get_buffer(6);
+	f->prefetch(0, f->get_length());
+	CHECK(f->get_position() == 6);
+	CHECK(f->get_line() == "darkness");
+}
+
 TEST_CASE("[FileAccess] Get/Store floating point values") {
 	// BigEndian Hex: 0x40490E56
 	// LittleEndian Hex: 0x560E4940
@@ -30,8 +30,11 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/pck_packer.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -116,4 +119,381 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read back compressed files") {
+	// Enough similar files to share a dictionary, and a large one spanning many chunks.
+	Vector<String> sources;
+	Vector<Vector<uint8_t>> contents;
+	for (int i = 0; i < 9; i++) {
+		String text;
+		const int lines = i == 0 ? 5000 : 20;
+		for (int j = 0; j < lines; j++) {
+			text += vformat("[node name=\"Node%d\" type=\"Node2D\" parent=\".\"]\nposition = Vector2(%d, %d)\n\n", j, i * j, j);
+		}
+		const String source = TestUtils::get_temp_path(vformat("compressed_%d.tscn", i));
+		Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+		sources.push_back(source);
+		contents.push_back(text.to_utf8_buffer());
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_use_compression(true);
+	pck_packer.set_compression_chunk_size(4096);
+	for (int i = 0; i < sources.size(); i++) {
+		CHECK(pck_packer.add_file(vformat("pck_packer_compressed/%d.tscn", i), sources[i]) == OK);
+	}
+	CHECK(pck_packer.flush() == OK);
+
+	int64_t total_size = 0;
+	for (const Vector<uint8_t> &content : contents) {
+		total_size += content.size();
+	}
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < total_size / 4,
+			"The PCK should be much smaller than the files it holds.");
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+	for (int i = 0; i < sources.size(); i++) {
+		const String path = vformat("res://pck_packer_compressed/%d.tscn", i);
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == (uint64_t)contents[i].size());
+		CHECK(f->get_buffer(f->get_length()) == contents[i]);
+		CHECK_FALSE(f->eof_reached());
+	}
+
+	// Seeking only decompresses the chunks that are read.
+	Ref<FileAccess> f = FileAccess::open("res://pck_packer_compressed/0.tscn", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	const Vector<uint8_t> &content = contents[0];
+	for (uint64_t position : { (uint64_t)content.size() - 100, (uint64_t)4090, (uint64_t)0, (uint64_t)12288 }) {
+		f->seek(position);
+		CHECK(f->get_buffer(20) == content.slice(position, position + 20));
+		CHECK(f->get_8() == content[position + 20]);
+	}
+
+	for (int i = 0; i < sources.size(); i++) {
+		PackedData::get_singleton()->remove_path(vformat("res://pck_packer_compressed/%d.tscn", i));
+		DirAccess::remove_file_or_error(sources[i]);
+	}
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+struct ReadCompressedTask {
+	String path;
+	Vector<uint8_t> content;
+	bool matched = false;
+};
+
+static void read_compressed_task(void *p_userdata) {
+	ReadCompressedTask *task = (ReadCompressedTask *)p_userdata;
+	Ref<FileAccess> f = FileAccess::open(task->path, FileAccess::READ);
+	task->matched = f.is_valid() && f->get_buffer(f->get_length()) == task->content;
+}
+
+TEST_CASE("[PCKPacker] Read compressed files from worker threads") {
+	String text;
+	for (int i = 0; i < 2000; i++) {
+		text += vformat("line %d of a file compressed in many chunks\n", i);
+	}
+	const String source = TestUtils::get_temp_path("compressed_threads.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed_threads.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_use_compression(true);
+	pck_packer.set_compression_chunk_size(4096);
+	CHECK(pck_packer.add_file("pck_packer_threads/file.txt", source) == OK);
+	CHECK(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+	// One read per pool thread, so that none is left free to run chunks for the others
+	// if they were to wait for decompression to be spread over the pool.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	LocalVector<ReadCompressedTask> tasks;
+	tasks.resize(MAX(pool->get_thread_count(), 1));
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	for (ReadCompressedTask &task : tasks) {
+		task.path = "res://pck_packer_threads/file.txt";
+		task.content = text.to_utf8_buffer();
+		task_ids.push_back(pool->add_native_task(&read_compressed_task, &task));
+	}
+	for (WorkerThreadPool::TaskID task_id : task_ids) {
+		CHECK(pool->wait_for_task_completion(task_id) == OK);
+	}
+	for (const ReadCompressedTask &task : tasks) {
+		CHECK(task.matched);
+	}
+
+	PackedData::get_singleton()->remove_path("res://pck_packer_threads/file.txt");
+	DirAccess::remove_file_or_error(source);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Reject compressed files with an invalid chunk table") {
+	String text;
+	for (int i = 0; i < 300; i++) {
+		text += vformat("line %d of a file compressed in a few chunks\n", i);
+	}
+	const String source = TestUtils::get_temp_path("compressed_corrupt.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+	const uint32_t chunk_count = (text.utf8().length() + 4095) / 4096;
+	REQUIRE(chunk_count > 1);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed_corrupt.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_use_compression(true);
+	pck_packer.set_compression_chunk_size(4096);
+	CHECK(pck_packer.add_file("pck_packer_corrupt/file.txt", source) == OK);
+	CHECK(pck_packer.flush() == OK);
+	const Vector<uint8_t> pck = FileAccess::get_file_as_bytes(output_pck_path);
+
+	// Find the chunk table after the chunk size and count that start the file data.
+	uint8_t header[8];
+	encode_uint32(4096, header);
+	encode_uint32(chunk_count, header + 4);
+	int64_t table = -1;
+	for (int64_t i = 0; i + 8 <= pck.size() && table < 0; i++) {
+		if (memcmp(pck.ptr() + i, header, 8) == 0) {
+			table = i + PACK_COMPRESSED_HEADER_SIZE;
+		}
+	}
+	REQUIRE(table >= 0);
+
+	// The end of the last chunk past the end of the pack, then a chunk starting before the previous one.
+	const uint64_t past_end = pck.size();
+	const int64_t last_offset = table + chunk_count * sizeof(uint64_t);
+	const int64_t second_offset = table + sizeof(uint64_t);
+	for (int64_t position : { last_offset, second_offset }) {
+		Vector<uint8_t> corrupt = pck;
+		encode_uint64(position == last_offset ? past_end : 0, corrupt.ptrw() + position);
+		{
+			Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(corrupt);
+		}
+		REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+		ERR_PRINT_OFF;
+		Ref<FileAccess> f = FileAccess::open("res://pck_packer_corrupt/file.txt", FileAccess::READ);
+		ERR_PRINT_ON;
+		CHECK((f.is_null() || !f->is_open()));
+
+		PackedData::get_singleton()->remove_path("res://pck_packer_corrupt/file.txt");
+	}
+
+	DirAccess::remove_file_or_error(source);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] View files of a pack in place") {
+	Vector<String> sources;
+	Vector<Vector<uint8_t>> contents;
+	for (int i = 0; i < 2; i++) {
+		Vector<uint8_t> content;
+		content.resize(FileAccess::BUFFER_VIEW_MIN_SIZE + 1000);
+		for (int j = 0; j < content.size(); j++) {
+			content.write[j] = (j * 7 + i) % 251;
+		}
+		const String source = TestUtils::get_temp_path(vformat("view_%d.bin", i));
+		Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(content);
+		sources.push_back(source);
+		contents.push_back(content);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_view.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	for (int i = 0; i < sources.size(); i++) {
+		CHECK(pck_packer.add_file(vformat("pck_packer_view/%d.bin", i), sources[i]) == OK);
+	}
+	CHECK(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+	for (int i = 0; i < sources.size(); i++) {
+		Ref<FileAccess> f = FileAccess::open(vformat("res://pck_packer_view/%d.bin", i), FileAccess::READ);
+		REQUIRE(f.is_valid());
+		const Vector<uint8_t> &content = contents[i];
+
+		// Small reads stay on the buffered path.
+		CHECK(f->get_buffer_view(16).is_empty());
+		CHECK(f->get_position() == 0);
+
+		// Not every platform can map the pack, but a view must match the file and move past it.
+		const Span<uint8_t> view = f->get_buffer_view(FileAccess::BUFFER_VIEW_MIN_SIZE);
+		if (view.is_empty()) {
+			CHECK(f->get_position() == 0);
+			continue;
+		}
+		CHECK(view.size() == FileAccess::BUFFER_VIEW_MIN_SIZE);
+		CHECK(memcmp(view.ptr(), content.ptr(), FileAccess::BUFFER_VIEW_MIN_SIZE) == 0);
+		CHECK(f->get_position() == FileAccess::BUFFER_VIEW_MIN_SIZE);
+		CHECK(f->get_buffer(1000) == content.slice(FileAccess::BUFFER_VIEW_MIN_SIZE));
+		CHECK(f->get_buffer_view(1).is_empty());
+	}
+
+	for (int i = 0; i < sources.size(); i++) {
+		PackedData::get_singleton()->remove_path(vformat("res://pck_packer_view/%d.bin", i));
+		DirAccess::remove_file_or_error(sources[i]);
+	}
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] View files of a pack rewritten and mounted again") {
+	const String source = TestUtils::get_temp_path("remount.bin");
+	const String padding_source = TestUtils::get_temp_path("remount_padding.bin");
+	const String output_pck_path = TestUtils::get_temp_path("output_remount.pck");
+	Vector<Vector<uint8_t>> contents;
+	Ref<FileAccess> first_file;
+	Span<uint8_t> first_view;
+
+	for (int i = 0; i < 2; i++) {
+		// The second pack puts the file at another offset, past another file.
+		Vector<uint8_t> content;
+		content.resize(FileAccess::BUFFER_VIEW_MIN_SIZE * (i + 1) + 1000);
+		for (int j = 0; j < content.size(); j++) {
+			content.write[j] = (j * 13 + i * 101) % 251;
+		}
+		{
+			Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(content);
+		}
+		contents.push_back(content);
+
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		if (i > 0) {
+			{
+				Ref<FileAccess> f = FileAccess::open(padding_source, FileAccess::WRITE);
+				REQUIRE(f.is_valid());
+				f->store_buffer(content.slice(0, 5000));
+			}
+			CHECK(pck_packer.add_file("pck_packer_remount/padding.bin", padding_source) == OK);
+		}
+		CHECK(pck_packer.add_file("pck_packer_remount/file.bin", source) == OK);
+		CHECK(pck_packer.flush() == OK);
+		REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+		Ref<FileAccess> f = FileAccess::open("res://pck_packer_remount/file.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(content.size()));
+		const Span<uint8_t> view = f->get_buffer_view(content.size());
+		if (view.is_empty()) {
+			// Not every platform can map the pack, but reads must see the new one.
+			CHECK(f->get_buffer(content.size()) == content);
+			continue;
+		}
+		CHECK(view.size() == uint64_t(content.size()));
+		CHECK(memcmp(view.ptr(), content.ptr(), content.size()) == 0);
+		if (i == 0) {
+			first_file = f;
+			first_view = view;
+		}
+	}
+
+	// A file opened from the first pack keeps its view after the pack is mounted again.
+	if (first_file.is_valid()) {
+		CHECK(memcmp(first_view.ptr(), contents[0].ptr(), contents[0].size()) == 0);
+		first_file.unref();
+	}
+
+	PackedData::get_singleton()->remove_path("res://pck_packer_remount/file.bin");
+	PackedData::get_singleton()->remove_path("res://pck_packer_remount/padding.bin");
+	DirAccess::remove_file_or_error(source);
+	DirAccess::remove_file_or_error(padding_source);
+	DirAccess::remove_file_or_error(output_pck_path);
+}
+
+TEST_CASE("[PCKPacker] Look up files and list directories of indexed packs") {
+	Vector<String> sources;
+	for (const char *text : { "base", "patch" }) {
+		const String source = TestUtils::get_temp_path(vformat("indexed_%s.txt", text));
+		Ref<FileAccess> f = FileAccess::open(source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+		sources.push_back(source);
+	}
+
+	PCKPacker base_packer;
+	const String base_pck_path = TestUtils::get_temp_path("output_indexed_base.pck");
+	REQUIRE(base_packer.pck_start(base_pck_path) == OK);
+	CHECK(base_packer.add_file("pck_packer_indexed/replaced.txt", sources[0]) == OK);
+	CHECK(base_packer.add_file("pck_packer_indexed/removed.txt", sources[0]) == OK);
+	CHECK(base_packer.add_file("pck_packer_indexed/sub/kept.txt", sources[0]) == OK);
+	for (int i = 0; i < 100; i++) {
+		CHECK(base_packer.add_file(vformat("pck_packer_indexed/many/%d.txt", i), sources[0]) == OK);
+	}
+	CHECK(base_packer.flush() == OK);
+
+	// A patch pack replacing and removing files of the base one.
+	PCKPacker patch_packer;
+	const String patch_pck_path = TestUtils::get_temp_path("output_indexed_patch.pck");
+	REQUIRE(patch_packer.pck_start(patch_pck_path) == OK);
+	CHECK(patch_packer.add_file("pck_packer_indexed/replaced.txt", sources[1]) == OK);
+	CHECK(patch_packer.add_file_removal("pck_packer_indexed/removed.txt") == OK);
+	CHECK(patch_packer.add_file("pck_packer_indexed/sub/deeper/added.txt", sources[1]) == OK);
+	CHECK(patch_packer.flush() == OK);
+
+	REQUIRE(PackedData::get_singleton()->add_pack(base_pck_path, false, 0) == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(patch_pck_path, true, 0) == OK);
+
+	CHECK(FileAccess::get_file_as_string("res://pck_packer_indexed/replaced.txt") == "patch");
+	CHECK(FileAccess::get_file_as_string("res://pck_packer_indexed/sub/kept.txt") == "base");
+	CHECK(FileAccess::get_file_as_string("res://pck_packer_indexed/sub/deeper/added.txt") == "patch");
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pck_packer_indexed/removed.txt"));
+	for (int i = 0; i < 100; i++) {
+		CHECK(PackedData::get_singleton()->has_path(vformat("res://pck_packer_indexed/many/%d.txt", i)));
+	}
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pck_packer_indexed/many/100.txt"));
+
+	Ref<DirAccess> da = PackedData::get_singleton()->try_open_directory("res://pck_packer_indexed");
+	REQUIRE(da.is_valid());
+	CHECK(da->get_files() == PackedStringArray({ "replaced.txt" }));
+	PackedStringArray dirs = da->get_directories();
+	dirs.sort();
+	CHECK(dirs == PackedStringArray({ "many", "sub" }));
+	CHECK(da->dir_exists("sub/deeper"));
+	CHECK(da->file_exists("sub/deeper/added.txt"));
+	CHECK(da->change_dir("many") == OK);
+	CHECK(da->get_files().size() == 100);
+
+	const HashSet<String> paths = PackedData::get_singleton()->get_file_paths();
+	CHECK(paths.has("pck_packer_indexed/sub/deeper/added.txt"));
+	CHECK_FALSE(paths.has("pck_packer_indexed/removed.txt"));
+
+	// Files removed after mounting are hidden from the packs.
+	PackedData::get_singleton()->remove_path("res://pck_packer_indexed/sub/kept.txt");
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pck_packer_indexed/sub/kept.txt"));
+	CHECK_FALSE(PackedData::get_singleton()->try_open_directory("res://pck_packer_indexed/sub")->file_exists("kept.txt"));
+
+	for (const String &path : paths) {
+		if (path.begins_with("pck_packer_indexed/")) {
+			PackedData::get_singleton()->remove_path(path);
+		}
+	}
+	for (const String &source : sources) {
+		DirAccess::remove_file_or_error(source);
+	}
+	DirAccess::remove_file_or_error(base_pck_path);
+	DirAccess::remove_file_or_error(patch_pck_path);
+}
+
 } // namespace TestPCKPacker
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_resource_loader.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+
+#include "tests/test_utils.h"
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestResourceLoader {
+
+// Writes a tree of text resources in `p_dir`, each referencing up to `p_branching` children
+// and a leaf shared by all of them as external resources. Returns the path of the root.
+static String generate_resource_tree(const String &p_dir, int p_count, int p_branching) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+
+	const String shared_path = p_dir.path_join("shared.tres");
+	Ref<FileAccess> f = FileAccess::open(shared_path, FileAccess::WRITE);
+	f->store_string("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nmetadata/index = -1\n");
+
+	for (int i = 0; i < p_count; i++) {
+		String header = vformat("[ext_resource type=\"Resource\" path=\"%s\" id=\"shared\"]\n", shared_path);
+		String properties = vformat("metadata/index = %d\nmetadata/shared = ExtResource(\"shared\")\n", i);
+		for (int child = i * p_branching + 1; child < MIN(i * p_branching + p_branching + 1, p_count); child++) {
+			header += vformat("[ext_resource type=\"Resource\" path=\"%s\" id=\"%d\"]\n", p_dir.path_join(vformat("resource_%d.tres", child)), child);
+			properties += vformat("metadata/child_%d = ExtResource(\"%d\")\n", child, child);
+		}
+		f = FileAccess::open(p_dir.path_join(vformat("resource_%d.tres", i)), FileAccess::WRITE);
+		f->store_string(vformat("[gd_resource type=\"Resource\" format=3]\n\n%s\n[resource]\n%s", header, properties));
+	}
+	return p_dir.path_join("resource_0.tres");
+}
+
+static void remove_resource_tree(const String &p_dir) {
+	for (const String &file : DirAccess::get_files_at(p_dir)) {
+		DirAccess::remove_absolute(p_dir.path_join(file));
+	}
+	DirAccess::remove_absolute(p_dir);
+}
+
+// Checks every resource of the tree was loaded once, with its children and the shared leaf.
+static void check_resource_tree(const Ref<Resource> &p_resource, const Ref<Resource> &p_shared, int p_count, int p_branching, LocalVector<bool> &r_seen) {
+	const int index = p_resource->get_meta("index");
+	REQUIRE(index >= 0);
+	REQUIRE(index < p_count);
+	CHECK_FALSE(r_seen[index]);
+	r_seen[index] = true;
+	CHECK(Ref<Resource>(p_resource->get_meta("shared")) == p_shared);
+	for (int child = index * p_branching + 1; child < MIN(index * p_branching + p_branching + 1, p_count); child++) {
+		const Ref<Resource> child_resource = p_resource->get_meta(vformat("child_%d", child));
+		REQUIRE(child_resource.is_valid());
+		check_resource_tree(child_resource, p_shared, p_count, p_branching, r_seen);
+	}
+}
+
+TEST_CASE("[ResourceLoader] Threaded load of a dependency tree") {
+	const int count = 120;
+	const int branching = 3;
+
+	for (bool use_sub_threads : { false, true }) {
+		const String dir = TestUtils::get_temp_path(vformat("resource_loader_tree_%d", use_sub_threads));
+		const String root_path = generate_resource_tree(dir, count, branching);
+
+		// With sub-threads, dependencies are loaded by tasks of their own and awaited by
+		// every resource referencing them, which all have to finish on the same tokens.
+		REQUIRE(ResourceLoader::load_threaded_request(root_path, "", use_sub_threads) == OK);
+		Error error = FAILED;
+		const Ref<Resource> root = ResourceLoader::load_threaded_get(root_path, &error);
+		CHECK(error == OK);
+		REQUIRE(root.is_valid());
+
+		const Ref<Resource> shared = root->get_meta("shared");
+		REQUIRE(shared.is_valid());
+		CHECK(int(shared->get_meta("index")) == -1);
+		LocalVector<bool> seen;
+		seen.resize(count);
+		for (int i = 0; i < count; i++) {
+			seen[i] = false;
+		}
+		check_resource_tree(root, shared, count, branching, seen);
+		for (int i = 0; i < count; i++) {
+			CHECK(seen[i]);
+		}
+
+		// Everything is cached now, so loading it again finishes right away on the same resources.
+		REQUIRE(ResourceLoader::load_threaded_request(dir.path_join("resource_1.tres"), "", use_sub_threads) == OK);
+		CHECK(ResourceLoader::load_threaded_get(dir.path_join("resource_1.tres")) == Ref<Resource>(root->get_meta("child_1")));
+
+		remove_resource_tree(dir);
+	}
+}
+
+} // namespace TestResourceLoader
@@ -305,4 +305,18 @@ TEST_CASE("[StreamPeer] Get UTF8 string when there is no string") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[StreamPeer] Put data through the bound methods") {
+	Ref<StreamPeerBuffer> spb;
+	spb.instantiate();
+
+	const PackedByteArray data = { 1, 2, 3, 4 };
+	CHECK_EQ(int(spb->call("put_data", data)), int(OK));
+	// Arrays are converted to the packed type first.
+	const Array result = spb->call("put_partial_data", Array({ 5, 6 }));
+	CHECK_EQ(int(result[0]), int(OK));
+	CHECK_EQ(int(result[1]), 2);
+
+	CHECK_EQ(spb->get_data_array(), PackedByteArray({ 1, 2, 3, 4, 5, 6 }));
+}
+
 } // namespace TestStreamPeer
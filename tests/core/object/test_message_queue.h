@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/class_db.h"
+#include "core/object/message_queue.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestMessageQueueObject : public Object {
+	GDCLASS(_TestMessageQueueObject, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestMessageQueueObject::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestMessageQueueObject::get_value);
+		ClassDB::bind_method(D_METHOD("record", "value"), &_TestMessageQueueObject::record);
+		ClassDB::bind_method(D_METHOD("record_value"), &_TestMessageQueueObject::record_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+	}
+
+public:
+	int value = 0;
+	int set_count = 0;
+	LocalVector<int> recorded;
+
+	void set_value(int p_value) {
+		value = p_value;
+		set_count++;
+	}
+	int get_value() const { return value; }
+	void record(int p_value) { recorded.push_back(p_value); }
+	void record_value() { recorded.push_back(value); }
+};
+
+namespace TestMessageQueue {
+
+TEST_CASE("[MessageQueue] Method bind calls") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	_TestMessageQueueObject object;
+	MethodBind *record = ClassDB::get_method(_TestMessageQueueObject::get_class_static(), "record");
+	REQUIRE(record != nullptr);
+
+	CallQueue queue;
+	CHECK(queue.push_method_bind(&object, record, 1) == OK);
+	CHECK(queue.push_call(&object, "record", 2) == OK);
+	CHECK(queue.push_method_bind(&object, record, 3) == OK);
+	CHECK(object.recorded.is_empty());
+
+	CHECK(queue.flush() == OK);
+	REQUIRE(object.recorded.size() == 3);
+	CHECK(object.recorded[0] == 1);
+	CHECK(object.recorded[1] == 2);
+	CHECK(object.recorded[2] == 3);
+	CHECK_FALSE(queue.has_messages());
+
+	queue.end_frame_stats();
+	CallQueue::FlushStats stats = queue.get_last_frame_stats();
+	CHECK(stats.messages == 3);
+	CHECK(stats.bytes > 0);
+	CHECK(stats.coalesced_sets == 0);
+
+	// Stats only cover the frames that ended since.
+	queue.end_frame_stats();
+	CHECK(queue.get_last_frame_stats().messages == 0);
+}
+
+TEST_CASE("[MessageQueue] Method bind call on a freed object") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	_TestMessageQueueObject *object = memnew(_TestMessageQueueObject);
+	MethodBind *record = ClassDB::get_method(_TestMessageQueueObject::get_class_static(), "record");
+
+	CallQueue queue;
+	queue.push_method_bind(object, record, 1);
+	memdelete(object);
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[MessageQueue] Coalesced sets") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	_TestMessageQueueObject object;
+
+	CallQueue queue;
+	queue.set_coalesce_sets(true);
+	queue.push_set(&object, "value", 1);
+	queue.push_call(&object, "record_value");
+	queue.push_set(&object, "value", 2);
+	queue.push_set(&object, "value", 3);
+	CHECK(queue.flush() == OK);
+
+	// Only the last set runs, at the position it was pushed.
+	CHECK(object.value == 3);
+	CHECK(object.set_count == 1);
+	REQUIRE(object.recorded.size() == 1);
+	CHECK(object.recorded[0] == 0);
+
+	queue.end_frame_stats();
+	CHECK(queue.get_last_frame_stats().coalesced_sets == 2);
+	CHECK(queue.get_last_frame_stats().messages == 2);
+
+	// Flushed sets aren't coalesced with later ones.
+	queue.push_set(&object, "value", 4);
+	CHECK(queue.flush() == OK);
+	CHECK(object.value == 4);
+	CHECK(object.set_count == 2);
+
+	// Without coalescing, every set runs.
+	queue.set_coalesce_sets(false);
+	queue.push_set(&object, "value", 5);
+	queue.push_set(&object, "value", 6);
+	CHECK(queue.flush() == OK);
+	CHECK(object.value == 6);
+	CHECK(object.set_count == 4);
+}
+
+} // namespace TestMessageQueue
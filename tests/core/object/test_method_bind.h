@@ -109,6 +109,17 @@ public:
 		test_valid[TEST_METHOD_OBJECT_CAST] = p_object->value == 1;
 	}
 
+	const float *span_ptr = nullptr;
+	float span_sum = 0;
+
+	void test_method_span(Span<float> p_values) {
+		span_ptr = p_values.ptr();
+		span_sum = 0;
+		for (float value : p_values) {
+			span_sum += value;
+		}
+	}
+
 	static void _bind_methods() {
 		ClassDB::bind_method(D_METHOD("test_method"), &MethodBindTester::test_method);
 		ClassDB::bind_method(D_METHOD("test_method_args"), &MethodBindTester::test_method_args);
@@ -120,6 +131,7 @@ public:
 		ClassDB::bind_method(D_METHOD("test_methodrc_args"), &MethodBindTester::test_methodrc_args);
 		ClassDB::bind_method(D_METHOD("test_method_default_args"), &MethodBindTester::test_method_default_args, DEFVAL(9) /* wrong on purpose */, DEFVAL(4), DEFVAL(5));
 		ClassDB::bind_method(D_METHOD("test_method_object_cast", "object"), &MethodBindTester::test_method_object_cast);
+		ClassDB::bind_method(D_METHOD("test_method_span", "values"), &MethodBindTester::test_method_span);
 	}
 
 	virtual void run_tests() {
@@ -171,4 +183,36 @@ TEST_CASE("[MethodBind] check all method binds") {
 
 	memdelete(mbt);
 }
+
+TEST_CASE("[MethodBind] Span arguments view packed arrays without copying") {
+	MethodBindTester *mbt = memnew(MethodBindTester);
+	MethodBind *mb = ClassDB::get_method(MethodBindTester::get_class_static(), "test_method_span");
+	REQUIRE(mb != nullptr);
+	CHECK(mb->get_argument_type(0) == Variant::PACKED_FLOAT32_ARRAY);
+
+	PackedFloat32Array values = { 1.0, 2.0, 3.0 };
+	const Variant arg = values;
+	const float *data = VariantInternal::get_float32_array(&arg)->ptr();
+
+	mbt->call("test_method_span", arg);
+	CHECK(mbt->span_ptr == data);
+	CHECK(mbt->span_sum == 6.0);
+
+	const Variant *validated_args[1] = { &arg };
+	mb->validated_call(mbt, validated_args, nullptr);
+	CHECK(mbt->span_ptr == data);
+	CHECK(mbt->span_sum == 6.0);
+
+	const void *ptr_args[1] = { &values };
+	mb->ptrcall(mbt, ptr_args, nullptr);
+	CHECK(mbt->span_ptr == values.ptr());
+	CHECK(mbt->span_sum == 6.0);
+
+	// Other types are converted for the duration of the call.
+	Array array = { 4.0, 5.0 };
+	mbt->call("test_method_span", array);
+	CHECK(mbt->span_sum == 9.0);
+
+	memdelete(mbt);
+}
 } // namespace TestMethodBind
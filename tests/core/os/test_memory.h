@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[FrameArena] Allocations are aligned and writable") {
+	FrameArena::Scope scope;
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(100);
+	CHECK((uintptr_t)a % alignof(max_align_t) == 0);
+	CHECK((uintptr_t)b % alignof(max_align_t) == 0);
+	CHECK(b >= a + 3);
+
+	memset(a, 0xAB, 3);
+	memset(b, 0xCD, 100);
+	CHECK(a[2] == 0xAB);
+	CHECK(b[99] == 0xCD);
+}
+
+TEST_CASE("[FrameArena] Realloc keeps contents") {
+	FrameArena::Scope scope;
+
+	int *data = (int *)FrameArena::alloc(sizeof(int) * 4);
+	for (int i = 0; i < 4; i++) {
+		data[i] = i;
+	}
+
+	// Most recent allocation, can grow in place.
+	int *grown = (int *)FrameArena::realloc(data, sizeof(int) * 8);
+	CHECK(grown == data);
+
+	// Not the most recent allocation anymore, has to move.
+	FrameArena::alloc(16);
+	int *moved = (int *)FrameArena::realloc(grown, sizeof(int) * 64);
+	CHECK(moved != grown);
+	for (int i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+}
+
+TEST_CASE("[FrameArena] Scopes rewind the arena") {
+	FrameArena::Scope outer;
+
+	void *first = FrameArena::alloc(64);
+	{
+		FrameArena::Scope inner;
+		FrameArena::alloc(1024);
+		// Bigger than a chunk, forces a new one.
+		FrameArena::alloc(1024 * 1024);
+	}
+	void *second = FrameArena::alloc(64);
+	CHECK_MESSAGE((uint8_t *)second > (uint8_t *)first, "Memory allocated in the inner scope should have been reclaimed.");
+	CHECK_MESSAGE((uint8_t *)second - (uint8_t *)first < 1024, "Memory allocated in the inner scope should have been reclaimed.");
+
+	FrameArena::ThreadStats stats[64];
+	uint32_t count = FrameArena::get_thread_stats(stats, 64);
+	CHECK(count >= 1);
+	CHECK(FrameArena::get_max_high_water() >= 1024 * 1024);
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameArena::Scope scope;
+
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(vector[999] == 999);
+
+	FrameHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	map.erase(500);
+	CHECK(map.size() == 999);
+	CHECK(map[10] == 20);
+	CHECK_FALSE(map.has(500));
+
+	List<String, FrameArena> list;
+	list.push_back("a");
+	list.push_back("b");
+	CHECK(list.size() == 2);
+	CHECK(list.back()->get() == "b");
+}
+
+struct _TestHeapProfilerObject {
+	uint8_t data[200] = {};
+};
+
+TEST_CASE("[HeapProfiler] Allocations are attributed to tags and call sites") {
+	HeapProfiler::start(1); // Record every allocation.
+	CHECK(HeapProfiler::is_enabled());
+
+	void *tagged = nullptr;
+	_TestHeapProfilerObject *object = nullptr;
+	int line = 0;
+	{
+		HeapProfiler::TagScope tag("test_heap_profiler");
+		CHECK(String(HeapProfiler::get_thread_tag()) == "test_heap_profiler");
+		tagged = memalloc(1000);
+		// Call site tags take precedence over the thread tag.
+		line = __LINE__ + 1;
+		object = memnew_tagged("test_heap_profiler_site", _TestHeapProfilerObject);
+	}
+	CHECK(HeapProfiler::get_thread_tag() == nullptr);
+
+	CHECK(HeapProfiler::get_tag_live_bytes("test_heap_profiler") == 1000);
+	CHECK(HeapProfiler::get_tag_live_bytes("test_heap_profiler_site") == sizeof(_TestHeapProfilerObject));
+
+	LocalVector<HeapProfiler::Site> sites;
+	sites.resize(HeapProfiler::get_site_count() + 16);
+	sites.resize(HeapProfiler::get_sites(sites.ptr(), sites.size()));
+	bool found = false;
+	for (const HeapProfiler::Site &site : sites) {
+		if (site.tag && String(site.tag) == "test_heap_profiler_site") {
+			found = true;
+			CHECK(String(site.file) == String(__FILE__));
+			CHECK(site.line == line);
+			CHECK(site.samples == 1);
+		}
+	}
+	CHECK(found);
+
+	tagged = memrealloc(tagged, 4000);
+	CHECK(HeapProfiler::get_tag_live_bytes("test_heap_profiler") == 0); // The new block wasn't allocated under the tag.
+	CHECK(HeapProfiler::get_tag_live_bytes(nullptr) >= 4000);
+
+	memfree(tagged);
+	memdelete(object);
+	CHECK(HeapProfiler::get_tag_live_bytes("test_heap_profiler_site") == 0);
+
+	HeapProfiler::stop();
+	CHECK_FALSE(HeapProfiler::is_enabled());
+}
+
+TEST_CASE("[HeapProfiler] Sampled totals estimate allocated bytes") {
+	const uint64_t interval = 4096;
+	const int count = 1000;
+	const uint64_t size = 100;
+
+	HeapProfiler::start(interval);
+	CHECK(HeapProfiler::get_sample_interval() == interval);
+
+	LocalVector<void *> allocations;
+	allocations.reserve(count);
+	{
+		HeapProfiler::TagScope tag("test_heap_profiler_sampled");
+		for (int i = 0; i < count; i++) {
+			allocations.push_back(memalloc(size));
+		}
+	}
+
+	uint64_t live = HeapProfiler::get_tag_live_bytes("test_heap_profiler_sampled");
+	CHECK(live + interval >= count * size);
+	CHECK(live <= count * size + interval);
+
+	for (void *allocation : allocations) {
+		memfree(allocation);
+	}
+	CHECK(HeapProfiler::get_tag_live_bytes("test_heap_profiler_sampled") == 0);
+
+	HeapProfiler::stop();
+
+	// Nothing is recorded while stopped, but results stay available.
+	{
+		HeapProfiler::TagScope tag("test_heap_profiler_stopped");
+		void *ignored = memalloc(interval * 4);
+		memfree(ignored);
+	}
+	LocalVector<HeapProfiler::Site> sites;
+	sites.resize(HeapProfiler::get_site_count());
+	sites.resize(HeapProfiler::get_sites(sites.ptr(), sites.size()));
+	bool found = false;
+	for (const HeapProfiler::Site &site : sites) {
+		CHECK_FALSE((site.tag && String(site.tag) == "test_heap_profiler_stopped"));
+		if (site.tag && String(site.tag) == "test_heap_profiler_sampled") {
+			found = true;
+			CHECK(site.samples < (uint64_t)count);
+			CHECK(site.allocated_bytes + interval >= count * size);
+		}
+	}
+	CHECK(found);
+}
+
+} // namespace TestMemory
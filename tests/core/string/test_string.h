@@ -453,6 +453,53 @@ TEST_CASE("[String] Find case insensitive") {
 	MULTICHECK_STRING_INT_EQ(s, rfindn, "", 13, -1);
 }
 
+TEST_CASE("[String] Find, case conversion and UTF-8 on long strings") {
+	// Long enough to exercise the vectorized loops, with non-ASCII characters
+	// at block boundaries and matches in the scalar tail.
+	String s;
+	for (int i = 0; i < 64; i++) {
+		s += (i % 17 == 0) ? U"Ж" : U"abcDEF";
+	}
+	s += U"NeedleÉ";
+
+	CHECK_EQ(s.find("Needle"), s.length() - 7);
+	CHECK_EQ(s.find(String("NeedleÉ")), s.length() - 7);
+	CHECK_EQ(s.find("needle"), -1);
+	CHECK_EQ(s.findn("nEEDLE"), s.length() - 7);
+	CHECK_EQ(s.findn(String(U"needleé")), s.length() - 7);
+	CHECK_EQ(s.find_char(U'É'), s.length() - 1);
+	CHECK_EQ(s.find_char(U'Ж', 1), 97);
+	CHECK_EQ(s.findn("DEFABC"), 4);
+	CHECK_EQ(s.findn("DEFABC", 5), 10);
+	CHECK_EQ(String(U"\u212A").findn("k"), 0); // Kelvin sign.
+
+	const String lower = s.to_lower();
+	const String upper = s.to_upper();
+	CHECK_EQ(lower.length(), s.length());
+	CHECK_EQ(upper.length(), s.length());
+	CHECK(lower.ends_with(U"needleé"));
+	CHECK(upper.ends_with(U"NEEDLEÉ"));
+	CHECK(lower.begins_with(U"жabcdef"));
+	CHECK(upper.begins_with(U"ЖABCDEF"));
+
+	const CharString utf8 = s.utf8();
+	String decoded;
+	CHECK_EQ(decoded.append_utf8(utf8.get_data(), utf8.length()), OK);
+	CHECK_EQ(decoded, s);
+
+	Vector<uint8_t> map;
+	CHECK_EQ(s.utf8(&map).length(), utf8.length());
+	CHECK_EQ(map.size(), s.length());
+	CHECK_EQ(map[0], 2);
+	CHECK_EQ(map[1], 1);
+	CHECK_EQ(map[map.size() - 1], 2);
+
+	const String expected = String::utf8("0123456789abcdef0123456789\r\nabcdef0123456789abcdef").replace("\r", "");
+	String skipped;
+	skipped.append_utf8("0123456789abcdef0123456789\r\nabcdef0123456789abcdef", -1, true);
+	CHECK_EQ(skipped, expected);
+}
+
 TEST_CASE("[String] Find MK") {
 	Vector<String> keys;
 	keys.push_back("sty");
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = "test_string_name_interning_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == "test_string_name_interning");
+	CHECK(StringName() == StringName(""));
+	CHECK_FALSE(StringName(""));
+}
+
+TEST_CASE("[StringName] Many names") {
+	// Enough names to force the table to grow.
+	constexpr int COUNT = 100000;
+	LocalVector<StringName> names;
+	names.resize(COUNT);
+	for (int i = 0; i < COUNT; i++) {
+		names[i] = StringName("test_string_name_many_" + itos(i));
+	}
+	for (int i = 0; i < COUNT; i++) {
+		const StringName name = "test_string_name_many_" + itos(i);
+		CHECK_MESSAGE(name.data_unique_pointer() == names[i].data_unique_pointer(), "Interning an existing name should return the same entry.");
+		CHECK(name == names[i]);
+	}
+
+	// Drop every other name and intern them again.
+	for (int i = 0; i < COUNT; i += 2) {
+		names[i] = StringName();
+	}
+	for (int i = 0; i < COUNT; i += 2) {
+		names[i] = StringName("test_string_name_many_" + itos(i));
+	}
+	for (int i = 0; i < COUNT; i++) {
+		CHECK(names[i] == "test_string_name_many_" + itos(i));
+	}
+}
+
+struct ThreadedInternData {
+	static constexpr int NAME_COUNT = 2000;
+	LocalVector<StringName> names;
+	int mismatches = 0;
+};
+
+static void threaded_intern(void *p_userdata) {
+	ThreadedInternData *data = static_cast<ThreadedInternData *>(p_userdata);
+	data->names.resize(ThreadedInternData::NAME_COUNT);
+	for (int i = 0; i < ThreadedInternData::NAME_COUNT; i++) {
+		// Drop and re-intern names so lookups, inserts and removals race with each other.
+		const StringName temporary = "test_string_name_threaded_" + itos(i);
+		data->names[i] = StringName("test_string_name_threaded_" + itos(i));
+		if (temporary != data->names[i]) {
+			data->mismatches++;
+		}
+	}
+}
+
+TEST_CASE("[StringName] Intern from multiple threads") {
+	constexpr int THREAD_COUNT = 8;
+	ThreadedInternData data[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].start(threaded_intern, &data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	for (int j = 0; j < THREAD_COUNT; j++) {
+		CHECK_EQ(data[j].mismatches, 0);
+	}
+	for (int i = 0; i < ThreadedInternData::NAME_COUNT; i++) {
+		const StringName name = "test_string_name_threaded_" + itos(i);
+		for (int j = 0; j < THREAD_COUNT; j++) {
+			CHECK_MESSAGE(data[j].names[i].data_unique_pointer() == name.data_unique_pointer(), "All threads should have interned the same entry.");
+		}
+	}
+}
+
+} // namespace TestStringName
@@ -115,6 +115,58 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
 
+TEST_CASE("[RID_Owner] Batch lookup") {
+	RID_Owner<int> owner;
+	LocalVector<RID> rids;
+	for (int i = 0; i < 100; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	for (uint32_t i = 0; i < rids.size(); i += 3) {
+		owner.free(rids[i]);
+	}
+	rids.push_back(RID());
+
+	LocalVector<int *> ptrs;
+	ptrs.resize(rids.size());
+	CHECK_EQ(owner.get_or_null_batch(rids.ptr(), rids.size(), ptrs.ptr()), 66u);
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		CHECK_EQ(ptrs[i], owner.get_or_null(rids[i]));
+		if (ptrs[i]) {
+			CHECK_EQ(*ptrs[i], int(i));
+		}
+	}
+
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		if (ptrs[i]) {
+			owner.free(rids[i]);
+		}
+	}
+}
+
+TEST_CASE("[RID_PtrOwner] Batch lookup") {
+	int values[4] = { 10, 20, 30, 40 };
+	RID_PtrOwner<int, true> owner;
+	RID rids[5];
+	for (int i = 0; i < 4; i++) {
+		rids[i] = owner.make_rid(&values[i]);
+	}
+	owner.free(rids[2]);
+
+	int *ptrs[5];
+	CHECK_EQ(owner.get_or_null_batch(rids, 5, ptrs), 3u);
+	CHECK_EQ(ptrs[0], &values[0]);
+	CHECK_EQ(ptrs[1], &values[1]);
+	CHECK_EQ(ptrs[2], nullptr);
+	CHECK_EQ(ptrs[3], &values[3]);
+	CHECK_EQ(ptrs[4], nullptr);
+	CHECK_FALSE(owner.owns(rids[2]));
+	CHECK(owner.owns(rids[3]));
+
+	owner.free(rids[0]);
+	owner.free(rids[1]);
+	owner.free(rids[3]);
+}
+
 #ifdef THREADS_ENABLED
 // This case would let sanitizers realize data races.
 // Additionally, on purely weakly ordered architectures, it would detect synchronization issues
@@ -251,6 +303,69 @@ TEST_CASE("[RID_Owner] Thread safety") {
 		tester.test();
 	}
 }
+
+// Lookups don't lock, so they must keep working while another thread grows the allocator.
+TEST_CASE("[RID_Owner] Lookups while allocating from another thread") {
+	struct Tester {
+		enum {
+			STABLE_COUNT = 64,
+			READER_COUNT = 3,
+		};
+
+		RID_Owner<uint64_t, true> owner = RID_Owner<uint64_t, true>(sizeof(uint64_t) * 16);
+		RID stable[STABLE_COUNT];
+		std::atomic<bool> done = false;
+		std::atomic<uint32_t> mismatches = 0;
+	} tester;
+
+	for (int i = 0; i < Tester::STABLE_COUNT; i++) {
+		tester.stable[i] = tester.owner.make_rid(i);
+	}
+
+	Thread readers[Tester::READER_COUNT];
+	for (Thread &reader : readers) {
+		reader.start(
+				[](void *p_data) {
+					Tester *t = (Tester *)p_data;
+					uint64_t *ptrs[Tester::STABLE_COUNT];
+					while (!t->done.load(std::memory_order_acquire)) {
+						if (t->owner.get_or_null_batch(t->stable, Tester::STABLE_COUNT, ptrs) != Tester::STABLE_COUNT) {
+							t->mismatches.fetch_add(1, std::memory_order_relaxed);
+						}
+						for (int i = 0; i < Tester::STABLE_COUNT; i++) {
+							uint64_t *ptr = t->owner.get_or_null(t->stable[i]);
+							if (!ptr || ptr != ptrs[i] || *ptr != uint64_t(i) || !t->owner.owns(t->stable[i])) {
+								t->mismatches.fetch_add(1, std::memory_order_relaxed);
+							}
+						}
+					}
+				},
+				&tester);
+	}
+
+	LocalVector<RID> churn;
+	for (int round = 0; round < 20; round++) {
+		for (int i = 0; i < 200; i++) {
+			churn.push_back(tester.owner.make_rid(round * 1000 + i));
+		}
+		for (uint32_t i = 0; i < churn.size(); i += 2) {
+			tester.owner.free(churn[i]);
+			churn.remove_at_unordered(i);
+		}
+	}
+	tester.done.store(true, std::memory_order_release);
+	for (Thread &reader : readers) {
+		reader.wait_to_finish();
+	}
+
+	CHECK_EQ(tester.mismatches.load(), 0u);
+	for (const RID &rid : churn) {
+		tester.owner.free(rid);
+	}
+	for (const RID &rid : tester.stable) {
+		tester.owner.free(rid);
+	}
+}
 #endif // THREADS_ENABLED
 
 } // namespace TestRID
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_safe_ring_queue.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/safe_ring_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSafeRingQueue {
+
+TEST_CASE("[SafeRingQueue] Push and pop in order") {
+	SafeRingQueue<int, 8> queue;
+	int value = 0;
+	CHECK(queue.is_empty());
+	CHECK_FALSE(queue.pop(value));
+
+	for (int i = 0; i < 8; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_FALSE_MESSAGE(queue.push(8), "Pushing to a full queue should fail.");
+
+	for (int i = 0; i < 8; i++) {
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i);
+	}
+	CHECK(queue.is_empty());
+	CHECK_FALSE(queue.pop(value));
+}
+
+TEST_CASE("[SafeRingQueue] Wrap around") {
+	SafeRingQueue<int, 4> queue;
+	int value = 0;
+	for (int i = 0; i < 100; i++) {
+		CHECK(queue.push(i));
+		CHECK(queue.push(i + 1000));
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i);
+		CHECK(queue.pop(value));
+		CHECK_EQ(value, i + 1000);
+	}
+	CHECK(queue.is_empty());
+}
+
+static SafeRingQueue<uint32_t, 64> *mt_queue = nullptr;
+static SafeNumeric<uint64_t> mt_popped_sum;
+static SafeNumeric<uint32_t> mt_popped_count;
+static const uint32_t MT_ITEMS_PER_PRODUCER = 10000;
+static const uint32_t MT_PRODUCERS = 2;
+
+static void producer_func(void *p_userdata) {
+	uint32_t base = (uint32_t)(uintptr_t)p_userdata * MT_ITEMS_PER_PRODUCER;
+	for (uint32_t i = 0; i < MT_ITEMS_PER_PRODUCER; i++) {
+		while (!mt_queue->push(base + i)) {
+			Thread::yield();
+		}
+	}
+}
+
+static void consumer_func(void *p_userdata) {
+	while (mt_popped_count.get() < MT_ITEMS_PER_PRODUCER * MT_PRODUCERS) {
+		uint32_t value = 0;
+		if (mt_queue->pop(value)) {
+			mt_popped_sum.add(value);
+			mt_popped_count.increment();
+		} else {
+			Thread::yield();
+		}
+	}
+}
+
+TEST_CASE("[SafeRingQueue] Multiple producers and consumers") {
+	mt_queue = memnew((SafeRingQueue<uint32_t, 64>));
+	mt_popped_sum.set(0);
+	mt_popped_count.set(0);
+
+	Thread threads[MT_PRODUCERS * 2];
+	for (uint32_t i = 0; i < MT_PRODUCERS; i++) {
+		threads[i].start(producer_func, (void *)(uintptr_t)i);
+		threads[MT_PRODUCERS + i].start(consumer_func, nullptr);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	const uint64_t total = MT_ITEMS_PER_PRODUCER * MT_PRODUCERS;
+	CHECK_EQ(mt_popped_count.get(), total);
+	CHECK_MESSAGE(mt_popped_sum.get() == total * (total - 1) / 2, "Every pushed value should be popped exactly once.");
+	CHECK(mt_queue->is_empty());
+
+	memdelete(mt_queue);
+	mt_queue = nullptr;
+}
+
+} // namespace TestSafeRingQueue
@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert, overwrite and erase") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(map[42] == 1234);
+
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK_FALSE(map.has(42));
+	CHECK(map.getptr(42) == nullptr);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 12345;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.size() == elem_max);
+
+	// Insert order should have been kept.
+	int idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		idx++;
+	}
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			CHECK(map.erase(i));
+		}
+	}
+	CHECK(map.size() == elem_max - (elem_max + 4) / 5);
+
+	for (int i = 0; i < elem_max; i++) {
+		const int *value = map.getptr(i);
+		if ((i % 5) == 0) {
+			CHECK(value == nullptr);
+		} else {
+			REQUIRE(value != nullptr);
+			CHECK(*value == i);
+		}
+	}
+}
+
+TEST_CASE("[SwissHashMap] Random inserts and erases match HashMap") {
+	// Churn through far more keys than the map ever holds, so DELETED slots pile up and get reclaimed.
+	SwissHashMap<uint32_t, uint32_t> map;
+	HashMap<uint32_t, uint32_t> reference;
+	uint32_t state = 12345;
+	for (int i = 0; i < 200000; i++) {
+		state = state * 1664525u + 1013904223u;
+		const uint32_t key = (state >> 8) % 3000;
+		if (state & 1) {
+			map.insert(key, i);
+			reference.insert(key, i);
+		} else {
+			CHECK(map.erase(key) == reference.erase(key));
+		}
+	}
+
+	CHECK(map.size() == reference.size());
+	CHECK(map.get_capacity() <= 8192);
+	for (const KeyValue<uint32_t, uint32_t> &E : reference) {
+		const uint32_t *value = map.getptr(E.key);
+		REQUIRE(value != nullptr);
+		CHECK(*value == E.value);
+	}
+	for (const KeyValue<uint32_t, uint32_t> &E : map) {
+		CHECK(reference.has(E.key));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Heterogeneous lookup") {
+	SwissHashMap<StringName, int> map;
+	map.insert(StringName("position"), 1);
+	map.insert(StringName("rotation"), 2);
+
+	CHECK(map.has(String("position")));
+	CHECK_FALSE(map.has(String("scale")));
+	REQUIRE(map.getptr(String("rotation")) != nullptr);
+	CHECK(*map.getptr(String("rotation")) == 2);
+
+	SwissHashMap<String, int> string_map;
+	string_map.insert("position", 1);
+	CHECK(string_map.has(StringName("position")));
+	CHECK(string_map.getptr(StringName("rotation")) == nullptr);
+}
+
+TEST_CASE("[SwissHashMap] Batch insert") {
+	SwissHashMap<int, int> map;
+	map.insert(5, -1);
+
+	LocalVector<KeyValue<int, int>> pairs;
+	for (int i = 0; i < 100; i++) {
+		pairs.push_back(KeyValue<int, int>(100 - i, i));
+	}
+	pairs.push_back(KeyValue<int, int>(100, 1000));
+	map.insert_batch(pairs);
+
+	CHECK(map.size() == 101);
+	// Existing keys stay in place, new keys are appended in batch order.
+	CHECK(map.get_by_index(0).key == 5);
+	CHECK(map.get_by_index(0).value == 95);
+	CHECK(map.get_by_index(1).key == 100);
+	CHECK(map.get_by_index(100).key == 1);
+	// The last value for a repeated key wins.
+	CHECK(map[100] == 1000);
+}
+
+TEST_CASE("[SwissHashMap] Clear, copy and reserve") {
+	SwissHashMap<int, int> map0;
+	map0.reserve(1000);
+	const uint32_t capacity = map0.get_capacity();
+	CHECK(capacity >= 1000);
+	for (int i = 0; i < 1000; i++) {
+		map0.insert(i, i * 2);
+	}
+	CHECK(map0.get_capacity() == capacity);
+
+	SwissHashMap<int, int> map1(map0);
+	SwissHashMap<int, int> map2;
+	map2.insert(1234, 1234);
+	map2 = map0;
+	CHECK(map1.size() == map0.size());
+	CHECK(map2.size() == map0.size());
+	CHECK(map1[999] == 1998);
+	CHECK(map2[999] == 1998);
+	CHECK_FALSE(map2.has(1234));
+
+	map0.clear();
+	CHECK(map0.is_empty());
+	CHECK_FALSE(map0.has(10));
+	CHECK(map1.has(10));
+}
+
+TEST_CASE("[SwissHashMap] Array methods") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(100 - i, i);
+	}
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.get_by_index(i).value == i);
+	}
+	int index = map.get_index(1);
+	CHECK(map.get_by_index(index).value == 99);
+	CHECK(map.erase_by_index(0));
+	CHECK(map.get_index(100) == -1);
+	// The last element took the place of the erased one.
+	CHECK(map.get_index(1) == 0);
+	CHECK(map.get_by_index(0).value == 99);
+	CHECK_FALSE(map.erase_by_index(99));
+}
+
+} // namespace TestSwissHashMap
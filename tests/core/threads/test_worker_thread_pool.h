@@ -172,4 +172,54 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_stealing_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static void static_stealing_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+TEST_CASE("[WorkerThreadPool] Process tasks and group tasks with work stealing") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(4, 0.3, true);
+	CHECK(pool->is_using_work_stealing());
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 9.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+
+		// More tasks than fit in a single local queue, so the shared queue fallback is exercised too.
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(count);
+		for (int i = 0; i < count; i++) {
+			tasks[i] = pool->add_native_task(static_stealing_test, (void *)(uintptr_t)i, !low_priority, String(), i % 2 ? -1 : i);
+		}
+		for (int i = 0; i < count; i++) {
+			pool->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_stealing_group_test, nullptr, count, -1, !low_priority, String(), iterations);
+		pool->wait_for_group_task_completion(group);
+
+		all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+
+	pool->finish();
+	memdelete(pool);
+}
+
 } // namespace TestWorkerThreadPool
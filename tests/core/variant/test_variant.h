@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -2245,4 +2247,79 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+struct PooledVariantsData {
+	static constexpr int COUNT = 1000;
+	LocalVector<Variant> to_free;
+	int mismatches = 0;
+};
+
+static void threaded_pooled_variants(void *p_userdata) {
+	PooledVariantsData *data = static_cast<PooledVariantsData *>(p_userdata);
+	LocalVector<Variant> values;
+	for (int i = 0; i < PooledVariantsData::COUNT; i++) {
+		values.push_back(Transform3D(Basis(), Vector3(i, 0, 0)));
+		values.push_back(AABB(Vector3(), Vector3(i, i, i)));
+		values.push_back(Projection(Vector4(i, 0, 0, 0), Vector4(), Vector4(), Vector4()));
+	}
+	for (int i = 0; i < PooledVariantsData::COUNT; i++) {
+		if (Transform3D(values[i * 3]).origin.x != i || AABB(values[i * 3 + 1]).size.y != i || Projection(values[i * 3 + 2]).columns[0].x != i) {
+			data->mismatches++;
+		}
+	}
+	// Values allocated by another thread end up in this thread's cache.
+	data->to_free.clear();
+}
+
+TEST_CASE("[Variant] Pooled types from multiple threads") {
+	constexpr int THREAD_COUNT = 4;
+	const Variant::PoolStats before = Variant::get_pool_stats();
+
+	PooledVariantsData data[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		for (int j = 0; j < PooledVariantsData::COUNT; j++) {
+			data[i].to_free.push_back(Basis::from_scale(Vector3(j, j, j)));
+		}
+		threads[i].start(threaded_pooled_variants, &data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		CHECK_EQ(data[i].mismatches, 0);
+		CHECK(data[i].to_free.is_empty());
+	}
+
+	const Variant::PoolStats after = Variant::get_pool_stats();
+	const uint64_t expected = THREAD_COUNT * PooledVariantsData::COUNT * 4;
+	CHECK(after.allocs - before.allocs >= expected);
+	CHECK(after.frees - before.frees >= expected);
+	CHECK(after.reserved_bytes >= before.reserved_bytes);
+}
+
+TEST_CASE("[Variant] Reconfigure pools while in use") {
+	LocalVector<Variant> values;
+	for (int i = 0; i < 100; i++) {
+		values.push_back(Transform2D(0, Vector2(i, i)));
+	}
+
+	// Smaller pages and no thread cache, then back to the defaults.
+	Variant::configure_pools(64, 64, 64, 0);
+	for (int i = 100; i < 10000; i++) {
+		values.push_back(Transform2D(0, Vector2(i, i)));
+	}
+	for (uint32_t i = 0; i < values.size(); i += 2) {
+		values[i] = Variant();
+	}
+	Variant::configure_pools(4096, 4096, 4096, 64);
+	for (uint32_t i = 0; i < values.size(); i += 2) {
+		values[i] = Transform2D(0, Vector2(i, i));
+	}
+
+	for (uint32_t i = 0; i < values.size(); i++) {
+		CHECK_EQ(Transform2D(values[i]).get_origin(), Vector2(i, i));
+	}
+}
+
 } // namespace TestVariant